@@ -37,6 +37,7 @@ namespace rndm {
         inModuleConstructor,   ///< in module construction phase
         inBeginRun,            ///< in begin of run phase
         inModuleBeginRun,      ///< in begin of run for a module
+        inModuleBeginSubRun,   ///< in begin of subrun for a module
         inEvent,               ///< in event phase
         inModuleEvent,         ///< in event processing by a module
         inEndJob,              ///< in end job
@@ -45,6 +46,9 @@ namespace rndm {
       
       using EventInfo_t = art::EventAuxiliary;
       
+      /// Type of the number of the schedule
+      using ScheduleNumber_t = EventSeedInputData::ScheduleNumber_t;
+      
       
       ArtState(state_type start_state = unDefined)
         : artState(start_state)
@@ -53,6 +57,11 @@ namespace rndm {
         , procName()
         {}
       
+      /// Constructor: state of the specified schedule
+      ArtState(ScheduleNumber_t schedule, state_type start_state = unDefined)
+        : ArtState(start_state)
+        { set_schedule(schedule); }
+      
       // Accept compiler written d'tor, copy c'tor and copy assignment.
       
       //@{
@@ -90,6 +99,9 @@ namespace rndm {
         }
       void reset_module() { lastModule = art::ModuleDescription(); }
       
+      /// Records the schedule (or, on construction, the module replica)
+      void set_schedule(ScheduleNumber_t schedule) { scheduleNo = schedule; }
+      
       void set_process_name(std::string pn) { procName = pn; }
       void set_process_name(art::ModuleDescription const& currentModuleDesc)
         {
@@ -122,6 +134,8 @@ namespace rndm {
       std::string moduleLabel() const { return lastModule.moduleLabel(); }
       
       std::string processName() const { return procName; }
+      
+      ScheduleNumber_t schedule() const { return scheduleNo; }
       //@}
       
       
@@ -142,6 +156,8 @@ namespace rndm {
           data.moduleType = moduleDesc().moduleName();
           data.moduleLabel = moduleLabel();
           
+          data.schedule = schedule();
+          
           return data;
         } // getEventSeedInputData()
       /// @}
@@ -154,6 +170,7 @@ namespace rndm {
             case inModuleConstructor:  return "module construction";
             case inBeginRun:           return "begin of run";
             case inModuleBeginRun:     return "begin of run for module";
+            case inModuleBeginSubRun:  return "begin of subrun for module";
             case inEvent:              return "event preparation";
             case inModuleEvent:        return "event processing by a module";
             case inEndJob:             return "end job";
@@ -170,6 +187,7 @@ namespace rndm {
       EventInfo_t lastEvent;
       art::ModuleDescription lastModule;
       std::string procName;
+      ScheduleNumber_t scheduleNo = 0; ///< number of the schedule
     }; // end ArtState
 
   } // end namespace NuRandomServiceHelper
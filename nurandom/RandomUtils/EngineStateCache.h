@@ -0,0 +1,150 @@
+/**
+ * @file EngineStateCache.h
+ * @brief Bounded cache of random engine states after seeding
+ * @date October 16th, 2026
+ * @see NuRandomService.h
+ */
+
+#ifndef NURANDOM_RANDOMUTILS_ENGINESTATECACHE_H
+#define NURANDOM_RANDOMUTILS_ENGINESTATECACHE_H 1
+
+// C/C++ standard libraries
+#include <cstddef> // std::size_t
+#include <functional> // std::hash<>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility> // std::pair<>
+#include <vector>
+
+
+namespace rndm {
+
+  namespace NuRandomServiceHelper {
+
+    /**
+     * @brief Least-recently-used cache of engine states, by engine type and seed
+     * @tparam SEED type of the seed
+     *
+     * The cache holds up to `capacity()` engine states, each identified by the
+     * name of the engine type and by the seed it was initialized with.
+     * The states are the ones saved by `CLHEP::HepRandomEngine::put()`, and
+     * they are meant to be restored via `CLHEP::HepRandomEngine::get()`.
+     * When the cache is full, the state used least recently is dropped.
+     *
+     * The cache relies on the state of an engine right after seeding depending
+     * only on its type and on the seed. Also note that engines which do not
+     * include the seed in their saved state will keep reporting their previous
+     * seed (`getSeed()`) after a state is restored.
+     *
+     * The number of successful and failed lookups is recorded.
+     */
+    template <typename SEED>
+    class EngineStateCache {
+        public:
+      using seed_t = SEED; ///< type of seed
+      using State_t = std::vector<unsigned long>; ///< type of engine state
+
+      /// Constructor: specifies the maximum number of states in the cache
+      EngineStateCache(std::size_t capacity): maxStates(capacity) {}
+
+      /**
+       * @brief Returns the state for the specified engine and seed, if cached
+       * @param engineName name of the type of engine
+       * @param seed the seed the engine was initialized with
+       * @return pointer to the state, or `nullptr` if not cached
+       *
+       * The returned pointer is valid until the next call to `insert()`.
+       */
+      State_t const* find(std::string const& engineName, seed_t seed);
+
+      /// Adds a state to the cache (replacing one with the same key, if any)
+      void insert(std::string const& engineName, seed_t seed, State_t state);
+
+      /// Returns the maximum number of states the cache can hold
+      std::size_t capacity() const { return maxStates; }
+
+      /// Returns the number of states currently in the cache
+      std::size_t size() const { return states.size(); }
+
+      /// Returns the number of successful lookups so far
+      unsigned long long hits() const { return nHits; }
+
+      /// Returns the number of failed lookups so far
+      unsigned long long misses() const { return nMisses; }
+
+        private:
+      using Key_t = std::pair<std::string, seed_t>;
+
+      /// Hash of the cache key
+      struct KeyHash {
+        std::size_t operator() (Key_t const& key) const
+          {
+            std::size_t const h = std::hash<std::string>()(key.first);
+            return h
+              ^ (std::hash<seed_t>()(key.second) + 0x9e3779b9 + (h << 6) + (h >> 2));
+          }
+      }; // KeyHash
+
+      using Entry_t = std::pair<Key_t, State_t>;
+      using List_t = std::list<Entry_t>;
+
+      std::size_t maxStates; ///< maximum number of states in cache
+
+      /// Cached states, from the most to the least recently used.
+      List_t states;
+
+      /// Index of the cached states.
+      std::unordered_map<Key_t, typename List_t::iterator, KeyHash> index;
+
+      unsigned long long nHits = 0;   ///< number of successful lookups
+      unsigned long long nMisses = 0; ///< number of failed lookups
+
+    }; // class EngineStateCache<>
+
+  } // namespace NuRandomServiceHelper
+
+} // namespace rndm
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//---
+template <typename SEED>
+auto rndm::NuRandomServiceHelper::EngineStateCache<SEED>::find
+  (std::string const& engineName, seed_t seed) -> State_t const*
+{
+  auto const iEntry = index.find(Key_t{ engineName, seed });
+  if (iEntry == index.end()) {
+    ++nMisses;
+    return nullptr;
+  }
+  ++nHits;
+  // move the entry on top of the list
+  states.splice(states.begin(), states, iEntry->second);
+  return &(iEntry->second->second);
+} // EngineStateCache<>::find()
+
+
+template <typename SEED>
+void rndm::NuRandomServiceHelper::EngineStateCache<SEED>::insert
+  (std::string const& engineName, seed_t seed, State_t state)
+{
+  if (maxStates == 0) return;
+  Key_t key{ engineName, seed };
+  auto const iEntry = index.find(key);
+  if (iEntry != index.end()) {
+    iEntry->second->second = std::move(state);
+    states.splice(states.begin(), states, iEntry->second);
+    return;
+  }
+  if (states.size() >= maxStates) {
+    index.erase(states.back().first);
+    states.pop_back();
+  }
+  states.emplace_front(key, std::move(state));
+  index.emplace(std::move(key), states.begin());
+} // EngineStateCache<>::insert()
+
+
+#endif // NURANDOM_RANDOMUTILS_ENGINESTATECACHE_H
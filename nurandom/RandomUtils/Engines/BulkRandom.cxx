@@ -0,0 +1,105 @@
+/**
+ * @file   nurandom/RandomUtils/Engines/BulkRandom.cxx
+ * @brief  Generation of many random numbers at once into caller buffers
+ * @date   October 16th, 2026
+ * @see    nurandom/RandomUtils/Engines/BulkRandom.h
+ */
+
+// library header
+#include "nurandom/RandomUtils/Engines/BulkRandom.h"
+
+// nurandom libraries
+#include "nurandom/RandomUtils/Engines/PhiloxEngine.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min()
+#include <array>
+
+
+//------------------------------------------------------------------------------
+rndm::BulkRandom::BulkRandom(CLHEP::HepRandomEngine& engine)
+  : fEngine(&engine)
+  , fPhilox(dynamic_cast<PhiloxEngine*>(&engine))
+  {}
+
+
+//------------------------------------------------------------------------------
+void rndm::BulkRandom::fillFlat(std::size_t n, double* values) {
+  while (n > 0) {
+    std::size_t const m = std::min(n, ChunkSize);
+    fEngine->flatArray(static_cast<int>(m), values);
+    values += m;
+    n -= m;
+  } // while
+} // rndm::BulkRandom::fillFlat(double)
+
+
+void rndm::BulkRandom::fillFlat(std::size_t n, float* values) {
+  if (fPhilox) {
+    std::array<std::uint32_t, ChunkSize> words;
+    while (n > 0) {
+      std::size_t const m = std::min(n, ChunkSize);
+      fPhilox->fillWords(m, words.data());
+      details::wordsToFloats(m, words.data(), values);
+      values += m;
+      n -= m;
+    } // while
+  }
+  else {
+    std::array<double, ChunkSize> flat;
+    while (n > 0) {
+      std::size_t const m = std::min(n, ChunkSize);
+      fEngine->flatArray(static_cast<int>(m), flat.data());
+      details::flatToFloats(m, flat.data(), values);
+      values += m;
+      n -= m;
+    } // while
+  }
+} // rndm::BulkRandom::fillFlat(float)
+
+
+//------------------------------------------------------------------------------
+void rndm::BulkRandom::fillGauss
+  (std::size_t n, double* values, double mean, double sigma)
+{
+  std::size_t const nEven = n & ~std::size_t(1);
+  gaussPairs(nEven, values, mean, sigma);
+  if (nEven == n) return;
+
+  // the last number needs a whole pair
+  double pair[2];
+  gaussPairs(2, pair, mean, sigma);
+  values[nEven] = pair[0];
+} // rndm::BulkRandom::fillGauss(double)
+
+
+void rndm::BulkRandom::fillGauss
+  (std::size_t n, float* values, float mean, float sigma)
+{
+  static_assert(ChunkSize % 2 == 0, "Chunks must hold whole pairs.");
+  std::array<double, ChunkSize> buffer;
+  while (n > 0) {
+    std::size_t const m = std::min(n, ChunkSize);
+    gaussPairs(m + (m & 1), buffer.data(), mean, sigma);
+    for (std::size_t i = 0; i < m; ++i) values[i] = float(buffer[i]);
+    values += m;
+    n -= m;
+  } // while
+} // rndm::BulkRandom::fillGauss(float)
+
+
+void rndm::BulkRandom::gaussPairs
+  (std::size_t n, double* values, double mean, double sigma)
+{
+  // flat numbers are written in the output buffer, and transformed in place
+  while (n > 0) {
+    std::size_t const m = std::min(n, ChunkSize);
+    fEngine->flatArray(static_cast<int>(m), values);
+    details::boxMuller(m / 2, values, values, mean, sigma);
+    values += m;
+    n -= m;
+  } // while
+} // rndm::BulkRandom::gaussPairs()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,189 @@
+/**
+ * @file   nurandom/RandomUtils/Engines/BulkRandom.h
+ * @brief  Generation of many random numbers at once into caller buffers
+ * @date   October 16th, 2026
+ * @see    nurandom/RandomUtils/Engines/BulkRandom.cxx
+ *
+ * Library: `nurandom::RandomUtils_Engines`
+ */
+
+#ifndef NURANDOM_RANDOMUTILS_ENGINES_BULKRANDOM_H
+#define NURANDOM_RANDOMUTILS_ENGINES_BULKRANDOM_H 1
+
+// CLHEP libraries
+#include "CLHEP/Random/RandomEngine.h"
+
+// C/C++ standard libraries
+#include <cmath> // std::log(), std::sqrt(), std::cos(), std::sin()
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <vector>
+
+
+namespace rndm {
+
+  class PhiloxEngine;
+
+  namespace details {
+
+    // --- BEGIN --- Conversion kernels ----------------------------------------
+    /**
+     * @name Conversion kernels
+     *
+     * These loops act on each element (or pair of elements) independently and
+     * use no reduction. Only the conversions to `float` are SIMD-friendly:
+     * they use only exact integer and floating point operations, so that the
+     * compiler can vectorize them while each result stays the same as the
+     * scalar computation.
+     * The Box-Muller transformation is scalar: it calls `std::log()`,
+     * `std::cos()` and `std::sin()`, which are not vectorized without a vector
+     * math library and relaxed floating point rules, and it runs one pair at a
+     * time.
+     * Outputs may alias their inputs.
+     */
+    /// @{
+
+    /// Converts 32-bit words into `float` numbers strictly between 0 and 1.
+    inline void wordsToFloats
+      (std::size_t n, std::uint32_t const* words, float* values)
+    {
+      for (std::size_t i = 0; i < n; ++i)
+        values[i] = (float(words[i] >> 9) + 0.5f) * 0x1.0p-23f;
+    } // wordsToFloats()
+
+    /// Converts `double` numbers in ]0;1[ into `float` numbers in ]0;1[.
+    inline void flatToFloats(std::size_t n, double const* flat, float* values)
+    {
+      // 23 bits: `k + 0.5` is exact in single precision, and never rounds to 1
+      for (std::size_t i = 0; i < n; ++i) {
+        values[i]
+          = (float(static_cast<std::uint32_t>(flat[i] * 0x1.0p23)) + 0.5f)
+          * 0x1.0p-23f;
+      }
+    } // flatToFloats()
+
+    /**
+     * @brief Box-Muller transformation of `nPairs` pairs of flat numbers.
+     * @param nPairs number of pairs to transform
+     * @param flat pairs of numbers in ]0;1[ (`2 nPairs` of them)
+     * @param values (output) `2 nPairs` normally distributed numbers
+     * @param mean mean of the output distribution
+     * @param sigma standard deviation of the output distribution
+     */
+    inline void boxMuller(
+      std::size_t nPairs, double const* flat, double* values,
+      double mean, double sigma
+    ) {
+      constexpr double twoPi = 6.283185307179586476925;
+      for (std::size_t i = 0; i < nPairs; ++i) {
+        double const u1 = flat[2*i], u2 = flat[2*i + 1];
+        double const r = sigma * std::sqrt(-2.0 * std::log(u1));
+        double const phi = twoPi * u2;
+        values[2*i] = mean + r * std::cos(phi);
+        values[2*i + 1] = mean + r * std::sin(phi);
+      } // for
+    } // boxMuller()
+
+    /// @}
+    // --- END --- Conversion kernels ------------------------------------------
+
+  } // namespace details
+
+
+  /**
+   * @brief Fills caller buffers with random numbers from a CLHEP engine.
+   *
+   * This object fills a buffer with many numbers in a single call, instead of
+   * calling `CLHEP::RandFlat` or `CLHEP::RandGauss` once per number:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * rndm::BulkRandom bulk(engine);
+   * std::vector<float> noise(nTicks);
+   * bulk.fillGauss(noise, 0.0f, noiseRMS);
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * The engine (for example one registered with `NuRandomService`) is only
+   * referenced and must outlive this object.
+   *
+   * The flat numbers are obtained from the engine with `flatArray()` in
+   * chunks, and converted in chunks by the kernels in `rndm::details`.
+   * The conversions into `float` are vectorized by the compiler, while the
+   * Gaussian numbers still cost one scalar `std::log()`, `std::cos()` and
+   * `std::sin()` per pair.
+   * Engines which generate blocks of words (`rndm::PhiloxEngine`) are
+   * detected at construction, and their words are used directly where
+   * possible.
+   *
+   * The numbers are a pure function of the engine state and of the sequence
+   * of requests, and the engine is left in the same state as if the numbers
+   * were generated one by one as described below.
+   * * `fillFlat()` of `double`: one `flat()` per number, in order (same as
+   *   `engine.flatArray()`);
+   * * `fillFlat()` of `float`: one `float(engine)` per number for block
+   *   engines, one `flat()` per number otherwise, with 23 bits of resolution;
+   * * `fillGauss()`: two `flat()` per pair of numbers, transformed with the
+   *   Box-Muller method; for an odd number of requested values the second
+   *   number of the last pair is discarded. Single precision numbers are
+   *   computed in double precision, then converted.
+   *
+   * The results are not the same as the ones from `CLHEP::RandGauss`, which
+   * uses a different transformation and caches the spare number of the pair.
+   */
+  class BulkRandom {
+      public:
+
+    /// Number of numbers converted in one go.
+    static constexpr std::size_t ChunkSize = 512;
+
+    /// Constructor: uses the specified engine.
+    explicit BulkRandom(CLHEP::HepRandomEngine& engine);
+
+    /// Returns the engine used to generate the numbers.
+    CLHEP::HepRandomEngine& engine() const { return *fEngine; }
+
+    /// Returns whether the engine words are used directly.
+    bool hasBlockGeneration() const { return fPhilox != nullptr; }
+
+    // --- BEGIN --- Uniform distribution ---------------------------------------
+    /// Fills `values` with `n` numbers uniformly distributed in ]0;1[.
+    void fillFlat(std::size_t n, double* values);
+
+    /// Fills `values` with `n` numbers uniformly distributed in ]0;1[.
+    void fillFlat(std::size_t n, float* values);
+
+    /// Fills the whole `values` with numbers uniformly distributed in ]0;1[.
+    template <typename T>
+    void fillFlat(std::vector<T>& values)
+      { fillFlat(values.size(), values.data()); }
+    // --- END --- Uniform distribution -----------------------------------------
+
+
+    // --- BEGIN --- Normal distribution ----------------------------------------
+    /// Fills `values` with `n` normally distributed numbers.
+    void fillGauss
+      (std::size_t n, double* values, double mean = 0.0, double sigma = 1.0);
+
+    /// Fills `values` with `n` normally distributed numbers.
+    void fillGauss
+      (std::size_t n, float* values, float mean = 0.0f, float sigma = 1.0f);
+
+    /// Fills the whole `values` with normally distributed numbers.
+    template <typename T>
+    void fillGauss(std::vector<T>& values, T mean = T(0), T sigma = T(1))
+      { fillGauss(values.size(), values.data(), mean, sigma); }
+    // --- END --- Normal distribution ------------------------------------------
+
+      private:
+    CLHEP::HepRandomEngine* fEngine; ///< The engine generating the numbers.
+    PhiloxEngine* fPhilox; ///< The same engine, if a block engine.
+
+    /// Fills `values` with an even number `n` of normally distributed numbers.
+    void gaussPairs(std::size_t n, double* values, double mean, double sigma);
+
+  }; // class BulkRandom
+
+
+} // namespace rndm
+
+
+//------------------------------------------------------------------------------
+
+#endif // NURANDOM_RANDOMUTILS_ENGINES_BULKRANDOM_H
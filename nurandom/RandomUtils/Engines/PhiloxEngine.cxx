@@ -0,0 +1,222 @@
+/**
+ * @file   nurandom/RandomUtils/Engines/PhiloxEngine.cxx
+ * @brief  CLHEP random engine based on the Philox4x32-10 counter-based generator
+ * @date   October 16th, 2026
+ * @see    nurandom/RandomUtils/Engines/PhiloxEngine.h
+ */
+
+// library header
+#include "nurandom/RandomUtils/Engines/PhiloxEngine.h"
+
+// CLHEP libraries
+#include "CLHEP/Random/engineIDulong.h"
+
+// C/C++ standard libraries
+#include <fstream>
+#include <iostream>
+#include <ios> // std::ios::badbit
+
+
+//------------------------------------------------------------------------------
+rndm::PhiloxEngine::PhiloxEngine() { setSeed(0); }
+
+
+rndm::PhiloxEngine::PhiloxEngine(long seed) { setSeed(seed); }
+
+
+rndm::PhiloxEngine::PhiloxEngine(std::istream& is) {
+  setSeed(0);
+  get(is);
+} // rndm::PhiloxEngine::PhiloxEngine(istream)
+
+
+//------------------------------------------------------------------------------
+void rndm::PhiloxEngine::flatArray(const int size, double* vect) {
+  double* const end = vect + ((size > 0)? size: 0);
+
+  // complete the current block, if the position is not at the start of one
+  while ((vect != end) && ((fPosition & 3U) != 0)) *(vect++) = flat();
+  if (vect == end) return;
+
+  // then two numbers per whole block, without caching
+  std::uint64_t index = fPosition >> 2;
+  while (end - vect >= 2) {
+    details::Philox4x32Block_t const words = block(index++);
+    *(vect++) = toDouble(words[0], words[1]);
+    *(vect++) = toDouble(words[2], words[3]);
+  } // while
+  fPosition = index << 2;
+
+  if (vect != end) *vect = flat();
+} // rndm::PhiloxEngine::flatArray()
+
+
+void rndm::PhiloxEngine::fillWords(std::size_t n, std::uint32_t* words) {
+  std::uint32_t* const end = words + n;
+
+  // complete the current block, if the position is not at the start of one
+  while ((words != end) && ((fPosition & 3U) != 0)) *(words++) = nextWord();
+  if (words == end) return;
+
+  // then whole blocks, without caching
+  std::uint64_t index = fPosition >> 2;
+  while (end - words >= 4) {
+    details::Philox4x32Block_t const block = this->block(index++);
+    for (std::uint32_t word: block) *(words++) = word;
+  } // while
+  fPosition = index << 2;
+
+  while (words != end) *(words++) = nextWord();
+} // rndm::PhiloxEngine::fillWords()
+
+
+//------------------------------------------------------------------------------
+void rndm::PhiloxEngine::setSeed(long seed, int /* dummy */) {
+  auto const bits = static_cast<std::uint64_t>(seed);
+  fKey = { std::uint32_t(bits), std::uint32_t(bits >> 32) };
+  fStream = { 0U, 0U };
+  resetState(seed);
+} // rndm::PhiloxEngine::setSeed()
+
+
+void rndm::PhiloxEngine::setSeeds(const long* seeds, int n) {
+  std::array<std::uint32_t, 4> words{ 0U, 0U, 0U, 0U };
+  std::size_t const maxWords
+    = ((n > 0) && (std::size_t(n) < words.size()))? std::size_t(n): words.size();
+  if (seeds) {
+    for (std::size_t i = 0; (i < maxWords) && (seeds[i] != 0); ++i)
+      words[i] = static_cast<std::uint32_t>(seeds[i]);
+  }
+  fKey = { words[0], words[1] };
+  fStream = { words[2], words[3] };
+  resetState(seeds? seeds[0]: 0);
+} // rndm::PhiloxEngine::setSeeds()
+
+
+void rndm::PhiloxEngine::resetState(long seed) {
+  fPosition = 0;
+  fBlockValid = false;
+  theSeed = seed;
+  fSeeds = { long(fKey[0]), long(fKey[1]), long(fStream[0]), long(fStream[1]), 0 };
+  theSeeds = fSeeds.data();
+} // rndm::PhiloxEngine::resetState()
+
+
+//------------------------------------------------------------------------------
+void rndm::PhiloxEngine::saveStatus(const char filename[]) const {
+  std::ofstream outFile(filename, std::ios::out);
+  if (!outFile.bad()) put(outFile);
+} // rndm::PhiloxEngine::saveStatus()
+
+
+void rndm::PhiloxEngine::restoreStatus(const char filename[]) {
+  std::ifstream inFile(filename, std::ios::in);
+  if (!checkFile(inFile, filename, engineName(), "restoreStatus")) {
+    std::cerr << "  -- Engine state remains unchanged\n";
+    return;
+  }
+  get(inFile);
+} // rndm::PhiloxEngine::restoreStatus()
+
+
+void rndm::PhiloxEngine::showStatus() const {
+  std::cout << "\n--------- " << engineName() << " engine status ---------\n"
+    << " Key:      " << fKey[0] << " " << fKey[1] << "\n"
+    << " Stream:   " << fStream[0] << " " << fStream[1] << "\n"
+    << " Position: " << fPosition << " (words)\n"
+    << "----------------------------------------" << std::endl;
+} // rndm::PhiloxEngine::showStatus()
+
+
+std::string rndm::PhiloxEngine::name() const { return engineName(); }
+
+
+//------------------------------------------------------------------------------
+std::vector<unsigned long> rndm::PhiloxEngine::put() const {
+  return {
+    CLHEP::engineIDulong<PhiloxEngine>(),
+    fKey[0], fKey[1], fStream[0], fStream[1],
+    static_cast<unsigned long>(fPosition & 0xFFFFFFFFULL),
+    static_cast<unsigned long>(fPosition >> 32),
+    static_cast<unsigned long>(static_cast<std::uint64_t>(theSeed) & 0xFFFFFFFFULL),
+    static_cast<unsigned long>(static_cast<std::uint64_t>(theSeed) >> 32)
+    };
+} // rndm::PhiloxEngine::put()
+
+
+bool rndm::PhiloxEngine::get(std::vector<unsigned long> const& v) {
+  if (v.empty() || (v[0] != CLHEP::engineIDulong<PhiloxEngine>())) {
+    std::cerr << "\n" << engineName()
+      << " get:state vector has wrong ID word - state unchanged\n";
+    return false;
+  }
+  return getState(v);
+} // rndm::PhiloxEngine::get(vector)
+
+
+bool rndm::PhiloxEngine::getState(std::vector<unsigned long> const& v) {
+  if (v.size() != VECTOR_STATE_SIZE) {
+    std::cerr << "\n" << engineName()
+      << " get:state vector has wrong length - state unchanged\n";
+    return false;
+  }
+  fKey = { std::uint32_t(v[1]), std::uint32_t(v[2]) };
+  fStream = { std::uint32_t(v[3]), std::uint32_t(v[4]) };
+  resetState(static_cast<long>
+    ((std::uint64_t(v[8] & 0xFFFFFFFFUL) << 32) | (v[7] & 0xFFFFFFFFUL)));
+  fPosition = (std::uint64_t(v[6] & 0xFFFFFFFFUL) << 32) | (v[5] & 0xFFFFFFFFUL);
+  return true;
+} // rndm::PhiloxEngine::getState(vector)
+
+
+//------------------------------------------------------------------------------
+std::ostream& rndm::PhiloxEngine::put(std::ostream& os) const {
+  os << beginTag();
+  for (unsigned long word: put()) os << "\n" << word;
+  os << "\n" << engineName() << "-end\n";
+  return os;
+} // rndm::PhiloxEngine::put(ostream)
+
+
+std::istream& rndm::PhiloxEngine::get(std::istream& is) {
+  std::string tag;
+  is >> tag;
+  if (tag != beginTag()) {
+    is.clear(std::ios::badbit | is.rdstate());
+    std::cerr << "No " << beginTag() << " tag found in input stream\n";
+    return is;
+  }
+  return getState(is);
+} // rndm::PhiloxEngine::get(istream)
+
+
+std::istream& rndm::PhiloxEngine::getState(std::istream& is) {
+  std::vector<unsigned long> v(VECTOR_STATE_SIZE);
+  for (unsigned long& word: v) is >> word;
+  std::string endTag;
+  is >> endTag;
+  if (!is || (endTag != engineName() + "-end")) {
+    is.clear(std::ios::badbit | is.rdstate());
+    std::cerr << "\n" << engineName()
+      << " state description incomplete - input stream is probably corrupted\n";
+    return is;
+  }
+  get(v);
+  return is;
+} // rndm::PhiloxEngine::getState(istream)
+
+
+//------------------------------------------------------------------------------
+rndm::PhiloxEngine::operator double() { return flat(); }
+
+
+rndm::PhiloxEngine::operator float() {
+  // 23 bits: with 24, the half-step offset is not representable next to 1
+  return toFloat(nextWord());
+} // rndm::PhiloxEngine::operator float()
+
+
+rndm::PhiloxEngine::operator unsigned int() { return nextWord(); }
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,229 @@
+/**
+ * @file   nurandom/RandomUtils/Engines/PhiloxEngine.h
+ * @brief  CLHEP random engine based on the Philox4x32-10 counter-based generator
+ * @date   October 16th, 2026
+ * @see    nurandom/RandomUtils/Engines/PhiloxEngine.cxx
+ *
+ * Library: `nurandom::RandomUtils_Engines`
+ */
+
+#ifndef NURANDOM_RANDOMUTILS_ENGINES_PHILOXENGINE_H
+#define NURANDOM_RANDOMUTILS_ENGINES_PHILOXENGINE_H 1
+
+// CLHEP libraries
+#include "CLHEP/Random/RandomEngine.h"
+
+// C/C++ standard libraries
+#include <array>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+
+namespace rndm {
+
+  namespace details {
+
+    /// A block of the Philox4x32 generator: counter or output.
+    using Philox4x32Block_t = std::array<std::uint32_t, 4>;
+
+    /// The key of the Philox4x32 generator.
+    using Philox4x32Key_t = std::array<std::uint32_t, 2>;
+
+    /**
+     * @brief Returns the Philox4x32-10 bijection of `counter` with `key`.
+     * @param counter the 128-bit counter, least significant word first
+     * @param key the 64-bit key
+     * @return four 32-bit random words
+     *
+     * This is the Philox4x32 function with 10 rounds, as defined in
+     * J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw,
+     * "Parallel random numbers: as easy as 1, 2, 3", SC'11 (2011),
+     * and as implemented in their Random123 library.
+     */
+    constexpr Philox4x32Block_t philox4x32_10
+      (Philox4x32Block_t counter, Philox4x32Key_t key)
+    {
+      constexpr std::uint32_t M0 = 0xD2511F53U, M1 = 0xCD9E8D57U;
+      constexpr std::uint32_t W0 = 0x9E3779B9U, W1 = 0xBB67AE85U;
+      for (unsigned int round = 0; round < 10; ++round) {
+        if (round > 0) { key[0] += W0; key[1] += W1; }
+        std::uint64_t const p0 = std::uint64_t(M0) * counter[0];
+        std::uint64_t const p1 = std::uint64_t(M1) * counter[2];
+        counter = Philox4x32Block_t{
+          std::uint32_t(p1 >> 32) ^ counter[1] ^ key[0], std::uint32_t(p1),
+          std::uint32_t(p0 >> 32) ^ counter[3] ^ key[1], std::uint32_t(p0)
+          };
+      } // for
+      return counter;
+    } // philox4x32_10()
+
+  } // namespace details
+
+
+  /**
+   * @brief CLHEP random engine based on the Philox4x32-10 generator.
+   *
+   * Philox4x32-10 is a counter-based generator: each block of four 32-bit
+   * words is a fixed function of a 64-bit key and of a 128-bit counter.
+   * Therefore:
+   * * seeding only sets the key (and resets the counter): there is no state
+   *   to warm up, and reseeding an engine on each event costs next to nothing;
+   * * `skip()` moves to any position in the sequence in constant time, which
+   *   makes this engine suitable for `NuRandomService` jump-ahead mode
+   *   (`registerAndSeedJumpingEngine()`);
+   * * engines with different keys, or with different values of the upper
+   *   half of the counter (the "stream"), produce independent sequences.
+   *
+   * Each random number from `flat()` is made with 52 bits from two 32-bit
+   * words, and it is strictly between 0 and 1. `flatArray()` generates
+   * whole blocks at a time, and so does `fillWords()` for the raw 32-bit words.
+   * Conversion to `unsigned int` returns a single word, and conversion to
+   * `float` uses 23 bits from a single word.
+   *
+   * Seeding:
+   * * `setSeed(seed)` sets the key to the 64 bits of `seed`, and the stream
+   *   to `0`;
+   * * `setSeeds(seeds, n)` sets the key from the lower 32 bits of the first
+   *   two words, and the stream from the lower 32 bits of the next two;
+   *   the list ends after `n` words or at the first `0`, whichever comes
+   *   first (`n` is ignored if not positive); missing words count as `0`.
+   *
+   * This engine can't be created by `art::RandomNumberGenerator`: the module
+   * owns the engine and registers it with `NuRandomService` directly:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * rndm::PhiloxEngine fEngine; // data member of the module
+   * // ...
+   * art::ServiceHandle<rndm::NuRandomService>()->registerAndSeedJumpingEngine
+   *   (fEngine, rndm::PhiloxEngine::engineName(), "instanceName");
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  class PhiloxEngine: public CLHEP::HepRandomEngine {
+      public:
+
+    /// Constructor: engine with key `0`.
+    PhiloxEngine();
+
+    /// Constructor: engine seeded with `seed` (see `setSeed()`).
+    explicit PhiloxEngine(long seed);
+
+    /// Constructor: engine reading its state from a stream.
+    explicit PhiloxEngine(std::istream& is);
+
+    // --- BEGIN --- CLHEP::HepRandomEngine interface ---------------------------
+    double flat() override;
+    void flatArray(const int size, double* vect) override;
+    void setSeed(long seed, int dummy = 0) override;
+    void setSeeds(const long* seeds, int n = 0) override;
+    void saveStatus(const char filename[] = "Philox4x32_10.conf") const override;
+    void restoreStatus(const char filename[] = "Philox4x32_10.conf") override;
+    void showStatus() const override;
+    std::string name() const override;
+
+    std::ostream& put(std::ostream& os) const override;
+    std::istream& get(std::istream& is) override;
+    std::istream& getState(std::istream& is) override;
+
+    std::vector<unsigned long> put() const override;
+    bool get(std::vector<unsigned long> const& v) override;
+    bool getState(std::vector<unsigned long> const& v) override;
+
+    operator double() override;
+    operator float() override;
+    operator unsigned int() override;
+    // --- END --- CLHEP::HepRandomEngine interface -----------------------------
+
+    /// Fills `words` with the next `n` 32-bit words, a whole block at a time.
+    void fillWords(std::size_t n, std::uint32_t* words);
+
+    /// Converts a 32-bit word into a `float` number strictly between 0 and 1.
+    static float toFloat(std::uint32_t word)
+      { return (float(word >> 9) + 0.5f) * 0x1.0p-23f; }
+
+    /// Advances the engine by `n` numbers from `flat()`, in constant time.
+    void skip(std::uint64_t n) { fPosition += 2 * n; }
+
+    /// Returns the key of the generator.
+    details::Philox4x32Key_t const& key() const { return fKey; }
+
+    /// Returns the upper half of the counter (the stream).
+    std::array<std::uint32_t, 2> const& stream() const { return fStream; }
+
+    /// Returns the position of the next 32-bit word in the stream.
+    std::uint64_t position() const { return fPosition; }
+
+    /// Name of this engine.
+    static std::string engineName() { return "Philox4x32_10"; }
+
+    /// Tag opening the state of this engine in a stream.
+    static std::string beginTag() { return engineName() + "-begin"; }
+
+    /// Number of words in the state vector (see `put()`).
+    static constexpr std::size_t VECTOR_STATE_SIZE = 9;
+
+      private:
+    details::Philox4x32Key_t fKey{}; ///< Key of the generator.
+    std::array<std::uint32_t, 2> fStream{}; ///< Upper half of the counter.
+    std::uint64_t fPosition = 0; ///< Index of the next 32-bit word.
+
+    details::Philox4x32Block_t fBlock{}; ///< Cached block.
+    std::uint64_t fBlockIndex = 0; ///< Index of the cached block.
+    bool fBlockValid = false; ///< Whether the cached block is up to date.
+
+    /// Seed words as required by `CLHEP::HepRandomEngine::getSeeds()`.
+    std::array<long, 5> fSeeds{};
+
+    /// Returns the block with the specified index.
+    details::Philox4x32Block_t block(std::uint64_t index) const
+      {
+        return details::philox4x32_10({
+          std::uint32_t(index), std::uint32_t(index >> 32),
+          fStream[0], fStream[1]
+          }, fKey);
+      }
+
+    /// Returns the next 32-bit word.
+    std::uint32_t nextWord();
+
+    /// Converts two words into a number strictly between 0 and 1.
+    static double toDouble(std::uint32_t high, std::uint32_t low)
+      {
+        std::uint64_t const bits
+          = (std::uint64_t(high) << 20) | (std::uint64_t(low) >> 12);
+        return (double(bits) + 0.5) * 0x1.0p-52;
+      }
+
+    /// Invalidates the cache and updates the seed information.
+    void resetState(long seed);
+
+  }; // class PhiloxEngine
+
+
+} // namespace rndm
+
+
+//------------------------------------------------------------------------------
+//--- inline implementation
+//---
+inline std::uint32_t rndm::PhiloxEngine::nextWord() {
+  std::uint64_t const index = fPosition >> 2;
+  if (!fBlockValid || (index != fBlockIndex)) {
+    fBlock = block(index);
+    fBlockIndex = index;
+    fBlockValid = true;
+  }
+  return fBlock[fPosition++ & 3U];
+} // rndm::PhiloxEngine::nextWord()
+
+
+inline double rndm::PhiloxEngine::flat() {
+  std::uint32_t const high = nextWord();
+  return toDouble(high, nextWord());
+} // rndm::PhiloxEngine::flat()
+
+
+//------------------------------------------------------------------------------
+
+#endif // NURANDOM_RANDOMUTILS_ENGINES_PHILOXENGINE_H
@@ -0,0 +1,372 @@
+/**
+ * @file EventSeedPrefetcher.h
+ * @brief Computes in background the per-event seeds of the upcoming events
+ * @date October 16th, 2026
+ * @see NuRandomService.h
+ */
+
+#ifndef NURANDOM_RANDOMUTILS_EVENTSEEDPREFETCHER_H
+#define NURANDOM_RANDOMUTILS_EVENTSEEDPREFETCHER_H 1
+
+// C/C++ standard libraries
+#include <atomic>
+#include <condition_variable>
+#include <memory> // std::unique_ptr<>, std::shared_ptr<>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility> // std::move()
+#include <vector>
+
+
+namespace rndm {
+
+  namespace NuRandomServiceHelper {
+
+    /**
+     * @brief Computes per-event seeds of the next events in a background thread
+     * @tparam SeedMaster type of the seed master providing the seeds
+     *
+     * When the events come with predictable IDs and timestamps (for example
+     * from `EmptyEvent` source with `GeneratedEventTimestamp` plugin in
+     * `deterministic` mode), the per-event seeds of the next events can be
+     * computed before those events are processed.
+     *
+     * Each time an event is observed (`observe()`), the prefetcher predicts
+     * the next `nEvents()` events of the same subrun and computes their seeds
+     * in a background thread, via `SeedMaster::computeEventSeeds()`.
+     * The prediction is that event numbers increase by one, and that the
+     * timestamps increase by a constant step, which is learnt from the last
+     * two events observed in the same subrun. No prediction is made until
+     * the step is known (or if the timestamps do not follow that pattern).
+     *
+     * The seeds are kept in a ring of `nEvents()` slots, one per event number.
+     * A slot is handed over between the two threads by atomic operations only,
+     * so that `take()` never waits for the background thread: if the seeds
+     * of the event are not ready (or the prediction was wrong), it just
+     * reports that nothing is available, and the seeds are computed on demand
+     * as usual.
+     *
+     * The seeds are computed assuming that they depend only on the event
+     * (ID, timestamp, data or simulation, process name) and on the engine ID,
+     * which is the case for all the per-event algorithms in this library.
+     */
+    template <typename SeedMaster>
+    class EventSeedPrefetcher {
+        public:
+      using SeedMaster_t = SeedMaster; ///< type of the seed master
+      using EngineId = typename SeedMaster_t::EngineId; ///< type of engine ID
+      using EventData_t = typename SeedMaster_t::EventData_t; ///< event info
+      using EventSeeds_t = typename SeedMaster_t::EventSeeds_t; ///< seeds
+      /// type of list of engines whose seeds are computed
+      using EngineList_t = std::vector<EngineId>;
+
+      /**
+       * @brief Constructor: starts the background thread
+       * @param seeds the seed master computing the seeds
+       * @param nEvents how many events ahead to compute the seeds of
+       */
+      EventSeedPrefetcher(SeedMaster_t const& seeds, unsigned int nEvents);
+
+      // the background thread refers to this object
+      EventSeedPrefetcher(EventSeedPrefetcher const&) = delete;
+      EventSeedPrefetcher& operator= (EventSeedPrefetcher const&) = delete;
+
+      /// Destructor: stops the background thread
+      ~EventSeedPrefetcher();
+
+      /**
+       * @brief Returns the seeds computed in advance for the specified event
+       * @param data information on the event
+       * @return the seeds of the event, or no value if not available
+       *
+       * This method does not block.
+       */
+      std::optional<EventSeeds_t> take(EventData_t const& data);
+
+      /**
+       * @brief Starts computing the seeds of the events following `data`
+       * @param data information on the event being processed
+       * @param engines the engines to compute the seeds of
+       */
+      void observe
+        (EventData_t const& data, std::shared_ptr<EngineList_t const> engines);
+
+      /// Returns how many events ahead the seeds are computed
+      unsigned int nEvents() const { return nSlots; }
+
+      /// Returns the number of events whose seeds were computed in advance
+      unsigned long long hits() const { return nHits; }
+
+      /// Returns the number of events whose seeds were not available
+      unsigned long long misses() const { return nMisses; }
+
+        private:
+
+      /// Identification of an event (and of its seeds)
+      struct EventKey_t {
+        typename EventData_t::RunNumber_t runNumber = 0;
+        typename EventData_t::SubRunNumber_t subRunNumber = 0;
+        typename EventData_t::EventNumber_t eventNumber = 0;
+        typename EventData_t::TimeValue_t time = 0;
+        bool isTimeValid = false;
+        bool isData = false;
+
+        bool operator== (EventKey_t const& other) const
+          {
+            return (eventNumber == other.eventNumber)
+              && (subRunNumber == other.subRunNumber)
+              && (runNumber == other.runNumber)
+              && (time == other.time)
+              && (isTimeValid == other.isTimeValid)
+              && (isData == other.isData);
+          }
+        bool operator!= (EventKey_t const& other) const
+          { return !(*this == other); }
+      }; // EventKey_t
+
+      /// Status of a slot; only the owner of the slot may change its content
+      enum SlotStatus_t: unsigned int {
+        Free,    ///< no content, background thread may fill it
+        Writing, ///< owned by the background thread
+        Ready,   ///< seeds available, `take()` may use them
+        Reading  ///< owned by `take()`
+      }; // SlotStatus_t
+
+      /// Seeds of one event
+      struct Slot_t {
+        std::atomic<unsigned int> status{ Free }; ///< see `SlotStatus_t`
+        EventKey_t key; ///< event the seeds are for
+        EventSeeds_t seeds; ///< the seeds
+      }; // Slot_t
+
+      /// A request of computation for the background thread
+      struct Request_t {
+        EventKey_t last; ///< last event observed
+        typename EventData_t::TimeValue_t timeStep = 0; ///< time between events
+        std::shared_ptr<EngineList_t const> engines; ///< engines to be seeded
+      }; // Request_t
+
+      SeedMaster_t const& seeds; ///< seed master computing the seeds
+
+      unsigned int const nSlots; ///< number of slots in the ring
+      std::unique_ptr<Slot_t[]> ring; ///< ring of event seeds
+
+      std::string processName; ///< name of the process (constant)
+
+      /// Last event observed (only used in the main thread)
+      std::optional<EventKey_t> lastObserved;
+
+      unsigned long long nHits = 0; ///< events with seeds ready
+      unsigned long long nMisses = 0; ///< events without seeds ready
+
+      // --- BEGIN --- Communication with the background thread ----------------
+      std::mutex requestMutex; ///< protects `pendingRequest` and `stop`
+      std::condition_variable requestPosted; ///< wakes the background thread
+      std::optional<Request_t> pendingRequest; ///< next request to serve
+      bool stop = false; ///< whether the background thread should stop
+      /// number of requests posted so far
+      std::atomic<unsigned long long> nRequests{ 0 };
+      // --- END --- Communication with the background thread ------------------
+
+      std::thread worker; ///< the background thread (started last)
+
+      /// Returns the slot assigned to the specified event
+      Slot_t& slotFor(EventKey_t const& key)
+        { return ring[key.eventNumber % nSlots]; }
+
+      /// Loop of the background thread
+      void run();
+
+      /// Computes the seeds for the events following the one in `request`
+      void serve(Request_t const& request, unsigned long long requestNo);
+
+      /// Extracts the key of the event described by `data`
+      static EventKey_t keyOf(EventData_t const& data);
+
+    }; // class EventSeedPrefetcher<>
+
+  } // namespace NuRandomServiceHelper
+
+} // namespace rndm
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//---
+template <typename SeedMaster>
+rndm::NuRandomServiceHelper::EventSeedPrefetcher<SeedMaster>::EventSeedPrefetcher
+  (SeedMaster_t const& seeds, unsigned int nEvents)
+  : seeds(seeds)
+  , nSlots(nEvents)
+  , ring(std::make_unique<Slot_t[]>(nEvents))
+{
+  worker = std::thread([this](){ run(); });
+} // EventSeedPrefetcher<>::EventSeedPrefetcher()
+
+
+template <typename SeedMaster>
+rndm::NuRandomServiceHelper::EventSeedPrefetcher<SeedMaster>::~EventSeedPrefetcher()
+{
+  {
+    std::lock_guard<std::mutex> lock(requestMutex);
+    stop = true;
+  }
+  requestPosted.notify_one();
+  if (worker.joinable()) worker.join();
+} // EventSeedPrefetcher<>::~EventSeedPrefetcher()
+
+
+template <typename SeedMaster>
+auto rndm::NuRandomServiceHelper::EventSeedPrefetcher<SeedMaster>::take
+  (EventData_t const& data) -> std::optional<EventSeeds_t>
+{
+  EventKey_t const key = keyOf(data);
+  Slot_t& slot = slotFor(key);
+
+  unsigned int expected = Ready;
+  if (!slot.status.compare_exchange_strong
+    (expected, Reading, std::memory_order_acquire))
+  {
+    ++nMisses;
+    return std::nullopt;
+  }
+
+  std::optional<EventSeeds_t> eventSeeds;
+  if ((slot.key == key) && (data.processName == processName))
+    eventSeeds = std::move(slot.seeds);
+  slot.status.store(Free, std::memory_order_release);
+
+  if (eventSeeds) ++nHits;
+  else            ++nMisses;
+  return eventSeeds;
+} // EventSeedPrefetcher<>::take()
+
+
+template <typename SeedMaster>
+void rndm::NuRandomServiceHelper::EventSeedPrefetcher<SeedMaster>::observe
+  (EventData_t const& data, std::shared_ptr<EngineList_t const> engines)
+{
+  EventKey_t const key = keyOf(data);
+  std::optional<EventKey_t> const previous = lastObserved;
+  lastObserved = key;
+
+  // predictions are made only within the same subrun
+  if (!previous || (previous->runNumber != key.runNumber)
+    || (previous->subRunNumber != key.subRunNumber)
+    || (previous->eventNumber >= key.eventNumber)
+    || (previous->isTimeValid != key.isTimeValid)
+    )
+  {
+    return;
+  }
+
+  // learn the time step between consecutive events
+  typename EventData_t::TimeValue_t timeStep = 0;
+  if (key.isTimeValid) {
+    auto const dEvents = key.eventNumber - previous->eventNumber;
+    if (previous->time >= key.time) return;
+    auto const dTime = key.time - previous->time;
+    if (dTime % dEvents != 0) return;
+    timeStep = dTime / dEvents;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(requestMutex);
+    if (processName.empty()) processName = data.processName;
+    pendingRequest = Request_t{ key, timeStep, std::move(engines) };
+    ++nRequests;
+  }
+  requestPosted.notify_one();
+} // EventSeedPrefetcher<>::observe()
+
+
+template <typename SeedMaster>
+void rndm::NuRandomServiceHelper::EventSeedPrefetcher<SeedMaster>::run() {
+  while (true) {
+    Request_t request;
+    unsigned long long requestNo;
+    {
+      std::unique_lock<std::mutex> lock(requestMutex);
+      requestPosted.wait(lock, [this](){ return stop || pendingRequest; });
+      if (stop) return;
+      request = std::move(*pendingRequest);
+      pendingRequest.reset();
+      requestNo = nRequests.load(std::memory_order_relaxed);
+    }
+    serve(request, requestNo);
+  } // while
+} // EventSeedPrefetcher<>::run()
+
+
+template <typename SeedMaster>
+void rndm::NuRandomServiceHelper::EventSeedPrefetcher<SeedMaster>::serve
+  (Request_t const& request, unsigned long long requestNo)
+{
+  EventData_t data;
+  data.clear();
+  data.runNumber = request.last.runNumber;
+  data.subRunNumber = request.last.subRunNumber;
+  data.isData = request.last.isData;
+  data.isTimeValid = request.last.isTimeValid;
+  {
+    std::lock_guard<std::mutex> lock(requestMutex);
+    data.processName = processName;
+  }
+
+  for (unsigned int iAhead = 1; iAhead <= nSlots; ++iAhead) {
+    // give up if a newer request has been posted
+    if (nRequests.load(std::memory_order_relaxed) != requestNo) return;
+
+    EventKey_t key = request.last;
+    key.eventNumber += iAhead;
+    if (key.eventNumber < request.last.eventNumber) return; // wrapped around
+    if (key.isTimeValid) key.time += iAhead * request.timeStep;
+
+    // claim the slot, unless it's in use or it already has these seeds
+    Slot_t& slot = slotFor(key);
+    unsigned int status = Free;
+    if (!slot.status.compare_exchange_strong
+      (status, Writing, std::memory_order_acquire))
+    {
+      if ((status != Ready) || (slot.key == key)) continue;
+      if (!slot.status.compare_exchange_strong
+        (status, Writing, std::memory_order_acquire))
+        continue;
+    }
+
+    data.eventNumber = key.eventNumber;
+    data.time = key.time;
+    try {
+      slot.seeds = seeds.computeEventSeeds(data, *request.engines);
+      slot.key = key;
+      slot.status.store(Ready, std::memory_order_release);
+    }
+    catch (...) {
+      // the seeds of this event will be computed (and fail) on demand
+      slot.seeds.clear();
+      slot.status.store(Free, std::memory_order_release);
+    }
+  } // for
+} // EventSeedPrefetcher<>::serve()
+
+
+template <typename SeedMaster>
+auto rndm::NuRandomServiceHelper::EventSeedPrefetcher<SeedMaster>::keyOf
+  (EventData_t const& data) -> EventKey_t
+{
+  EventKey_t key;
+  key.runNumber = data.runNumber;
+  key.subRunNumber = data.subRunNumber;
+  key.eventNumber = data.eventNumber;
+  key.time = data.isTimeValid? data.time: 0;
+  key.isTimeValid = data.isTimeValid;
+  key.isData = data.isData;
+  return key;
+} // EventSeedPrefetcher<>::keyOf()
+
+
+//------------------------------------------------------------------------------
+
+#endif // NURANDOM_RANDOMUTILS_EVENTSEEDPREFETCHER_H
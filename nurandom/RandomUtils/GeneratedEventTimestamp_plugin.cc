@@ -8,64 +8,30 @@
  */
 
 // C/C++ standard libraries
+#include <atomic>
 #include <chrono>
+#include <cstdint> // std::int64_t, std::uint64_t
+#include <memory> // std::unique_ptr<>
 #include <random>
+#include <sstream>
+#include <string>
+#include <thread> // std::this_thread::sleep_for()
+#include <time.h> // clock_gettime(), CLOCK_MONOTONIC_COARSE (POSIX)
+#if defined(__x86_64__) || defined(__i386__)
+#  include <cpuid.h> // __get_cpuid()
+#  include <x86intrin.h> // __rdtsc()
+#  define NURANDOM_GENERATEDEVENTTIMESTAMP_HASTSC 1
+#endif // x86
 
 // framework libraries
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include "canvas/Persistency/Provenance/Timestamp.h"
 #include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Utilities/Exception.h"
 #include "art/Framework/Core/EmptyEventTimestampPlugin.h"
 
-// Event generation namespace
-namespace evgen {
-  
-  /**
-   * @brief Plugin to assign an empty event a time stamp from the clock
-   * @see `art::EmptyEventTimestampPlugin`
-   *
-   * The plug in returns a time stamp that is taken from the current time 
-   * on the execution node, in nanoseconds.
-   * 
-   * The time is currently defined as absolute from the UNIX "epoch" (first day
-   * of year 1970), but its absolute precision should not be relied upon.
-   * 
-   * Also note that the time is not guaranteed to be monotonic, that is,
-   * generating two events in sequence, it is not guaranteed that the second one
-   * has a time stamp larger than the previous. This may for example happen if
-   * the clock relies on a CPU internal counter, on a machine with multiple CPUs
-   * (that is probably all of them).
-   * 
-   * 
-   * Configuration
-   * --------------
-   * 
-   * None so far.
-   * 
-   */
-  class GeneratedEventTimestamp: public art::EmptyEventTimestampPlugin {
-      public:
-    
-    /// Constructor: nothing specific
-    GeneratedEventTimestamp(fhicl::ParameterSet const& pset);
-    
-    
-    /// Returns the time stamp for the specified event
-    virtual art::Timestamp eventTimestamp(art::EventID const& id) override;
-    
-      private:
-    /// Offset to be added to the chosen clock to get an absolute time.
-    art::TimeValue_t const fOffsetFromEpoch = 0;
-    
-  }; // class GeneratedEventTimestamp
-  
-  
-  
-  
-} // namespace evgen
-
 //------------------------------------------------------------------------------
-//--- Implementation
+//--- Clock utilities
 //---
 //---
 
@@ -282,42 +248,455 @@ namespace evgen {
     using ns_clock_t = details::TimeInUnits
       <std::chrono::high_resolution_clock, std::chrono::nanoseconds>;
     
+    
+    //--------------------------------------------------------------------------
+    //--- Clock sources
+    //--------------------------------------------------------------------------
+    /// Interface of a source of absolute time, in nanoseconds from the epoch.
+    class ClockSource {
+        public:
+      using duration_t = art::TimeValue_t;
+      
+      virtual ~ClockSource() = default;
+      
+      /// Returns the current time [ns from the UNIX epoch].
+      virtual duration_t now() = 0;
+      
+      /// Returns a description of the clock and of its calibration.
+      virtual std::string description() const = 0;
+      
+    }; // class ClockSource
+    
+    
+    //--------------------------------------------------------------------------
+    /// Clock source reading a standard `Clock`, with its offset from the epoch.
+    template <typename Clock>
+    class StdClockSource: public ClockSource {
+      using clock_t = TimeInUnits<Clock, std::chrono::nanoseconds>;
+      
+        public:
+      StdClockSource(std::string name)
+        : fName(std::move(name))
+        , fOffsetFromEpoch(clock_t::currentOffsetFromEpoch())
+        {}
+      
+      virtual duration_t now() override { return fOffsetFromEpoch + fClock(); }
+      
+      virtual std::string description() const override
+        {
+          std::ostringstream sstr;
+          sstr << fName << " (period: " << Clock::period::num << "/"
+            << Clock::period::den << " s, offset from epoch: "
+            << fOffsetFromEpoch << " ns)";
+          return sstr.str();
+        }
+      
+        private:
+      std::string const fName; ///< Name of the clock.
+      duration_t const fOffsetFromEpoch; ///< Offset to the absolute time.
+      clock_t fClock; ///< The clock (and padding generator, if any).
+      
+    }; // class StdClockSource<>
+    
+    
+#if defined(CLOCK_MONOTONIC_COARSE)
+    //--------------------------------------------------------------------------
+    /**
+     * @brief Clock source from the coarse monotonic clock of the system.
+     * 
+     * This clock is cheap to read (it does not query the hardware) but it only
+     * advances once per kernel tick (typically 1 to 4 ms). The offset from the
+     * epoch is calibrated on construction, by sampling the system clock just
+     * as the coarse clock ticks.
+     */
+    class MonotonicCoarseClockSource: public ClockSource {
+        public:
+      MonotonicCoarseClockSource();
+      
+      virtual duration_t now() override { return fOffsetFromEpoch + read(); }
+      
+      virtual std::string description() const override
+        {
+          std::ostringstream sstr;
+          sstr << "monotonic coarse (resolution: " << fResolution
+            << " ns, offset from epoch: " << fOffsetFromEpoch << " ns)";
+          return sstr.str();
+        }
+      
+      /// Returns whether the clock is supported by the system.
+      static bool isAvailable()
+        { timespec ts; return clock_getres(CLOCK_MONOTONIC_COARSE, &ts) == 0; }
+      
+        private:
+      duration_t fResolution = 0; ///< Resolution of the clock.
+      duration_t fOffsetFromEpoch = 0; ///< Offset to the absolute time.
+      
+      /// Returns the current time of the coarse clock.
+      static duration_t read()
+        {
+          timespec ts;
+          clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+          return duration_t(ts.tv_sec) * 1000000000ULL + duration_t(ts.tv_nsec);
+        }
+      
+    }; // class MonotonicCoarseClockSource
+    
+    
+    MonotonicCoarseClockSource::MonotonicCoarseClockSource() {
+      timespec res;
+      clock_getres(CLOCK_MONOTONIC_COARSE, &res);
+      fResolution = duration_t(res.tv_sec) * 1000000000ULL + res.tv_nsec;
+      
+      // wait for the clock to tick, and read the system clock right then
+      duration_t const start = read();
+      duration_t ticked;
+      do { ticked = read(); } while (ticked == start);
+      auto const system = std::chrono::system_clock::now().time_since_epoch();
+      fOffsetFromEpoch = static_cast<duration_t>
+        (std::chrono::duration_cast<std::chrono::nanoseconds>(system).count())
+        - ticked;
+    } // MonotonicCoarseClockSource::MonotonicCoarseClockSource()
+#endif // CLOCK_MONOTONIC_COARSE
+    
+    
+#if defined(NURANDOM_GENERATEDEVENTTIMESTAMP_HASTSC)
+    //--------------------------------------------------------------------------
+    /**
+     * @brief Clock source from the CPU time stamp counter.
+     * 
+     * The counter is converted into time with a frequency calibrated once, on
+     * construction, against `std::chrono::steady_clock`, and the origin is
+     * taken from `std::chrono::system_clock` at the same time.
+     * The counter is a good clock only if it is "invariant", that is if it
+     * ticks at constant rate whatever the power state of the CPU and it is
+     * synchronized among cores; `isAvailable()` checks that.
+     */
+    class TSCClockSource: public ClockSource {
+        public:
+      TSCClockSource(std::chrono::milliseconds calibrationTime);
+      
+      virtual duration_t now() override
+        {
+          auto const ticks = static_cast<std::int64_t>(__rdtsc() - fBaseTicks);
+          return fBaseTime
+            + static_cast<std::int64_t>(static_cast<double>(ticks) * fNsPerTick);
+        }
+      
+      virtual std::string description() const override
+        {
+          std::ostringstream sstr;
+          sstr << "invariant TSC (frequency: " << (1.0 / fNsPerTick)
+            << " GHz, calibrated over " << fCalibrationTime.count() << " ms)";
+          return sstr.str();
+        }
+      
+      /// Returns whether the CPU has an invariant time stamp counter.
+      static bool isAvailable()
+        {
+          unsigned int eax, ebx, ecx, edx;
+          // invariant TSC: CPUID leaf 0x80000007, bit 8 of EDX
+          return __get_cpuid(0x80000007U, &eax, &ebx, &ecx, &edx)
+            && (edx & (1U << 8));
+        }
+      
+        private:
+      std::chrono::milliseconds const fCalibrationTime;
+      std::uint64_t fBaseTicks = 0; ///< Counter at the calibration time.
+      duration_t fBaseTime = 0; ///< Absolute time at the calibration time.
+      double fNsPerTick = 1.0; ///< Duration of one tick [ns].
+      
+    }; // class TSCClockSource
+    
+    
+    TSCClockSource::TSCClockSource(std::chrono::milliseconds calibrationTime)
+      : fCalibrationTime(calibrationTime)
+    {
+      using namespace std::chrono;
+      
+      // origin: counter just before and after reading the system clock
+      std::uint64_t const ticksBefore = __rdtsc();
+      auto const system = system_clock::now().time_since_epoch();
+      std::uint64_t const ticksAfter = __rdtsc();
+      fBaseTicks = ticksBefore + (ticksAfter - ticksBefore) / 2;
+      fBaseTime = static_cast<duration_t>
+        (duration_cast<nanoseconds>(system).count());
+      
+      // frequency: counter and steady clock over the calibration time
+      auto const steadyStart = steady_clock::now();
+      std::uint64_t const ticksStart = __rdtsc();
+      std::this_thread::sleep_for(calibrationTime);
+      auto const steadyStop = steady_clock::now();
+      std::uint64_t const ticksStop = __rdtsc();
+      double const elapsed
+        = duration_cast<duration<double, std::nano>>(steadyStop - steadyStart)
+        .count();
+      if ((ticksStop > ticksStart) && (elapsed > 0.0))
+        fNsPerTick = elapsed / static_cast<double>(ticksStop - ticksStart);
+    } // TSCClockSource::TSCClockSource()
+#endif // NURANDOM_GENERATEDEVENTTIMESTAMP_HASTSC
+    
+    
+    //--------------------------------------------------------------------------
+    /// Returns a new clock source as specified by the `clock` parameter.
+    std::unique_ptr<ClockSource> makeClockSource
+      (fhicl::ParameterSet const& pset)
+    {
+      std::string const name = pset.get<std::string>("clock", "highResolution");
+      
+      if (name == "highResolution") {
+        return std::make_unique<StdClockSource<std::chrono::high_resolution_clock>>
+          ("high resolution clock");
+      }
+      if (name == "system") {
+        return std::make_unique<StdClockSource<std::chrono::system_clock>>
+          ("system clock");
+      }
+      if (name == "monotonicCoarse") {
+#if defined(CLOCK_MONOTONIC_COARSE)
+        if (MonotonicCoarseClockSource::isAvailable())
+          return std::make_unique<MonotonicCoarseClockSource>();
+#endif // CLOCK_MONOTONIC_COARSE
+        mf::LogWarning("GeneratedEventTimestamp")
+          << "Coarse monotonic clock not supported on this system:"
+            " using the high resolution clock instead.";
+        return std::make_unique<StdClockSource<std::chrono::high_resolution_clock>>
+          ("high resolution clock");
+      }
+      if (name == "tsc") {
+#if defined(NURANDOM_GENERATEDEVENTTIMESTAMP_HASTSC)
+        if (TSCClockSource::isAvailable()) {
+          return std::make_unique<TSCClockSource>(std::chrono::milliseconds
+            { pset.get<unsigned int>("tscCalibrationTime", 50U) });
+        }
+#endif // NURANDOM_GENERATEDEVENTTIMESTAMP_HASTSC
+        mf::LogWarning("GeneratedEventTimestamp")
+          << "No invariant time stamp counter on this CPU:"
+            " using the high resolution clock instead.";
+        return std::make_unique<StdClockSource<std::chrono::high_resolution_clock>>
+          ("high resolution clock");
+      }
+      throw art::Exception(art::errors::Configuration)
+        << "GeneratedEventTimestamp: unsupported clock '" << name
+        << "' (supported: 'highResolution', 'system', 'monotonicCoarse', 'tsc')\n";
+    } // makeClockSource()
+    
+    
+    /// Returns the average time of a call to `clock.now()` [ns].
+    double measureClockCost(ClockSource& clock, unsigned int nCalls) {
+      using namespace std::chrono;
+      if (nCalls == 0) return 0.0;
+      ClockSource::duration_t sink = 0;
+      auto const start = steady_clock::now();
+      for (unsigned int i = 0; i < nCalls; ++i) sink ^= clock.now();
+      auto const stop = steady_clock::now();
+      MF_LOG_TRACE("GeneratedEventTimestamp") << "(checksum: " << sink << ")";
+      return duration_cast<duration<double, std::nano>>(stop - start).count()
+        / nCalls;
+    } // measureClockCost()
+    
+    
     //--------------------------------------------------------------------------
     
   } // namespace details
 } // namespace evgen
 
 
+// Event generation namespace
+namespace evgen {
+  
+  /**
+   * @brief Plugin to assign an empty event a time stamp from the clock
+   * @see `art::EmptyEventTimestampPlugin`
+   *
+   * In its default mode (`clock`), the plug in returns a time stamp that is
+   * taken from the current time on the execution node, in nanoseconds.
+   * The clock can be chosen among:
+   * * `highResolution` (default): `std::chrono::high_resolution_clock`, with
+   *   its offset from the epoch estimated against the system clock;
+   * * `system`: `std::chrono::system_clock`;
+   * * `monotonicCoarse`: the coarse monotonic clock of the system (POSIX
+   *   `CLOCK_MONOTONIC_COARSE`), which is cheaper to read but advances only
+   *   once per kernel tick; consecutive events within the same tick get time
+   *   stamps 1 ns apart (see below);
+   * * `tsc`: the CPU time stamp counter, with its frequency calibrated against
+   *   `std::chrono::steady_clock` when the plugin is constructed; it requires
+   *   an x86 CPU with invariant counter.
+   * 
+   * Clocks not available on the execution node are replaced by the
+   * `highResolution` one, with a warning. The chosen clock, its calibration
+   * and the measured cost of reading it are reported when the plugin is
+   * constructed.
+   * 
+   * The time is currently defined as absolute from the UNIX "epoch" (first day
+   * of year 1970), but its absolute precision should not be relied upon.
+   * 
+   * The clock is not guaranteed to be monotonic (this may for example happen
+   * if the clock relies on a CPU internal counter, on a machine with multiple
+   * CPUs, that is probably all of them), and with a clock less precise than a
+   * nanosecond two events may read the same time. The plugin nevertheless
+   * guarantees that each time stamp it returns is strictly larger than all the
+   * previous ones: if the clock time is not, the previous time stamp plus one
+   * nanosecond is returned instead. This holds also when time stamps are
+   * requested concurrently.
+   * 
+   * 
+   * In `deterministic` mode, no clock is read: the time stamp is computed
+   * from the event ID only, as
+   *     
+   *     epoch + run x runStride + subRun x subRunStride + event x stride
+   *     
+   * so that the same event always gets the same time stamp, and the
+   * `perEvent` seed policy of `NuRandomService` yields the same seeds in
+   * different runs of the same job. Uniqueness of the time stamps requires
+   * that the event numbers in a subrun do not exceed `subRunStride / stride`
+   * and that the subrun numbers in a run do not exceed
+   * `runStride / subRunStride`; also note that the sum is not protected
+   * against overflow of the 64-bit time value. A configuration without
+   * `0 < stride <= subRunStride <= runStride` gives many events the same
+   * time stamp, and it is rejected.
+   * 
+   * 
+   * Configuration
+   * --------------
+   * 
+   * * `mode` (string, default: `"clock"`): `"clock"` to use the local clock,
+   *   `"deterministic"` to compute the time stamp from the event ID
+   * * `clock` (string, default: `"highResolution"`): the clock to read in
+   *   `clock` mode (see above)
+   * * `tscCalibrationTime` (milliseconds, default: `50`): time spent
+   *   calibrating the frequency of the `tsc` clock
+   * * `clockBenchmarkCalls` (default: `1000`): number of calls used to
+   *   measure the cost of reading the clock at construction (`0` skips it)
+   * * `epoch` (nanoseconds, default: `0`): time stamp of event `0:0:0` in
+   *   `deterministic` mode
+   * * `stride` (nanoseconds, default: `1000000`, 1 ms): time between
+   *   consecutive events in `deterministic` mode
+   * * `subRunStride` (nanoseconds, default: `10000000000000`, about 2.8 hours):
+   *   time between the start of consecutive subruns in `deterministic` mode
+   * * `runStride` (nanoseconds, default: `10000000000000000`, about 116 days):
+   *   time between the start of consecutive runs in `deterministic` mode
+   * 
+   */
+  class GeneratedEventTimestamp: public art::EmptyEventTimestampPlugin {
+      public:
+    
+    /// Constructor: nothing specific
+    GeneratedEventTimestamp(fhicl::ParameterSet const& pset);
+    
+    
+    /// Returns the time stamp for the specified event
+    virtual art::Timestamp eventTimestamp(art::EventID const& id) override;
+    
+      private:
+    /// Whether to compute the time stamp from the event ID only.
+    bool const fDeterministic = false;
+    
+    // --- BEGIN -- Deterministic mode parameters -----------------------------
+    art::TimeValue_t const fEpoch = 0; ///< Time stamp of event 0:0:0.
+    art::TimeValue_t const fStride = 0; ///< Time between events.
+    art::TimeValue_t const fSubRunStride = 0; ///< Time between subruns.
+    art::TimeValue_t const fRunStride = 0; ///< Time between runs.
+    // --- END -- Deterministic mode parameters -------------------------------
+    
+    /// Clock source, kept for the whole job (not used in deterministic mode).
+    std::unique_ptr<details::ClockSource> fClock;
+    
+    /// Last time stamp returned in clock mode.
+    std::atomic<art::TimeValue_t> fLastTime{ 0 };
+    
+    /// Returns a time stamp from the clock, larger than all previous ones.
+    art::TimeValue_t nextClockTime();
+    
+    
+    /// Returns whether the configured mode is the deterministic one.
+    static bool isDeterministicMode(fhicl::ParameterSet const& pset);
+    
+  }; // class GeneratedEventTimestamp
+  
+  
+} // namespace evgen
+
+//------------------------------------------------------------------------------
+//--- Implementation
+//---
+//---
+
+
 //------------------------------------------------------------------------------
 evgen::GeneratedEventTimestamp::GeneratedEventTimestamp
   (fhicl::ParameterSet const& pset)
   : art::EmptyEventTimestampPlugin(pset)
-  , fOffsetFromEpoch(details::ns_clock_t::currentOffsetFromEpoch())
+  , fDeterministic(isDeterministicMode(pset))
+  , fEpoch(pset.get<art::TimeValue_t>("epoch", 0ULL))
+  , fStride(pset.get<art::TimeValue_t>("stride", 1000000ULL))
+  , fSubRunStride(pset.get<art::TimeValue_t>("subRunStride", 10000000000000ULL))
+  , fRunStride(pset.get<art::TimeValue_t>("runStride", 10000000000000000ULL))
 {
   
-  mf::LogInfo("GeneratedEventTimestamp")
-    << "Timestamp plugin: timestamp from local clock time in nanoseconds";
-  if (fOffsetFromEpoch != 0) {
-    MF_LOG_TRACE("GeneratedEventTimestamp")
-      << "  Time offset from epoch: " << fOffsetFromEpoch << " ns";
+  if (fDeterministic) {
+    if ((fStride == 0) || (fSubRunStride < fStride)
+      || (fRunStride < fSubRunStride))
+    {
+      throw art::Exception(art::errors::Configuration)
+        << "GeneratedEventTimestamp: deterministic mode requires"
+        " 0 < stride <= subRunStride <= runStride (got stride " << fStride
+        << ", subRunStride " << fSubRunStride << ", runStride " << fRunStride
+        << ")\n";
+    }
+    mf::LogInfo("GeneratedEventTimestamp")
+      << "Timestamp plugin: deterministic timestamp from event ID"
+      << "\n  epoch: " << fEpoch << " ns"
+      << "\n  stride: " << fStride << " ns/event, " << fSubRunStride
+        << " ns/subrun, " << fRunStride << " ns/run";
+    return;
+  }
+  
+  fClock = details::makeClockSource(pset);
+  unsigned int const nBenchmarkCalls
+    = pset.get<unsigned int>("clockBenchmarkCalls", 1000U);
+  
+  mf::LogInfo log("GeneratedEventTimestamp");
+  log << "Timestamp plugin: timestamp from local clock time in nanoseconds"
+    << "\n  clock: " << fClock->description();
+  if (nBenchmarkCalls > 0) {
+    log << "\n  cost: "
+      << details::measureClockCost(*fClock, nBenchmarkCalls)
+      << " ns per reading (average of " << nBenchmarkCalls << ")";
   }
   
 } // evgen::GeneratedEventTimestamp::GeneratedEventTimestamp()
 
 
+//------------------------------------------------------------------------------
+bool evgen::GeneratedEventTimestamp::isDeterministicMode
+  (fhicl::ParameterSet const& pset)
+{
+  std::string const mode = pset.get<std::string>("mode", "clock");
+  if (mode == "deterministic") return true;
+  if (mode == "clock") return false;
+  throw art::Exception(art::errors::Configuration)
+    << "GeneratedEventTimestamp: unsupported mode '" << mode
+    << "' (supported: 'clock', 'deterministic')\n";
+} // evgen::GeneratedEventTimestamp::isDeterministicMode()
+
+
 //------------------------------------------------------------------------------
 art::Timestamp evgen::GeneratedEventTimestamp::eventTimestamp
   (art::EventID const& id)
 {
-  // obtain from the high resolution clock the current time, from the "epoch",
-  // in nanoseconds; if the clock is less precise than the nanosecond,
-  // the precision gap is filled with randomness
-  details::ns_clock_t get_time;
-  
-  const long long int now_ns = fOffsetFromEpoch + get_time();
+  if (fDeterministic) {
+    art::Timestamp const ts(fEpoch
+      + fRunStride * id.run()
+      + fSubRunStride * id.subRun()
+      + fStride * id.event()
+      );
+    MF_LOG_TRACE("GeneratedEventTimestamp")
+      << "Deterministic time stamp: " << ts.value() << " for event " << id;
+    return ts;
+  } // if deterministic
   
   // convert into a timestamp
-  art::Timestamp ts(now_ns);
+  art::Timestamp ts(nextClockTime());
   
   mf::LogTrace("GeneratedEventTimestamp")
     << "Generated time stamp: " << ts.value() << " for event " << id;
@@ -325,5 +704,33 @@ art::Timestamp evgen::GeneratedEventTimestamp::eventTimestamp
   return ts;
 } // evgen::GeneratedEventTimestamp::eventTimestamp()
 
+//------------------------------------------------------------------------------
+art::TimeValue_t evgen::GeneratedEventTimestamp::nextClockTime() {
+  // obtain from the clock the current time, from the "epoch", in nanoseconds;
+  // if a standard clock is less precise than the nanosecond, the precision gap
+  // is filled with randomness
+  art::TimeValue_t const now_ns = fClock->now();
+  
+  // the time stamp must be larger than the last one: if it is not (clock not
+  // monotonic, or not precise enough), the last one is bumped by 1 ns instead;
+  // on failure, compare_exchange_weak() updates `last` with the current value
+  art::TimeValue_t last = fLastTime.load(std::memory_order_relaxed);
+  art::TimeValue_t next;
+  do {
+    next = (now_ns > last)? now_ns: last + 1;
+  } while (!fLastTime.compare_exchange_weak
+    (last, next, std::memory_order_relaxed, std::memory_order_relaxed)
+  );
+  
+  if (next != now_ns) {
+    MF_LOG_DEBUG("GeneratedEventTimestamp")
+      << "Clock time " << now_ns << " not after the last time stamp: using "
+      << next;
+  }
+  return next;
+} // evgen::GeneratedEventTimestamp::nextClockTime()
+
+
+//------------------------------------------------------------------------------
 // make art aware that we have a plugin
 DEFINE_ART_EMPTYEVENTTIMESTAMP_PLUGIN(evgen::GeneratedEventTimestamp)
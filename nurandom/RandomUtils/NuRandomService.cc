@@ -26,8 +26,22 @@
 #include "CLHEP/Random/RandomEngine.h" // CLHEP::HepRandomEngine
 
 // C++ include files
+#include <algorithm> // std::find()
 #include <iostream>
 #include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <cstdio> // std::rename()
+
+
+namespace {
+
+  /// State of the schedule whose module is running in this thread, if any.
+  thread_local rndm::NuRandomServiceHelper::ArtState const* ThreadArtState
+    = nullptr;
+
+} // local namespace
+
 
 namespace rndm {
 
@@ -38,14 +52,23 @@ namespace rndm {
     , state()
     , verbosity(paramSet.get<int>("verbosity", 0))
     , bPrintEndOfJobSummary(paramSet.get<bool>("endOfJobSummary",false))
+    , endOfJobManifestPath(paramSet.get<std::string>("endOfJobManifest", ""))
+    , engineStateCache(makeEngineStateCache(paramSet))
+    , engineFingerprints(makeEngineFingerprints(paramSet))
+    , checkpointConfig(readCheckpointConfig(paramSet))
+    , eventSeedPrefetcher(makeEventSeedPrefetcher(paramSet))
   {
     state.transit_to(NuRandomServiceHelper::ArtState::inServiceConstructor);
 
+    if (checkpointConfig.restore) restoreCheckpoint();
+
     // Register callbacks.
     iRegistry.sPreModuleConstruction.watch  (this, &NuRandomService::preModuleConstruction  );
     iRegistry.sPostModuleConstruction.watch (this, &NuRandomService::postModuleConstruction );
     iRegistry.sPreModuleBeginRun.watch      (this, &NuRandomService::preModuleBeginRun      );
     iRegistry.sPostModuleBeginRun.watch     (this, &NuRandomService::postModuleBeginRun     );
+    iRegistry.sPreModuleBeginSubRun.watch   (this, &NuRandomService::preModuleBeginSubRun   );
+    iRegistry.sPostModuleBeginSubRun.watch  (this, &NuRandomService::postModuleBeginSubRun  );
     iRegistry.sPreProcessEvent.watch        (this, &NuRandomService::preProcessEvent        );
     iRegistry.sPreModule.watch              (this, &NuRandomService::preModule              );
     iRegistry.sPostModule.watch             (this, &NuRandomService::postModule             );
@@ -57,20 +80,216 @@ namespace rndm {
   } // NuRandomService::NuRandomService()
 
 
+  //----------------------------------------------------------------------------
+  auto NuRandomService::makeEngineStateCache
+    (fhicl::ParameterSet const& paramSet)
+    -> std::unique_ptr<EngineStateCache_t>
+  {
+    auto const size = paramSet.get<fhicl::ParameterSet>("engineStateCache", {})
+      .get<unsigned int>("size", 0U);
+    if (size == 0) return {};
+    mf::LogInfo("NuRandomService")
+      << "Caching up to " << size << " engine states after seeding.";
+    return std::make_unique<EngineStateCache_t>(size);
+  } // NuRandomService::makeEngineStateCache()
+
+
+
+  //----------------------------------------------------------------------------
+  auto NuRandomService::makeEngineFingerprints
+    (fhicl::ParameterSet const& paramSet)
+    -> std::unique_ptr<EngineFingerprints_t>
+  {
+    auto const path = paramSet.get<std::string>("engineFingerprints", "");
+    if (path.empty()) return {};
+    mf::LogInfo("NuRandomService")
+      << "Engine state hashes will be written into '" << path << "'.";
+    return std::make_unique<EngineFingerprints_t>(path);
+  } // NuRandomService::makeEngineFingerprints()
+
+
+  void NuRandomService::recordEngineFingerprints
+    (NuRandomServiceHelper::ArtState const& artState)
+  {
+    if (!engineFingerprints) return;
+    std::string const currentModule = artState.moduleLabel();
+    ScheduleNumber_t const schedule
+      = engineSchedule(currentModule, artState.schedule());
+    SeedMaster_t::EventData_t const data(artState.getEventSeedInputData());
+    for (EngineId const& ID: seeds.engineIDsRange()) {
+      if (ID.moduleLabel != currentModule) continue;
+      if (ID.schedule != schedule) continue;
+      engineFingerprints->record(ID, data);
+    } // for
+  } // NuRandomService::recordEngineFingerprints()
+
+
+  //----------------------------------------------------------------------------
+  auto NuRandomService::makeEventSeedPrefetcher
+    (fhicl::ParameterSet const& paramSet) const
+    -> std::unique_ptr<EventSeedPrefetcher_t>
+  {
+    auto const nEvents
+      = paramSet.get<fhicl::ParameterSet>("eventSeedPrefetch", {})
+      .get<unsigned int>("events", 0U);
+    if (nEvents == 0) return {};
+    mf::LogInfo("NuRandomService")
+      << "Computing per-event seeds up to " << nEvents
+      << " events in advance.";
+    return std::make_unique<EventSeedPrefetcher_t>(seeds, nEvents);
+  } // NuRandomService::makeEventSeedPrefetcher()
+
+
+  //----------------------------------------------------------------------------
+  void NuRandomService::prefetchEventSeeds
+    (NuRandomServiceHelper::ArtState const& artState)
+  {
+    SeedMaster_t::EventData_t const data(artState.getEventSeedInputData());
+
+    if (auto eventSeeds = eventSeedPrefetcher->take(data))
+      seeds.adoptEventSeeds(std::move(*eventSeeds), data);
+
+    // engines are only added, never removed
+    if (!prefetchedEngines || (nPrefetchedEngines != seeds.nEngines())) {
+      prefetchedEngines = std::make_shared<std::vector<EngineId> const>
+        (seeds.eventSeededEngines());
+      nPrefetchedEngines = seeds.nEngines();
+    }
+    eventSeedPrefetcher->observe(data, prefetchedEngines);
+  } // NuRandomService::prefetchEventSeeds()
+
+
+  //----------------------------------------------------------------------------
+  auto NuRandomService::readCheckpointConfig
+    (fhicl::ParameterSet const& paramSet) -> CheckpointConfig_t
+  {
+    CheckpointConfig_t config;
+    fhicl::ParameterSet checkpointPSet;
+    if (!paramSet.get_if_present("checkpoint", checkpointPSet)) return config;
+
+    config.path = checkpointPSet.get<std::string>("file");
+    config.everyNEvents = checkpointPSet.get<unsigned int>("everyNEvents", 0U);
+    config.restore = checkpointPSet.get<bool>("restore", false);
+    if (config.path.empty()) {
+      throw art::Exception(art::errors::Configuration)
+        << "NuRandomService: checkpoint file name must not be empty\n";
+    }
+    return config;
+  } // NuRandomService::readCheckpointConfig()
+
+
+  //----------------------------------------------------------------------------
+  void NuRandomService::restoreCheckpoint() {
+    std::ifstream checkpoint(checkpointConfig.path, std::ios::binary);
+    if (!checkpoint) {
+      mf::LogInfo("NuRandomService")
+        << "No seed checkpoint in '" << checkpointConfig.path
+        << "': starting from scratch.";
+      return;
+    }
+    std::string const label = seeds.restoreCheckpoint(checkpoint);
+    mf::LogInfo("NuRandomService")
+      << "Seed state restored from '" << checkpointConfig.path << "', "
+      << label;
+  } // NuRandomService::restoreCheckpoint()
+
+
+  //----------------------------------------------------------------------------
+  void NuRandomService::writeCheckpoint(std::string const& label) const {
+    // write a new file and replace the old one only when complete,
+    // so that a job dying while writing leaves the previous checkpoint intact
+    std::string const tempPath = checkpointConfig.path + ".tmp";
+    {
+      std::ofstream checkpoint
+        (tempPath, std::ios::binary | std::ios::trunc);
+      if (checkpoint) saveCheckpoint(checkpoint, label);
+      if (!checkpoint.flush()) {
+        throw art::Exception(art::errors::FileWriteError)
+          << "NuRandomService: can't write the seed checkpoint into '"
+          << tempPath << "'\n";
+      }
+    }
+    if (std::rename(tempPath.c_str(), checkpointConfig.path.c_str()) != 0) {
+      throw art::Exception(art::errors::FileWriteError)
+        << "NuRandomService: can't move the seed checkpoint into '"
+        << checkpointConfig.path << "'\n";
+    }
+    MF_LOG_DEBUG("NuRandomService")
+      << "Seed checkpoint written into '" << checkpointConfig.path << "', "
+      << label;
+  } // NuRandomService::writeCheckpoint()
+
 
   //----------------------------------------------------------------------------
   NuRandomService::EngineId NuRandomService::qualify_engine_label
     (std::string moduleLabel, std::string instanceName) const
-    { return { moduleLabel, instanceName }; }
+  {
+    ScheduleNumber_t const schedule
+      = engineSchedule(moduleLabel, currentState().schedule());
+    return { moduleLabel, instanceName, schedule };
+  } // NuRandomService::qualify_engine_label()
 
   NuRandomService::EngineId NuRandomService::qualify_engine_label
     (std::string instanceName /* = "" */) const
-    { return qualify_engine_label( state.moduleLabel(), instanceName); }
+    { return qualify_engine_label( currentState().moduleLabel(), instanceName); }
+
+
+  //----------------------------------------------------------------------------
+  NuRandomServiceHelper::ArtState& NuRandomService::scheduleState
+    (ScheduleNumber_t schedule)
+  {
+    auto iState = scheduleStates.find(schedule);
+    if (iState == scheduleStates.end()) {
+      iState = scheduleStates.emplace
+        (schedule, NuRandomServiceHelper::ArtState{ schedule }).first;
+    }
+    return iState->second;
+  } // NuRandomService::scheduleState()
+
+
+  NuRandomServiceHelper::ArtState const& NuRandomService::currentState() const
+    { return ThreadArtState? *ThreadArtState: state; }
+
+
+  void NuRandomService::setThreadState
+    (NuRandomServiceHelper::ArtState const* artState)
+    { ThreadArtState = artState; }
+
+
+  auto NuRandomService::engineSchedule
+    (std::string const& moduleLabel, ScheduleNumber_t schedule) const
+    -> ScheduleNumber_t
+  {
+    auto const iReplicas = moduleReplicas.find(moduleLabel);
+    bool const replicated
+      = (iReplicas != moduleReplicas.end()) && (iReplicas->second.size() > 1);
+    return replicated? schedule: 0;
+  } // NuRandomService::engineSchedule()
+
+
+  void NuRandomService::checkReplicaSchedule
+    (art::ModuleContext const& mc) const
+  {
+    std::string const& moduleLabel = mc.moduleLabel();
+    ScheduleNumber_t const schedule = mc.scheduleID().id();
+    if (engineSchedule(moduleLabel, schedule) != schedule) return;
+
+    std::vector<ScheduleNumber_t> const& replicas
+      = moduleReplicas.at(moduleLabel);
+    if (std::find(replicas.begin(), replicas.end(), schedule) != replicas.end())
+      return;
+    throw art::Exception(art::errors::LogicError)
+      << "NuRandomService: module '" << moduleLabel << "' runs on schedule "
+      << schedule << ", but none of its " << replicas.size()
+      << " replicas was constructed for it: the seeds of its engines would be"
+      " wrong.\n";
+  } // NuRandomService::checkReplicaSchedule()
 
   //----------------------------------------------------------------------------
   auto NuRandomService::getSeed
     (std::string instanceName /* = "" */) -> seed_t
   {
+    std::lock_guard const lock{ serviceMutex };
     return getSeed(qualify_engine_label(instanceName));
   } // NuRandomService::getSeed(string)
 
@@ -78,7 +297,10 @@ namespace rndm {
   //----------------------------------------------------------------------------
   auto NuRandomService::getSeed
     (std::string const& moduleLabel, std::string const& instanceName) -> seed_t
-    { return getSeed(qualify_engine_label(moduleLabel, instanceName)); }
+  {
+    std::lock_guard const lock{ serviceMutex };
+    return getSeed(qualify_engine_label(moduleLabel, instanceName));
+  } // NuRandomService::getSeed(string, string)
 
 
   //----------------------------------------------------------------------------
@@ -92,6 +314,7 @@ namespace rndm {
 
   //----------------------------------------------------------------------------
   NuRandomService::seed_t NuRandomService::getSeed(EngineId const& id) {
+    std::lock_guard const lock{ serviceMutex };
 
     // We require an engine to have been registered before we yield seeds;
     // this should minimise unexpected conflicts.
@@ -129,6 +352,7 @@ namespace rndm {
     SeedMaster_t::Seeder_t seeder, std::string const instance /* = "" */,
     std::optional<seed_t> const seed /* = std::nullopt */
   ) {
+    std::lock_guard const lock{ serviceMutex };
     EngineId id = qualify_engine_label(instance);
     registerEngineIdAndSeeder(id, seeder);
     auto const [ seedValue, frozen ] = extractSeed(id, seed);
@@ -172,6 +396,7 @@ namespace rndm {
   NuRandomService::seed_t NuRandomService::defineEngine
     (SeedMaster_t::Seeder_t seeder, std::string instance /* = {} */)
   {
+    std::lock_guard const lock{ serviceMutex };
     return defineEngineID(qualify_engine_label(instance), seeder);
   } // NuRandomService::defineEngine(string, Seeder_t)
 
@@ -201,7 +426,7 @@ namespace rndm {
         << "', that has already been defined\n";
     }
 
-    ensureValidState();
+    ensureValidDefinitionState();
 
     seeds.registerSeeder(id, seeder);
     seed_t const seed = seedEngine(id);
@@ -229,19 +454,47 @@ namespace rndm {
       //  && (state.state() != NuRandomServiceHelper::ArtState::inModuleBeginRun)
         )
       {
-        throw art::Exception(art::errors::LogicError)
-          << "NuRandomService: not in a module constructor."
+        art::Exception e(art::errors::LogicError);
+        e << "NuRandomService: not in a module constructor."
           << " May not register engines.\n";
+        auto const current = currentState().state();
+        if ((current == NuRandomServiceHelper::ArtState::inModuleBeginRun)
+          || (current == NuRandomServiceHelper::ArtState::inModuleBeginSubRun))
+        {
+          e << "Engines needed only in some runs may be declared in the"
+            " constructor (declareEngine()) and defined here (defineEngine()).\n";
+        }
+        throw e;
       }
     } // if
   } // NuRandomService::ensureValidState()
 
 
+  void NuRandomService::ensureValidDefinitionState() const {
+    // engines declared on construction may be defined later, at the beginning
+    // of a run or subrun: their seed has been assigned already
+    using NuRandomServiceHelper::ArtState;
+    switch (currentState().state()) {
+      case ArtState::inModuleConstructor:
+      case ArtState::inModuleBeginRun:
+      case ArtState::inModuleBeginSubRun:
+        return;
+      default:
+        throw art::Exception(art::errors::LogicError)
+          << "NuRandomService: not in a module constructor, beginRun()"
+          << " or beginSubRun()."
+          << " May not define engines.\n";
+    } // switch
+  } // NuRandomService::ensureValidDefinitionState()
+
+
   //----------------------------------------------------------------------------
-  NuRandomService::seed_t NuRandomService::reseedInstance(EngineId const& id) {
+  NuRandomService::seed_t NuRandomService::reseedInstance
+    (EngineId const& id, NuRandomServiceHelper::ArtState const& artState)
+  {
     // get all the information on the current process, event and module from
     // ArtState:
-    SeedMaster_t::EventData_t const data(state.getEventSeedInputData());
+    SeedMaster_t::EventData_t const data(artState.getEventSeedInputData());
     seed_t const seed = seeds.reseedEvent(id, data);
     if (seed == InvalidSeed) {
       mf::LogDebug("NuRandomService")
@@ -255,20 +508,26 @@ namespace rndm {
   } // NuRandomService::reseedInstance()
 
 
-  void NuRandomService::reseedModule(std::string currentModule) {
+  void NuRandomService::reseedModule
+    (NuRandomServiceHelper::ArtState const& artState)
+  {
+    std::string const currentModule = artState.moduleLabel();
+    ScheduleNumber_t const schedule
+      = engineSchedule(currentModule, artState.schedule());
     for (EngineId const& ID: seeds.engineIDsRange()) {
       if (ID.moduleLabel != currentModule) continue; // not our module? neeext!!
-      reseedInstance(ID);
+      if (ID.schedule != schedule) continue; // another replica's? neeext!!
+      reseedInstance(ID, artState);
     } // for
-  } // NuRandomService::reseedModule(string)
+  } // NuRandomService::reseedModule()
 
-  void NuRandomService::reseedModule() { reseedModule(state.moduleLabel()); }
 
-
-  void NuRandomService::reseedGlobal() {
+  void NuRandomService::reseedGlobal
+    (NuRandomServiceHelper::ArtState const& artState)
+  {
     for (EngineId const& ID: seeds.engineIDsRange()) {
       if (!ID.isGlobal()) continue; // not global? neeext!!
-      reseedInstance(ID);
+      reseedInstance(ID, artState);
     } // for
   } // NuRandomService::reseedGlobal()
 
@@ -277,6 +536,8 @@ namespace rndm {
   void NuRandomService::registerEngineIdAndSeeder
     (EngineId const& id, SeedMaster_t::Seeder_t seeder)
   {
+    std::lock_guard const lock{ serviceMutex };
+
     // Are we being called from the right place?
     ensureValidState(id.isGlobal());
 
@@ -327,66 +588,198 @@ namespace rndm {
   //----------------------------------------------------------------------------
   // Callbacks called by art.  Used to maintain information about state.
   void NuRandomService::preModuleConstruction(art::ModuleDescription const& md)  {
+    std::lock_guard const lock{ serviceMutex };
+    if (state.state() == NuRandomServiceHelper::ArtState::inModuleConstructor)
+    {
+      // the schedule of a replica can't be told while another is constructed
+      throw art::Exception(art::errors::LogicError)
+        << "NuRandomService: module '" << md.moduleLabel()
+        << "' constructed while module '" << state.moduleLabel()
+        << "' still is: concurrent module construction is not supported.\n";
+    }
     state.transit_to(NuRandomServiceHelper::ArtState::inModuleConstructor);
     state.set_module(md);
+    // replicas of a module are constructed one after the other, in the order
+    // of their schedules: count them to learn the schedule of this one;
+    // checkReplicaSchedule() verifies the guess when the module runs
+    std::vector<ScheduleNumber_t>& replicas = moduleReplicas[md.moduleLabel()];
+    replicas.push_back(replicas.size());
+    state.set_schedule(replicas.back());
   } // NuRandomService::preModuleConstruction()
 
   void NuRandomService::postModuleConstruction(art::ModuleDescription const&) {
+    std::lock_guard const lock{ serviceMutex };
     state.reset_state();
+    state.set_schedule(0);
   } // NuRandomService::postModuleConstruction()
 
   void NuRandomService::preModuleBeginRun(art::ModuleContext const& mc) {
-    state.transit_to(NuRandomServiceHelper::ArtState::inModuleBeginRun);
-    state.set_module(mc.moduleDescription());
+    std::lock_guard const lock{ serviceMutex };
+    checkReplicaSchedule(mc);
+    NuRandomServiceHelper::ArtState& artState
+      = scheduleState(mc.scheduleID().id());
+    artState.transit_to(NuRandomServiceHelper::ArtState::inModuleBeginRun);
+    artState.set_module(mc.moduleDescription());
+    setThreadState(&artState);
   } // NuRandomService::preModuleBeginRun()
 
-  void NuRandomService::postModuleBeginRun(art::ModuleContext const&) {
-    state.reset_state();
+  void NuRandomService::postModuleBeginRun(art::ModuleContext const& mc) {
+    std::lock_guard const lock{ serviceMutex };
+    setThreadState(nullptr);
+    scheduleState(mc.scheduleID().id()).reset_state();
   } // NuRandomService::postModuleBeginRun()
 
-  void NuRandomService::preProcessEvent(art::Event const& evt, art::ScheduleContext) {
-    state.transit_to(NuRandomServiceHelper::ArtState::inEvent);
-    state.set_event(evt);
-    seeds.onNewEvent(); // inform the seed master that a new event has come
+  void NuRandomService::preModuleBeginSubRun(art::ModuleContext const& mc) {
+    std::lock_guard const lock{ serviceMutex };
+    checkReplicaSchedule(mc);
+    NuRandomServiceHelper::ArtState& artState
+      = scheduleState(mc.scheduleID().id());
+    artState.transit_to(NuRandomServiceHelper::ArtState::inModuleBeginSubRun);
+    artState.set_module(mc.moduleDescription());
+    setThreadState(&artState);
+  } // NuRandomService::preModuleBeginSubRun()
+
+  void NuRandomService::postModuleBeginSubRun(art::ModuleContext const& mc) {
+    std::lock_guard const lock{ serviceMutex };
+    setThreadState(nullptr);
+    scheduleState(mc.scheduleID().id()).reset_state();
+  } // NuRandomService::postModuleBeginSubRun()
+
+  void NuRandomService::preProcessEvent
+    (art::Event const& evt, art::ScheduleContext sc)
+  {
+    std::lock_guard const lock{ serviceMutex };
+    ScheduleNumber_t const schedule = sc.id().id();
+    NuRandomServiceHelper::ArtState& artState = scheduleState(schedule);
+    artState.transit_to(NuRandomServiceHelper::ArtState::inEvent);
+    artState.set_event(evt);
+    seeds.onNewEvent(schedule); // inform the seed master that a new event has come
+
+    if (eventSeedPrefetcher && ((schedule > 0) || (scheduleStates.size() > 1))) {
+      // the prefetcher follows a single sequence of events
+      mf::LogWarning("NuRandomService")
+        << "Per-event seeds can't be computed in advance with more than one"
+        " schedule: `eventSeedPrefetch` disabled.";
+      eventSeedPrefetcher.reset();
+    }
+    if (eventSeedPrefetcher) prefetchEventSeeds(artState);
 
     MF_LOG_DEBUG("NuRandomService") << "preProcessEvent(): will reseed global engines";
-    reseedGlobal(); // why don't we do them all?!?
+    reseedGlobal(artState); // why don't we do them all?!?
 
   } // NuRandomService::preProcessEvent()
 
   void NuRandomService::preModule(art::ModuleContext const& mc) {
-    state.transit_to(NuRandomServiceHelper::ArtState::inModuleEvent);
-    state.set_module(mc.moduleDescription());
+    std::lock_guard const lock{ serviceMutex };
+    checkReplicaSchedule(mc);
+    NuRandomServiceHelper::ArtState& artState
+      = scheduleState(mc.scheduleID().id());
+    artState.transit_to(NuRandomServiceHelper::ArtState::inModuleEvent);
+    artState.set_module(mc.moduleDescription());
+    setThreadState(&artState);
 
     // Reseed all the engine of this module... maybe
     // (that is, if the current policy alows it).
     MF_LOG_DEBUG("NuRandomService") << "preModule(): will reseed engines for module '"
       << mc.moduleLabel() << "'";
-    reseedModule(mc.moduleLabel());
+    reseedModule(artState);
   } // NuRandomService::preModule()
 
-  void NuRandomService::postModule(art::ModuleContext const&) {
-    state.reset_module();
-    state.reset_state();
+  void NuRandomService::postModule(art::ModuleContext const& mc) {
+    std::lock_guard const lock{ serviceMutex };
+    setThreadState(nullptr);
+    NuRandomServiceHelper::ArtState& artState
+      = scheduleState(mc.scheduleID().id());
+    recordEngineFingerprints(artState);
+    artState.reset_module();
+    artState.reset_state();
   } // NuRandomService::postModule()
 
-  void NuRandomService::postProcessEvent(art::Event const&, art::ScheduleContext) {
-    state.reset_event();
-    state.reset_state();
+  void NuRandomService::postProcessEvent
+    (art::Event const& evt, art::ScheduleContext sc)
+  {
+    std::lock_guard const lock{ serviceMutex };
+    NuRandomServiceHelper::ArtState& artState = scheduleState(sc.id().id());
+    artState.reset_event();
+    artState.reset_state();
+
+    ++nProcessedEvents;
+    if ((checkpointConfig.everyNEvents > 0)
+      && (nProcessedEvents % checkpointConfig.everyNEvents == 0))
+    {
+      std::ostringstream label;
+      label << "after event " << evt.id() << " (" << nProcessedEvents
+        << " events processed)";
+      writeCheckpoint(label.str());
+    }
   } // NuRandomService::postProcessEvent()
 
   void NuRandomService::preModuleEndJob(art::ModuleDescription const& md) {
+    std::lock_guard const lock{ serviceMutex };
     state.transit_to(NuRandomServiceHelper::ArtState::inEndJob);
     state.set_module(md);
   } // NuRandomService::preModuleBeginRun()
 
   void NuRandomService::postModuleEndJob(art::ModuleDescription const&) {
+    std::lock_guard const lock{ serviceMutex };
     state.reset_state();
   } // NuRandomService::preModuleBeginRun()
 
   void NuRandomService::postEndJob() {
+    std::lock_guard const lock{ serviceMutex };
     if ((verbosity > 0) || bPrintEndOfJobSummary)
       print(); // framework logger decides whether and where it shows up
+
+    if (!endOfJobManifestPath.empty()) {
+      std::ofstream manifest(endOfJobManifestPath);
+      if (!manifest) {
+        throw art::Exception(art::errors::FileOpenError)
+          << "NuRandomService: can't write the seed manifest into '"
+          << endOfJobManifestPath << "'\n";
+      }
+      printManifest(manifest);
+      mf::LogInfo("NuRandomService")
+        << "Seed manifest written into '" << endOfJobManifestPath << "'";
+    } // if manifest
+
+    if (!checkpointConfig.path.empty()) {
+      writeCheckpoint
+        ("at end of job (" + std::to_string(nProcessedEvents) + " events processed)");
+    }
+
+    if (engineStateCache) {
+      mf::LogInfo("NuRandomService")
+        << "Engine state cache: " << engineStateCache->hits() << " hits, "
+        << engineStateCache->misses() << " misses ("
+        << engineStateCache->size() << "/" << engineStateCache->capacity()
+        << " states cached)";
+    } // if cache
+
+    if (eventSeedPrefetcher) {
+      mf::LogInfo("NuRandomService")
+        << "Per-event seeds computed in advance: "
+        << eventSeedPrefetcher->hits() << " events, "
+        << eventSeedPrefetcher->misses() << " computed on demand";
+    } // if prefetcher
+
+    if (engineFingerprints) {
+      engineFingerprints->close();
+      mf::LogInfo log("NuRandomService");
+      log << "Engine state hashes: " << engineFingerprints->nRecords()
+        << " records of " << engineFingerprints->nEngines()
+        << " engines written into '" << engineFingerprints->path() << "'";
+      if (scheduleStates.size() > 1) {
+        log << " (from " << scheduleStates.size()
+          << " schedules: the order of the records may differ between jobs)";
+      }
+    } // if fingerprints
+
+    if (auto const* monitor = seeds.collisionMonitor()) {
+      if (monitor->nConfirmed() > 0) {
+        monitor->printSummary(mf::LogWarning("NuRandomService"));
+      }
+      else monitor->printSummary(mf::LogInfo("NuRandomService"));
+    } // if collision monitor
   } // NuRandomService::postEndJob()
 
   //----------------------------------------------------------------------------
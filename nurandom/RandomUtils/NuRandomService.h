@@ -27,10 +27,17 @@
 #include <string>
 #include <utility> // std::forward()
 #include <initializer_list>
+#include <map>
+#include <memory> // std::shared_ptr<>
+#include <mutex> // std::recursive_mutex, std::lock_guard<>
+#include <vector>
 
 // Some helper classes.
 #include "nurandom/RandomUtils/ArtState.h"
+#include "nurandom/RandomUtils/EngineStateCache.h"
+#include "nurandom/RandomUtils/EventSeedPrefetcher.h"
 #include "nurandom/RandomUtils/Providers/SeedMaster.h"
+#include "nurandom/RandomUtils/Providers/EngineFingerprints.h"
 
 // CLHEP libraries
 #if (NURANDOM_RANDOMUTILS_NuRandomService_USECLHEP)
@@ -159,6 +166,26 @@ namespace rndm {
    * That is because we don't want engines to be initialized in the middle of a
    * job.
    *
+   * The only exception is the definition of an engine which was declared in
+   * the constructor: `defineEngine()` may also be called in `beginRun()` and
+   * `beginSubRun()`. A module can then declare in its constructor all the
+   * engines it may ever need, which costs little, and create and define only
+   * the ones actually needed, when it learns which they are:
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * // in the constructor:
+   * for (std::string const& model: allNoiseModels) Seeds.declareEngine(model);
+   *
+   * // in beginRun():
+   * for (std::string const& model: noiseModelsOfRun(run)) {
+   *   fEngines[model] = std::make_unique<CLHEP::MixMaxRng>();
+   *   Seeds.defineEngine(*fEngines[model], model);
+   * }
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   * The seed is assigned on declaration, so it does not depend on when, or
+   * whether, the engine is defined: the seeds of all the engines of the job
+   * are the same as if all of them were defined in the constructors.
+   * An engine can be defined only once in the job.
+   *
    *
    * Setting the seed of an engine
    * ------------------------------
@@ -396,6 +423,33 @@ namespace rndm {
    * thing distinguishing global engines, and name conflicts between different
    * services may easily arise.
    *
+   *
+   * Replicated modules and multiple schedules
+   * ==========================================
+   *
+   * A replicated art module has one instance on each schedule, all of them
+   * with the same label. Each instance registers its own engines, with the
+   * same calls as any other module; `NuRandomService` tells the replicas
+   * apart by qualifying their engine IDs with the schedule
+   * (`EngineId::schedule`). The replica on the first schedule gets the engine
+   * IDs the module would have in a job with a single schedule. It gets the
+   * same seeds too only with the policies assigning them by engine ID
+   * (`preDefinedSeed`, `preDefinedOffset`); the other policies assign seeds
+   * in order of request, and the replicas on the other schedules may request
+   * theirs before modules constructed later.
+   * The schedule of a replica is inferred from the order of
+   * construction, since art constructs modules one at a time, and the
+   * replicas of each module in the order of their schedules.
+   * Under per-event policies the seed of an engine depends only on the event,
+   * not on the schedule which processes it (see `rndm::SeedMaster`).
+   *
+   * The service may be used concurrently by different schedules: each
+   * schedule has its own record of event and running module, and the access
+   * to the seeds is serialized. Global engines are not replicated: if they
+   * are reseeded on each event, they should not be used with more than one
+   * schedule. The computation of per-event seeds in advance
+   * (`eventSeedPrefetch`) is disabled when more than one schedule is used.
+   *
    */
   class NuRandomService {
       public:
@@ -406,9 +460,19 @@ namespace rndm {
 
     using EngineId = SeedMaster_t::EngineId; ///< type of random engine ID
 
+    /// type of compact handle to a registered engine
+    using EngineHandle = SeedMaster_t::EngineHandle;
+
     /// An invalid seed
     static constexpr seed_t InvalidSeed = SeedMaster_t::InvalidSeed;
 
+    /// type of cache of engine states after seeding
+    using EngineStateCache_t = NuRandomServiceHelper::EngineStateCache<seed_t>;
+
+    /// An engine to be registered by `registerAndSeedEngines()`.
+    using EngineAndInstance_t
+      = std::pair<std::reference_wrapper<engine_t>, std::string>;
+
     NuRandomService(const fhicl::ParameterSet&, art::ActivityRegistry&);
 
     // Accept compiler written d'tor.  Not copyable or assignable.
@@ -460,7 +524,7 @@ namespace rndm {
      * returned. See `getSeed(std::string const&, std::string const&)` for
      * details.
      *
-     * @note This method is **not thread-safe**.
+     * @note In a module replica, the engine of the same replica is used.
      */
     seed_t getSeed(std::string instanceName = "");
 
@@ -493,15 +557,103 @@ namespace rndm {
 
     /// Returns the last computed seed for specified engine of current module
     seed_t getCurrentSeed(std::string instanceName) const
-      { return seeds.getCurrentSeed(qualify_engine_label(instanceName)); }
+      {
+        std::lock_guard const lock{ serviceMutex };
+        return seeds.getCurrentSeed(qualify_engine_label(instanceName));
+      }
 
     /// Returns the last computed seed for the default engine of current module
     seed_t getCurrentSeed() const
-      { return seeds.getCurrentSeed(qualify_engine_label()); }
+      {
+        std::lock_guard const lock{ serviceMutex };
+        return seeds.getCurrentSeed(qualify_engine_label());
+      }
 
     /// Returns the last computed seed for the specified global engine
     seed_t getGlobalCurrentSeed(std::string instanceName) const
-      { return seeds.getCurrentSeed(qualify_global_engine(instanceName)); }
+      {
+        std::lock_guard const lock{ serviceMutex };
+        return seeds.getCurrentSeed(qualify_global_engine(instanceName));
+      }
+
+
+    // --- BEGIN --- Access by engine handle -----------------------------------
+    /**
+     * @name Access by engine handle
+     *
+     * An engine handle is a small value that can be kept by the modules and
+     * used to query the seeds of an engine, or to reseed it, in constant time
+     * and without any memory allocation, which makes it suitable for use
+     * in the event loop:
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * // in the constructor:
+     * auto& Seeds = *art::ServiceHandle<rndm::NuRandomService>();
+     * fEngineHandle = Seeds.registerAndSeedEngineHandle
+     *   (createEngine(0, "HepJamesRandom", "instanceName"), "HepJamesRandom", "instanceName");
+     *
+     * // in produce():
+     * seed_t const seed = Seeds.getCurrentSeed(fEngineHandle);
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     * The engine must have been registered before a handle can be obtained.
+     * Handles are valid for the whole job.
+     */
+    /// @{
+
+    /// Returns the handle of the specified engine of the specified module
+    /// @throw art::Exception (art::errors::LogicError) if engine not registered
+    EngineHandle engineHandle
+      (std::string const& moduleLabel, std::string const& instanceName)
+      {
+        std::lock_guard const lock{ serviceMutex };
+        return seeds.engineHandle(qualify_engine_label(moduleLabel, instanceName));
+      }
+
+    /// Returns the handle of the specified engine of the current module
+    /// @throw art::Exception (art::errors::LogicError) if engine not registered
+    EngineHandle engineHandle(std::string instanceName = "")
+      {
+        std::lock_guard const lock{ serviceMutex };
+        return seeds.engineHandle(qualify_engine_label(instanceName));
+      }
+
+    /// Returns the handle of the specified global engine
+    /// @throw art::Exception (art::errors::LogicError) if engine not registered
+    EngineHandle globalEngineHandle(std::string instanceName)
+      {
+        std::lock_guard const lock{ serviceMutex };
+        return seeds.engineHandle(qualify_global_engine(instanceName));
+      }
+
+    /// Returns the configured seed of the engine with the specified handle
+    seed_t getSeed(EngineHandle handle) const
+      {
+        std::lock_guard const lock{ serviceMutex };
+        return seeds.getSeed(handle);
+      }
+
+    /// Returns the last computed seed of the engine with the specified handle
+    seed_t getCurrentSeed(EngineHandle handle) const
+      {
+        std::lock_guard const lock{ serviceMutex };
+        return seeds.getCurrentSeed(handle);
+      }
+
+    /**
+     * @brief Reseeds the engine with the specified handle with its seed
+     * @param handle the handle of the engine to be reseeded
+     * @return the seed set, or `InvalidSeed` if no reseeding happened
+     *
+     * The engine is reseeded with its configured seed (the one from
+     * `getSeed(EngineHandle)`). Engines with a frozen seed are not reseeded.
+     */
+    seed_t reseed(EngineHandle handle)
+      {
+        std::lock_guard const lock{ serviceMutex };
+        return seeds.reseed(handle);
+      }
+
+    /// @}
+    // --- END --- Access by engine handle -------------------------------------
 
 
     // --- BEGIN --- Create and register an engine -----------------------------
@@ -750,6 +902,106 @@ namespace rndm {
       )
       { return registerAndSeedEngine(engine, "", "", pset, pnames); }
 
+    /**
+     * @brief Registers and seeds an engine which can skip ahead.
+     * @tparam Engine type of CLHEP engine, providing `skip(std::uint64_t)`
+     * @param engine the engine to register with the service
+     * @param type the type of engine
+     * @param instance the name of the engine instance
+     * @param seed the seed to use for this engine (optional)
+     * @return the engine
+     * @see `registerAndSeedEngine()`, `CLHEPengineJumper`
+     *
+     * This method operates like
+     * `registerAndSeedEngine(engine_t&, std::string, std::string, std::optional<seed_t> const)`,
+     * and in addition it registers a jumper for the engine (see
+     * `CLHEPengineJumper`). With policies supporting it (`perEvent` in
+     * `jumpAhead` mode), the engine is then not reseeded on each event, but
+     * moved forward from its state after the job seeding.
+     */
+    template <typename Engine>
+    Engine& registerAndSeedJumpingEngine(
+      Engine& engine,
+      std::string type = "", std::string instance = "",
+      std::optional<seed_t> const seed = std::nullopt
+      );
+
+    /**
+     * @brief Registers and seeds an engine accepting multi-word seeds.
+     * @param engine the engine to register with the service
+     * @param nWords number of seed words to set to the engine
+     * @param type the type of engine
+     * @param instance the name of the engine instance
+     * @param seed the seed to use for this engine (optional)
+     * @return the engine
+     * @see `registerAndSeedEngine()`, `CLHEPengineMultiSeeder`
+     *
+     * This method operates like
+     * `registerAndSeedEngine(engine_t&, std::string, std::string, std::optional<seed_t> const)`,
+     * but the engine is seeded with `nWords` seed words via
+     * `CLHEP::HepRandomEngine::setSeeds()`.
+     * The first word is the seed assigned by the policy (or `seed`, if
+     * specified); the others are derived from it or, with policies
+     * supporting it (`perEvent`), from a wider hash of the event information
+     * than a single seed can hold. This reduces the chance that two streams
+     * of a large campaign start from the same state.
+     */
+    engine_t& registerAndSeedMultiWordEngine(
+      engine_t& engine, std::size_t nWords,
+      std::string type = "", std::string instance = "",
+      std::optional<seed_t> const seed = std::nullopt
+      );
+
+    /**
+     * @brief Registers and seeds many engines of the current module at once.
+     * @param engines the engines to register, each with its instance name
+     * @param type the type of the engines
+     * @return the seed of each engine, in the same order as `engines`
+     * @see `registerAndSeedEngine()`, `SeedMaster::registerNewSeeders()`
+     *
+     * This method is equivalent to calling
+     * `registerAndSeedEngine(engine, type, instance)` on each of the engines,
+     * but the state of the service is checked once, and the seeds are assigned
+     * and checked for uniqueness once for the whole batch. Registering many
+     * engines (e.g. one per detector segment) then takes a time growing
+     * linearly with their number, rather than quadratically.
+     *
+     * All the seeds are assigned by the policy: use `registerAndSeedEngine()`
+     * for engines with a seed from the configuration.
+     *
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+     * std::vector<rndm::NuRandomService::EngineAndInstance_t> engines;
+     * for (unsigned int iSegment = 0; iSegment < nSegments; ++iSegment) {
+     *   std::string const instance = "segment" + std::to_string(iSegment);
+     *   engines.emplace_back(createEngine(0, "HepJamesRandom", instance), instance);
+     * }
+     * art::ServiceHandle<rndm::NuRandomService>()
+     *   ->registerAndSeedEngines(engines, "HepJamesRandom");
+     * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+     */
+    std::vector<seed_t> registerAndSeedEngines
+      (std::vector<EngineAndInstance_t> const& engines, std::string type = "");
+
+
+    /**
+     * @brief Registers and seeds an engine, returning its handle.
+     * @param engine a reference to the CLHEP::HepRandomEngine to be managed
+     * @param type the type of engine (for diagnostics only)
+     * @param instance the name of the engine instance
+     * @param seed if specified, the seed to be used (and frozen)
+     * @return the handle of the registered engine
+     * @see `registerAndSeedEngine()`, `engineHandle()`
+     *
+     * This is the same as `registerAndSeedEngine()`, but it returns the handle
+     * of the newly registered engine instead of the engine itself.
+     */
+    EngineHandle registerAndSeedEngineHandle(
+      engine_t& engine,
+      std::string type = "",
+      std::string instance = "",
+      std::optional<seed_t> const seed = std::nullopt
+      );
+
 #endif // NURANDOM_RANDOMUTILS_NuRandomService_USECLHEP
     /// @}
     // --- END --- Create and register an engine -------------------------------
@@ -952,7 +1204,12 @@ namespace rndm {
      */
     seed_t registerEngine
       (CLHEP::HepRandomEngine& engine, std::string instance = "")
-      { return registerEngine(CLHEPengineSeeder(engine), instance); }
+      {
+        seed_t const seed = registerEngine
+          (CLHEPengineSeeder(engine, engineStateCache.get()), instance);
+        watchEngineState(engine, instance);
+        return seed;
+      }
 
     /**
      * @brief Registers an existing CLHEP engine with `art::NuRandomService`.
@@ -971,7 +1228,12 @@ namespace rndm {
       CLHEP::HepRandomEngine& engine, std::string instance,
       SeedAtom const& seedParam
       )
-      { return registerEngine(CLHEPengineSeeder(engine), instance, seedParam); }
+      {
+        seed_t const seed = registerEngine
+          (CLHEPengineSeeder(engine, engineStateCache.get()), instance, seedParam);
+        watchEngineState(engine, instance);
+        return seed;
+      }
 
     /**
      * @brief Registers an existing CLHEP engine with `art::NuRandomService`.
@@ -992,8 +1254,10 @@ namespace rndm {
       fhicl::ParameterSet const& pset, std::initializer_list<std::string> pnames
       )
       {
-        return registerEngine
-          (CLHEPengineSeeder(engine), instance, pset, pnames);
+        seed_t const seed = registerEngine
+          (CLHEPengineSeeder(engine, engineStateCache.get()), instance, pset, pnames);
+        watchEngineState(engine, instance);
+        return seed;
       }
 #endif // NURANDOM_RANDOMUTILS_NuRandomService_USECLHEP
 
@@ -1110,6 +1374,10 @@ namespace rndm {
      * of setting seeds automatically when needed.
      * This step is not mandatory, but no automatic seeding will happen if it is
      * omitted.
+     *
+     * Differently from the other registration methods, this one may also be
+     * called in the `beginRun()` and `beginSubRun()` methods of the module
+     * (see "Registration of a random generator engine" above).
      */
     seed_t defineEngine
       (SeedMaster_t::Seeder_t seeder, std::string instance = {});
@@ -1128,7 +1396,12 @@ namespace rndm {
      */
     seed_t defineEngine
       (CLHEP::HepRandomEngine& engine, std::string instance = {})
-      { return defineEngine(CLHEPengineSeeder(engine), instance); }
+      {
+        seed_t const seed = defineEngine
+          (CLHEPengineSeeder(engine, engineStateCache.get()), instance);
+        watchEngineState(engine, instance);
+        return seed;
+      }
 #endif // NURANDOM_RANDOMUTILS_NuRandomService_USECLHEP
     /// @}
 
@@ -1136,11 +1409,28 @@ namespace rndm {
     /// Prints known (EngineId,seed) pairs.
     template<class Stream>
     void print(Stream&& out) const
-      { seeds.print(std::forward<Stream>(out)); }
+      {
+        std::lock_guard const lock{ serviceMutex };
+        seeds.print(std::forward<Stream>(out));
+      }
 
     /// Prints to the framework Info logger
     void print() const { print(mf::LogInfo("NuRandomService")); }
 
+    /// Writes a JSON manifest of the known seeds (see `SeedMaster::printManifest()`)
+    void printManifest(std::ostream& out) const
+      {
+        std::lock_guard const lock{ serviceMutex };
+        seeds.printManifest(out);
+      }
+
+    /// Writes a binary checkpoint of the seeds (see `SeedMaster::saveCheckpoint()`)
+    void saveCheckpoint(std::ostream& out, std::string const& label = "") const
+      {
+        std::lock_guard const lock{ serviceMutex };
+        seeds.saveCheckpoint(out, label);
+      }
+
 #if (NURANDOM_RANDOMUTILS_NuRandomService_USEROOT)
     /// Seeder_t functor setting the seed of a ROOT TRandom engine (untested!)
     class TRandomSeeder {
@@ -1154,21 +1444,137 @@ namespace rndm {
 #endif // NURANDOM_RANDOMUTILS_NuRandomService_USEROOT
 
 #if (NURANDOM_RANDOMUTILS_NuRandomService_USECLHEP)
-    /// Seeder_t functor setting the seed of a CLHEP::HepRandomEngine engine (untested!)
+    /**
+     * @brief Seeder_t functor setting the seed of a CLHEP::HepRandomEngine engine
+     *
+     * If a cache of engine states is provided, the state of the engine after
+     * the seeding is stored in it, and when the same type of engine is seeded
+     * again with the same seed, that state is copied into the engine instead
+     * of running the seeding procedure again.
+     */
     class CLHEPengineSeeder {
         public:
-      CLHEPengineSeeder(CLHEP::HepRandomEngine& e): engine(e) {}
-      CLHEPengineSeeder(CLHEP::HepRandomEngine* e): engine(*e) {}
+      CLHEPengineSeeder
+        (CLHEP::HepRandomEngine& e, EngineStateCache_t* cache = nullptr)
+        : engine(e), stateCache(cache)
+        {}
+      CLHEPengineSeeder
+        (CLHEP::HepRandomEngine* e, EngineStateCache_t* cache = nullptr)
+        : engine(*e), stateCache(cache)
+        {}
       void operator() (EngineId const&, seed_t seed)
         {
-          engine.setSeed(seed, 0);
+          if (stateCache) {
+            std::string const engineName = engine.name();
+            auto const* state = stateCache->find(engineName, seed);
+            if (state && engine.get(*state)) {
+              MF_LOG_DEBUG("CLHEPengineSeeder")
+                << "CLHEP engine: '" << engineName << "'[" << ((void*) &engine)
+                << "] state restored for seed " << seed;
+              return;
+            }
+            engine.setSeed(seed, 0);
+            stateCache->insert(engineName, seed, engine.put());
+          }
+          else engine.setSeed(seed, 0);
           MF_LOG_DEBUG("CLHEPengineSeeder")
             << "CLHEP engine: '" << engine.name() << "'[" << ((void*) &engine)
             << "].setSeed(" << seed << ", 0)";
         }
         protected:
       CLHEP::HepRandomEngine& engine;
+      EngineStateCache_t* stateCache = nullptr; ///< cache of states (optional)
     }; // class CLHEPengineSeeder
+
+    /**
+     * @brief Seeder and jumper of a CLHEP engine which can skip ahead.
+     * @tparam Engine type of engine, providing `skip(std::uint64_t)`
+     *
+     * As a seeder, this object sets the seed of the engine like
+     * `CLHEPengineSeeder` does, and then saves the state of the engine.
+     * As a jumper (`jump()`), it restores that state and moves the engine
+     * ahead by the requested number of steps.
+     * Copies of this object share the saved state.
+     */
+    template <typename Engine>
+    class CLHEPengineJumper {
+        public:
+      using EventSkip_t = SeedMaster_t::EventSkip_t;
+
+      CLHEPengineJumper(Engine& e)
+        : engine(e), baseState(std::make_shared<std::vector<unsigned long>>())
+        {}
+
+      /// Seeds the engine and saves its state as base for the jumps.
+      void operator() (EngineId const&, seed_t seed)
+        {
+          engine.setSeed(seed, 0);
+          *baseState = engine.put();
+          MF_LOG_DEBUG("CLHEPengineJumper")
+            << "CLHEP engine: '" << engine.name() << "'[" << ((void*) &engine)
+            << "].setSeed(" << seed << ", 0)";
+        }
+
+      /// Restores the engine to the base state, and skips `n` steps ahead.
+      void jump(EngineId const&, EventSkip_t n)
+        {
+          engine.get(*baseState);
+          engine.skip(n);
+          MF_LOG_DEBUG("CLHEPengineJumper")
+            << "CLHEP engine: '" << engine.name() << "'[" << ((void*) &engine)
+            << "].skip(" << n << ")";
+        }
+
+      /// Returns a jumper function for `SeedMaster`.
+      SeedMaster_t::Jumper_t jumper() const
+        {
+          return [j=*this](EngineId const& id, EventSkip_t n) mutable
+            { j.jump(id, n); };
+        }
+
+        protected:
+      Engine& engine;
+      /// Engine state after the last seeding.
+      std::shared_ptr<std::vector<unsigned long>> baseState;
+    }; // class CLHEPengineJumper
+
+    /**
+     * @brief Seeder of a CLHEP engine with multiple seed words.
+     *
+     * The seed words are set via `CLHEP::HepRandomEngine::setSeeds()`.
+     * A single seed is first expanded into `nWords` words (see
+     * `rndm::details::expandSeedWords()`).
+     * The engine state cache is not used, since it is indexed by single seeds.
+     */
+    class CLHEPengineMultiSeeder {
+        public:
+      using SeedWords_t = SeedMaster_t::SeedWords_t;
+
+      CLHEPengineMultiSeeder(CLHEP::HepRandomEngine& e, std::size_t nWords)
+        : engine(e), nWords(nWords)
+        {}
+
+      /// Expands the seed and sets the resulting words.
+      void operator() (EngineId const& id, seed_t seed)
+        { (*this)(id, details::expandSeedWords(seed, nWords)); }
+
+      /// Sets the seed words to the engine.
+      void operator() (EngineId const&, SeedWords_t const& words)
+        {
+          // CLHEP seed arrays are terminated by a zero
+          std::vector<long> seeds(words.begin(), words.end());
+          seeds.push_back(0);
+          engine.setSeeds(seeds.data(), static_cast<int>(words.size()));
+          MF_LOG_DEBUG("CLHEPengineMultiSeeder")
+            << "CLHEP engine: '" << engine.name() << "'[" << ((void*) &engine)
+            << "].setSeeds(" << words.size() << " words starting with "
+            << (words.empty()? 0: words.front()) << ")";
+        }
+
+        protected:
+      CLHEP::HepRandomEngine& engine;
+      std::size_t nWords; ///< number of seed words
+    }; // class CLHEPengineMultiSeeder
 #endif // NURANDOM_RANDOMUTILS_NuRandomService_USECLHEP
 
   private:
@@ -1187,9 +1593,94 @@ namespace rndm {
      */
     NuRandomServiceHelper::ArtState state;
 
+    /// Type of the number of an art schedule.
+    using ScheduleNumber_t = SeedMaster_t::ScheduleNumber_t;
+
+    /// State of the event processing, for each schedule.
+    std::map<ScheduleNumber_t, NuRandomServiceHelper::ArtState> scheduleStates;
+
+    /// Schedule assigned to each replica of each module, in construction order.
+    std::map<std::string, std::vector<ScheduleNumber_t>> moduleReplicas;
+
+    /// Serializes the access to the seeds from concurrent schedules.
+    mutable std::recursive_mutex serviceMutex;
+
     /// Control the level of information messages.
     int verbosity = 0;
     bool bPrintEndOfJobSummary = false; ///< print a summary at the end of job
+    std::string endOfJobManifestPath; ///< where to write the seed manifest
+
+    /// Cache of the states of CLHEP engines after seeding (optional).
+    std::unique_ptr<EngineStateCache_t> engineStateCache;
+
+    /// type of the writer of engine state hashes
+    using EngineFingerprints_t = NuRandomServiceHelper::EngineFingerprintWriter;
+
+    /// Records the hash of engine states after each module (optional).
+    std::unique_ptr<EngineFingerprints_t> engineFingerprints;
+
+    /// Configuration of the checkpoint of the seed state.
+    struct CheckpointConfig_t {
+      std::string path; ///< checkpoint file (empty: no checkpoint)
+      unsigned int everyNEvents = 0U; ///< events between checkpoints (0: end of job only)
+      bool restore = false; ///< whether to restore from `path` at construction
+    }; // CheckpointConfig_t
+
+    CheckpointConfig_t checkpointConfig; ///< checkpoint configuration
+    unsigned long long nProcessedEvents = 0ULL; ///< events processed so far
+
+    /// type of the background computation of per-event seeds
+    using EventSeedPrefetcher_t
+      = NuRandomServiceHelper::EventSeedPrefetcher<SeedMaster_t>;
+
+    /// Computes per-event seeds of the upcoming events (optional).
+    std::unique_ptr<EventSeedPrefetcher_t> eventSeedPrefetcher;
+
+    /// Engines whose per-event seeds are computed in advance.
+    std::shared_ptr<std::vector<EngineId> const> prefetchedEngines;
+
+    /// Number of registered engines when `prefetchedEngines` was filled.
+    std::size_t nPrefetchedEngines = 0;
+
+    /// Reads the checkpoint configuration (`checkpoint` table).
+    static CheckpointConfig_t readCheckpointConfig
+      (fhicl::ParameterSet const& paramSet);
+
+    /// Restores the seed state from the checkpoint file, if present.
+    void restoreCheckpoint();
+
+    /// Writes the seed state into the checkpoint file, atomically.
+    void writeCheckpoint(std::string const& label) const;
+
+    /// Creates the engine state cache, if configured.
+    static std::unique_ptr<EngineStateCache_t> makeEngineStateCache
+      (fhicl::ParameterSet const& paramSet);
+
+    /// Opens the file of engine state hashes, if configured.
+    static std::unique_ptr<EngineFingerprints_t> makeEngineFingerprints
+      (fhicl::ParameterSet const& paramSet);
+
+    /// Records the state of the engines of the module just run, if enabled.
+    void recordEngineFingerprints
+      (NuRandomServiceHelper::ArtState const& artState);
+
+#if (NURANDOM_RANDOMUTILS_NuRandomService_USECLHEP)
+    /// Has the state of the CLHEP engine recorded after each event, if enabled.
+    void watchEngineState
+      (CLHEP::HepRandomEngine const& engine, std::string const& instance)
+      {
+        if (!engineFingerprints) return;
+        engineFingerprints->watch
+          (qualify_engine_label(instance), [&engine](){ return engine.put(); });
+      }
+#endif // NURANDOM_RANDOMUTILS_NuRandomService_USECLHEP
+
+    /// Creates the prefetcher of per-event seeds, if configured.
+    std::unique_ptr<EventSeedPrefetcher_t> makeEventSeedPrefetcher
+      (fhicl::ParameterSet const& paramSet) const;
+
+    /// Uses the per-event seeds computed in advance, and requests new ones.
+    void prefetchEventSeeds(NuRandomServiceHelper::ArtState const& artState);
 
     /// Register an engine and seeds it with the seed from the master
     seed_t registerEngineID(
@@ -1212,19 +1703,55 @@ namespace rndm {
 
     /**
      * @brief Reseeds the specified engine instance in the current module
-     * @param instance the name of the engine instance
+     * @param id the ID of the engine
+     * @param artState state of the schedule the engine is reseeded for
      * @return the seed set, or InvalidSeed if no reseeding happened
      */
-    seed_t reseedInstance(EngineId const& id);
+    seed_t reseedInstance
+      (EngineId const& id, NuRandomServiceHelper::ArtState const& artState);
 
-    //@{
-    /// Reseeds all the engines in the current module
-    void reseedModule(std::string currentModule);
-    void reseedModule();
-    //@}
+    /// Reseeds all the engines of the module currently running in `artState`
+    void reseedModule(NuRandomServiceHelper::ArtState const& artState);
 
     /// Reseed all the global engines
-    void reseedGlobal();
+    void reseedGlobal(NuRandomServiceHelper::ArtState const& artState);
+
+    /// Returns the state of the specified schedule (created if needed).
+    NuRandomServiceHelper::ArtState& scheduleState(ScheduleNumber_t schedule);
+
+    /**
+     * @brief Returns the state of the schedule running in this thread
+     *
+     * While a module is running in this thread (between the `preModule` and
+     * `postModule` callbacks, and the analogous ones for begin of run), the
+     * state of the schedule of that module is returned; otherwise, the global
+     * state (which covers e.g. the construction of modules).
+     */
+    NuRandomServiceHelper::ArtState const& currentState() const;
+
+    /**
+     * @brief Returns the schedule number qualifying the engines of a module
+     * @param moduleLabel label of the module
+     * @param schedule the schedule (or replica) number of the module
+     * @return `schedule` if the module is replicated, `0` otherwise
+     */
+    ScheduleNumber_t engineSchedule
+      (std::string const& moduleLabel, ScheduleNumber_t schedule) const;
+
+    /**
+     * @brief Checks the schedule assigned to the replicas of a module
+     * @param mc context of the module about to run
+     * @throw art::Exception (`art::errors::LogicError`) if no replica of the
+     *        module was assigned the schedule it runs on
+     *
+     * The schedule of each replica is assigned on construction, from the order
+     * the replicas are constructed in (see `preModuleConstruction()`).
+     */
+    void checkReplicaSchedule(art::ModuleContext const& mc) const;
+
+    /// Records that the current thread runs a module on the specified state.
+    static void setThreadState
+      (NuRandomServiceHelper::ArtState const* artState);
 
     /// Registers the engine ID into SeedMaster
     seed_t prepareEngine(EngineId const& id, SeedMaster_t::Seeder_t seeder);
@@ -1232,6 +1759,9 @@ namespace rndm {
     // Helper functions for all policies
     void ensureValidState(bool bGlobal = false) const;
 
+    /// Throws if not in a context where declared engines may be defined.
+    void ensureValidDefinitionState() const;
+
     //@{
     /// Returns a fully qualified EngineId
     EngineId qualify_engine_label
@@ -1277,11 +1807,13 @@ namespace rndm {
     void preModuleConstruction (art::ModuleDescription const& md);
     void postModuleConstruction(art::ModuleDescription const&);
     void preModuleBeginRun     (art::ModuleContext const& mc);
-    void postModuleBeginRun    (art::ModuleContext const&);
-    void preProcessEvent       (art::Event const& evt, art::ScheduleContext);
+    void postModuleBeginRun    (art::ModuleContext const& mc);
+    void preModuleBeginSubRun  (art::ModuleContext const& mc);
+    void postModuleBeginSubRun (art::ModuleContext const& mc);
+    void preProcessEvent       (art::Event const& evt, art::ScheduleContext sc);
     void preModule             (art::ModuleContext const& mc);
-    void postModule            (art::ModuleContext const&);
-    void postProcessEvent      (art::Event const&, art::ScheduleContext);
+    void postModule            (art::ModuleContext const& mc);
+    void postProcessEvent      (art::Event const&, art::ScheduleContext sc);
     void preModuleEndJob       (art::ModuleDescription const& md);
     void postModuleEndJob      (art::ModuleDescription const&);
     void postEndJob            ();
@@ -1303,10 +1835,13 @@ namespace rndm {
                                          std::string instance,
                                          std::optional<seed_t> const seed)
   {
+    std::lock_guard const lock{ serviceMutex };
     EngineId const id = qualify_engine_label(instance);
-    registerEngineIdAndSeeder(id, CLHEPengineSeeder{engine});
+    CLHEPengineSeeder seeder{engine, engineStateCache.get()};
+    registerEngineIdAndSeeder(id, seeder);
+    watchEngineState(engine, instance);
     auto const [seedValue, frozen] = extractSeed(id, seed);
-    engine.setSeed(seedValue, 0);
+    seeder(id, seedValue);
     mf::LogInfo("NuRandomService")
       << "Seeding " << type << " engine \"" << id.artName()
       << "\" with seed " << seedValue << ".";
@@ -1337,10 +1872,104 @@ namespace rndm {
   }
 
 
+  template <typename Engine>
+  Engine& NuRandomService::registerAndSeedJumpingEngine(Engine& engine,
+                                                        std::string type,
+                                                        std::string instance,
+                                                        std::optional<seed_t> const seed)
+  {
+    std::lock_guard const lock{ serviceMutex };
+    EngineId const id = qualify_engine_label(instance);
+    CLHEPengineJumper<Engine> jumper{engine};
+    registerEngineIdAndSeeder(id, jumper);
+    watchEngineState(engine, instance);
+    seeds.registerJumper(id, jumper.jumper());
+    auto const [seedValue, frozen] = extractSeed(id, seed);
+    jumper(id, seedValue);
+    mf::LogInfo("NuRandomService")
+      << "Seeding " << type << " engine \"" << id.artName()
+      << "\" with seed " << seedValue << " (jump-ahead capable).";
+    if (frozen) freezeSeed(id, seedValue);
+    return engine;
+  } // NuRandomService::registerAndSeedJumpingEngine()
+
+
+  inline auto NuRandomService::registerAndSeedMultiWordEngine(
+    engine_t& engine, std::size_t nWords,
+    std::string type, std::string instance,
+    std::optional<seed_t> const seed
+  ) -> engine_t&
+  {
+    std::lock_guard const lock{ serviceMutex };
+    EngineId const id = qualify_engine_label(instance);
+    CLHEPengineMultiSeeder seeder{engine, nWords};
+    registerEngineIdAndSeeder(id, seeder);
+    watchEngineState(engine, instance);
+    seeds.registerMultiSeeder(id, seeder, nWords);
+    auto const [seedValue, frozen] = extractSeed(id, seed);
+    if (frozen) {
+      seeder(id, seedValue);
+      freezeSeed(id, seedValue);
+    }
+    else seedEngine(id);
+    mf::LogInfo("NuRandomService")
+      << "Seeding " << type << " engine \"" << id.artName()
+      << "\" with seed " << seedValue << " (" << nWords << " words).";
+    return engine;
+  } // NuRandomService::registerAndSeedMultiWordEngine()
+
+
+  inline auto NuRandomService::registerAndSeedEngines
+    (std::vector<EngineAndInstance_t> const& engines, std::string type)
+    -> std::vector<seed_t>
+  {
+    if (engines.empty()) return {};
+
+    std::lock_guard const lock{ serviceMutex };
+    std::vector<SeedMaster_t::SeederRegistration_t> batch;
+    batch.reserve(engines.size());
+    for (auto const& [ engine, instance ]: engines) {
+      batch.emplace_back(
+        qualify_engine_label(instance),
+        CLHEPengineSeeder{ engine.get(), engineStateCache.get() }
+        );
+    }
+
+    // all engines belong to the same module, hence are all global or not
+    ensureValidState(batch.front().first.isGlobal());
+
+    std::vector<seed_t> const seedValues = seeds.registerNewSeeders(batch);
+    for (auto const& [ engine, instance ]: engines)
+      watchEngineState(engine.get(), instance);
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      auto const& [ id, seeder ] = batch[i];
+      seeder(id, seedValues[i]);
+      MF_LOG_DEBUG("NuRandomService")
+        << "Seeding " << type << " engine \"" << id.artName()
+        << "\" with seed " << seedValues[i] << ".";
+    } // for
+    mf::LogInfo("NuRandomService")
+      << "Seeded " << batch.size() << " " << type << " engines of module '"
+      << batch.front().first.moduleLabel << "'.";
+    return seedValues;
+  } // NuRandomService::registerAndSeedEngines()
+
+
+  inline auto NuRandomService::registerAndSeedEngineHandle(
+    engine_t& engine, std::string type, std::string instance,
+    std::optional<seed_t> const seed
+  ) -> EngineHandle
+  {
+    std::lock_guard const lock{ serviceMutex };
+    registerAndSeedEngine(engine, std::move(type), instance, seed);
+    return engineHandle(std::move(instance));
+  } // NuRandomService::registerAndSeedEngineHandle()
+
+
 #endif // NURANDOM_RANDOMUTILS_NuRandomService_USECLHEP
 
 } // namespace rndm
 
-DECLARE_ART_SERVICE(rndm::NuRandomService, LEGACY)
+DECLARE_ART_SERVICE(rndm::NuRandomService, SHARED)
 
 #endif // NURANDOM_RANDOMUTILS_NuRandomService_H
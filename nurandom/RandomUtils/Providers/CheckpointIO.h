@@ -0,0 +1,101 @@
+/**
+ * @file   CheckpointIO.h
+ * @brief  Helpers to write and read the binary checkpoint of seed services
+ * @date   October 16th, 2026
+ * @see    SeedMaster.h
+ *
+ * The checkpoint is a plain sequence of native binary values: it is meant to
+ * be read back by the same build on the same platform, to restart a job.
+ * Strings are stored as their length followed by their characters.
+ */
+
+#ifndef NURANDOM_RANDOMUTILS_PROVIDERS_CHECKPOINTIO_H
+#define NURANDOM_RANDOMUTILS_PROVIDERS_CHECKPOINTIO_H 1
+
+// From art and its tool chain
+#include "canvas/Utilities/Exception.h"
+
+// C/C++ standard libraries
+#include <cstdint> // std::uint64_t
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits> // std::is_trivially_copyable<>
+
+
+namespace rndm {
+
+  namespace details {
+
+    // --- BEGIN Checkpoint I/O ------------------------------------------------
+
+    /// Tag at the beginning of each seed checkpoint
+    inline constexpr char CheckpointMagic[8]
+      = { 'N', 'u', 'R', 'n', 'd', 'C', 'k', 'p' };
+
+    /// Version of the seed checkpoint format
+    inline constexpr std::uint32_t CheckpointVersion = 2;
+
+    /// Oldest version of the seed checkpoint format which can still be read
+    /// (version 1 has no schedule of the engines)
+    inline constexpr std::uint32_t CheckpointOldestVersion = 1;
+
+    /// Flag of a frozen engine in the seed checkpoint
+    inline constexpr std::uint8_t CheckpointFrozen = 0x01;
+
+    /// Writes the binary representation of `value` into `out`
+    template <typename T>
+    void writeCheckpointValue(std::ostream& out, T const& value)
+      {
+        static_assert(std::is_trivially_copyable_v<T>,
+          "Only trivially copyable types can be written directly");
+        out.write(reinterpret_cast<char const*>(&value), sizeof(T));
+      }
+
+    /// Writes a string (length first) into `out`
+    inline void writeCheckpointString(std::ostream& out, std::string const& s)
+      {
+        writeCheckpointValue(out, static_cast<std::uint64_t>(s.size()));
+        out.write(s.data(), s.size());
+      }
+
+    /**
+     * @brief Reads a value written by `writeCheckpointValue()`
+     * @throw art::Exception (art::errors::FileReadError) on read failure
+     */
+    template <typename T>
+    T readCheckpointValue(std::istream& in)
+      {
+        static_assert(std::is_trivially_copyable_v<T>,
+          "Only trivially copyable types can be read directly");
+        T value;
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+          throw art::Exception(art::errors::FileReadError)
+            << "Seed checkpoint is truncated or corrupted\n";
+        }
+        return value;
+      }
+
+    /**
+     * @brief Reads a string written by `writeCheckpointString()`
+     * @throw art::Exception (art::errors::FileReadError) on read failure
+     */
+    inline std::string readCheckpointString(std::istream& in)
+      {
+        auto const size = readCheckpointValue<std::uint64_t>(in);
+        std::string s(size, '\0');
+        if ((size > 0) && !in.read(&s[0], size)) {
+          throw art::Exception(art::errors::FileReadError)
+            << "Seed checkpoint is truncated or corrupted\n";
+        }
+        return s;
+      }
+
+    // --- END Checkpoint I/O --------------------------------------------------
+
+  } // namespace details
+
+} // namespace rndm
+
+
+#endif // NURANDOM_RANDOMUTILS_PROVIDERS_CHECKPOINTIO_H
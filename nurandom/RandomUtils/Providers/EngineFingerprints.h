@@ -0,0 +1,495 @@
+/**
+ * @file EngineFingerprints.h
+ * @brief Compact per-event records of the state of random engines
+ * @date October 16th, 2026
+ * @see NuRandomService.h
+ *
+ * Two jobs which are expected to be identical may diverge, and the place
+ * where they do is usually far from where the difference becomes visible.
+ * The writer in this file records a 64-bit hash of the state of each engine
+ * after each module has processed each event; the reader and the comparison
+ * functions find the first record where two such files differ.
+ *
+ * The file is a plain sequence of native binary values: it is meant to be
+ * compared with files written on the same platform.
+ * * header: `FingerprintMagic`, version and size of a record (32-bit each);
+ * * records: a sequence of `FingerprintRecord_t`, all of the same size;
+ * * trailer: number of engines (32-bit), then the name of each engine (its
+ *   length as 32-bit number, then its characters), then the position of the
+ *   start of the trailer in the file (64-bit) and `FingerprintEndMagic`.
+ * A file without trailer (e.g. from a job which did not end) can still be
+ * read, but the names of its engines are not known.
+ */
+
+#ifndef NURANDOM_RANDOMUTILS_PROVIDERS_ENGINEFINGERPRINTS_H
+#define NURANDOM_RANDOMUTILS_PROVIDERS_ENGINEFINGERPRINTS_H 1
+
+// nurandom libraries
+#include "nurandom/RandomUtils/Providers/EngineId.h"
+#include "nurandom/RandomUtils/Providers/EventSeedInputData.h"
+
+// From art and its tool chain
+#include "canvas/Utilities/Exception.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min()
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t, std::uint32_t
+#include <cstring> // std::memcmp()
+#include <fstream>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <type_traits> // std::is_trivially_copyable<>
+#include <utility> // std::move()
+#include <vector>
+
+
+namespace rndm {
+
+  namespace details {
+
+    // --- BEGIN Fingerprint file format ---------------------------------------
+
+    /// Tag at the beginning of each fingerprint file
+    inline constexpr char FingerprintMagic[8]
+      = { 'N', 'u', 'R', 'n', 'd', 'F', 'p', 'r' };
+
+    /// Tag at the end of a complete fingerprint file
+    inline constexpr char FingerprintEndMagic[8]
+      = { 'N', 'u', 'R', 'n', 'd', 'F', 'p', 'E' };
+
+    /// Version of the fingerprint file format
+    inline constexpr std::uint32_t FingerprintVersion = 1;
+
+    /// Initial value of the FNV-1a 64-bit hash
+    inline constexpr std::uint64_t FNV1aOffset = 0xCBF29CE484222325ULL;
+
+    /// Adds the bytes of `value` to the FNV-1a 64-bit `hash`
+    constexpr std::uint64_t FNV1aAdd(std::uint64_t hash, std::uint64_t value)
+      {
+        for (unsigned int i = 0; i < 8; ++i) {
+          hash ^= (value >> (8 * i)) & 0xFFU;
+          hash *= 0x100000001B3ULL;
+        }
+        return hash;
+      }
+
+    /// Returns the hash of an engine state (e.g. `CLHEP` `put()`)
+    inline std::uint64_t hashEngineState
+      (std::vector<unsigned long> const& state)
+      {
+        std::uint64_t hash = FNV1aOffset;
+        for (unsigned long word: state) hash = FNV1aAdd(hash, word);
+        return hash;
+      }
+
+    /// The state of one engine after one module processed one event
+    struct FingerprintRecord_t {
+      std::uint32_t run = 0;
+      std::uint32_t subRun = 0;
+      std::uint32_t event = 0;
+      std::uint32_t engine = 0; ///< Index of the engine in the file.
+      std::uint64_t hash = 0; ///< Hash of the engine state.
+      /// Hash of this and all the previous records in the file.
+      std::uint64_t chain = 0;
+
+      /// Returns whether the two records have the same content.
+      bool sameAs(FingerprintRecord_t const& other) const
+        {
+          return (run == other.run) && (subRun == other.subRun)
+            && (event == other.event) && (engine == other.engine)
+            && (hash == other.hash);
+        }
+    }; // FingerprintRecord_t
+
+    static_assert(sizeof(FingerprintRecord_t) == 32);
+    static_assert(std::is_trivially_copyable_v<FingerprintRecord_t>);
+
+    /// Returns the chain hash after `record`, given the one before it.
+    constexpr std::uint64_t chainFingerprint
+      (std::uint64_t chain, FingerprintRecord_t const& record)
+      {
+        chain = FNV1aAdd(chain, (std::uint64_t(record.run) << 32) | record.subRun);
+        chain = FNV1aAdd(chain, (std::uint64_t(record.event) << 32) | record.engine);
+        return FNV1aAdd(chain, record.hash);
+      }
+
+    // --- END Fingerprint file format -----------------------------------------
+
+  } // namespace details
+
+
+  namespace NuRandomServiceHelper {
+
+    /**
+     * @brief Writes the hashes of engine states into a fingerprint file.
+     *
+     * Engines are made known with `watch()`, together with a function
+     * returning their state. Each call to `record()` then appends to the file
+     * a record with the hash of the current state of that engine and the
+     * identifier of the event.
+     * Each record is 32 bytes long; `close()` (or the destruction of the
+     * object) completes the file with the names of the engines.
+     */
+    class EngineFingerprintWriter {
+        public:
+      using State_t = std::vector<unsigned long>; ///< State of an engine.
+      using StateSource_t = std::function<State_t()>; ///< Returns a state.
+      using Record_t = details::FingerprintRecord_t;
+
+      /**
+       * @brief Constructor: opens the file and writes its header
+       * @throw art::Exception (art::errors::FileOpenError) on failure
+       */
+      explicit EngineFingerprintWriter(std::string path);
+
+      /// Destructor: completes the file, if not done yet.
+      ~EngineFingerprintWriter() { close(); }
+
+      /// Adds an engine; engines already watched are not changed.
+      void watch(SeedMasterHelper::EngineId const& id, StateSource_t source);
+
+      /// Returns whether the specified engine is watched.
+      bool isWatched(SeedMasterHelper::EngineId const& id) const
+        { return fEngines.count(id) > 0; }
+
+      /// Writes a record of the state of the engine, if watched.
+      void record
+        (SeedMasterHelper::EngineId const& id, EventSeedInputData const& event);
+
+      /// Writes the trailer and closes the file.
+      void close();
+
+      /// Returns the path of the file.
+      std::string const& path() const { return fPath; }
+
+      /// Returns the number of records written.
+      std::size_t nRecords() const { return fNRecords; }
+
+      /// Returns the number of watched engines.
+      std::size_t nEngines() const { return fEngineNames.size(); }
+
+        private:
+      struct Watched_t {
+        std::uint32_t index; ///< Index of the engine in the file.
+        StateSource_t source; ///< Function returning the state of the engine.
+      }; // Watched_t
+
+      std::string fPath; ///< Path of the file.
+      std::ofstream fOut; ///< The file being written.
+
+      std::map<SeedMasterHelper::EngineId, Watched_t> fEngines;
+      std::vector<std::string> fEngineNames; ///< Names, by index.
+
+      std::uint64_t fChain = details::FNV1aOffset; ///< Chain of the records.
+      std::size_t fNRecords = 0; ///< Records written so far.
+
+      template <typename T>
+      void write(T const& value)
+        { fOut.write(reinterpret_cast<char const*>(&value), sizeof(T)); }
+
+    }; // class EngineFingerprintWriter
+
+
+    /**
+     * @brief Reads a fingerprint file, one record at a time.
+     *
+     * Records are read on demand from their position in the file, so that
+     * they can be visited in any order (as a bisection does).
+     */
+    class EngineFingerprintReader {
+        public:
+      using Record_t = details::FingerprintRecord_t;
+
+      /**
+       * @brief Constructor: opens the file and reads its header and trailer
+       * @throw art::Exception (art::errors::FileOpenError) if can't be opened
+       * @throw art::Exception (art::errors::FileReadError) if not valid
+       */
+      explicit EngineFingerprintReader(std::string path);
+
+      /// Returns the path of the file.
+      std::string const& path() const { return fPath; }
+
+      /// Returns the number of records in the file.
+      std::size_t nRecords() const { return fNRecords; }
+
+      /// Returns whether the file has a trailer (with the engine names).
+      bool isComplete() const { return fComplete; }
+
+      /// Returns the name of the engine with the specified index.
+      std::string engineName(std::uint32_t index) const;
+
+      /**
+       * @brief Returns the record with the specified index
+       * @throw art::Exception (art::errors::FileReadError) on read failure
+       */
+      Record_t record(std::size_t index);
+
+        private:
+      std::string fPath; ///< Path of the file.
+      std::ifstream fIn; ///< The file being read.
+      std::size_t fNRecords = 0; ///< Number of records.
+      bool fComplete = false; ///< Whether the trailer is present.
+      std::vector<std::string> fEngineNames; ///< Names, by index.
+
+      /// Position of the first record in the file.
+      static constexpr std::streamoff RecordsStart
+        = sizeof(details::FingerprintMagic) + 2 * sizeof(std::uint32_t);
+
+      template <typename T>
+      T read();
+
+    }; // class EngineFingerprintReader
+
+
+    /// The first difference between two fingerprint files.
+    struct FingerprintDivergence_t {
+      std::size_t index = 0; ///< Index of the first different record.
+      /// The record in the first file (none if the file is shorter).
+      std::optional<details::FingerprintRecord_t> first;
+      /// The record in the second file (none if the file is shorter).
+      std::optional<details::FingerprintRecord_t> second;
+    }; // FingerprintDivergence_t
+
+    /**
+     * @brief Finds the first different record, reading the files in order.
+     * @return the first difference, none if the files are equivalent
+     *
+     * The engines are compared by index: the two jobs are expected to
+     * register the same engines in the same order.
+     */
+    std::optional<FingerprintDivergence_t> findFirstDivergence
+      (EngineFingerprintReader& first, EngineFingerprintReader& second);
+
+    /**
+     * @brief Finds the first different record by bisection.
+     * @return the first difference, none if the files are equivalent
+     *
+     * Each record holds the hash of the whole sequence of records up to it.
+     * Once two files diverge, their chain hashes stay different; so the first
+     * difference is found reading a logarithmic number of records.
+     * The result is the same as `findFirstDivergence()` unless hashes collide.
+     */
+    std::optional<FingerprintDivergence_t> bisectFirstDivergence
+      (EngineFingerprintReader& first, EngineFingerprintReader& second);
+
+  } // namespace NuRandomServiceHelper
+
+} // namespace rndm
+
+
+//==============================================================================
+//===  Inline implementation
+//===
+inline rndm::NuRandomServiceHelper::EngineFingerprintWriter::EngineFingerprintWriter
+  (std::string path)
+  : fPath(std::move(path))
+  , fOut(fPath, std::ios::binary | std::ios::trunc)
+{
+  if (!fOut) {
+    throw art::Exception(art::errors::FileOpenError)
+      << "Can't write engine fingerprints into '" << fPath << "'\n";
+  }
+  fOut.write(details::FingerprintMagic, sizeof(details::FingerprintMagic));
+  write(details::FingerprintVersion);
+  write(static_cast<std::uint32_t>(sizeof(Record_t)));
+} // EngineFingerprintWriter::EngineFingerprintWriter()
+
+
+inline void rndm::NuRandomServiceHelper::EngineFingerprintWriter::watch
+  (SeedMasterHelper::EngineId const& id, StateSource_t source)
+{
+  if (isWatched(id)) return;
+  auto const index = static_cast<std::uint32_t>(fEngineNames.size());
+  fEngines.emplace(id, Watched_t{ index, std::move(source) });
+  fEngineNames.push_back(std::string(id));
+} // EngineFingerprintWriter::watch()
+
+
+inline void rndm::NuRandomServiceHelper::EngineFingerprintWriter::record
+  (SeedMasterHelper::EngineId const& id, EventSeedInputData const& event)
+{
+  if (!fOut.is_open()) return;
+  auto const iEngine = fEngines.find(id);
+  if (iEngine == fEngines.end()) return;
+
+  Record_t record;
+  record.run = event.runNumber;
+  record.subRun = event.subRunNumber;
+  record.event = event.eventNumber;
+  record.engine = iEngine->second.index;
+  record.hash = details::hashEngineState(iEngine->second.source());
+  record.chain = fChain = details::chainFingerprint(fChain, record);
+  write(record);
+  ++fNRecords;
+} // EngineFingerprintWriter::record()
+
+
+inline void rndm::NuRandomServiceHelper::EngineFingerprintWriter::close() {
+  if (!fOut.is_open()) return;
+  std::uint64_t const trailerStart = fOut.tellp();
+  write(static_cast<std::uint32_t>(fEngineNames.size()));
+  for (std::string const& name: fEngineNames) {
+    write(static_cast<std::uint32_t>(name.size()));
+    fOut.write(name.data(), name.size());
+  }
+  write(trailerStart);
+  fOut.write(details::FingerprintEndMagic, sizeof(details::FingerprintEndMagic));
+  fOut.close();
+} // EngineFingerprintWriter::close()
+
+
+//------------------------------------------------------------------------------
+inline rndm::NuRandomServiceHelper::EngineFingerprintReader::EngineFingerprintReader
+  (std::string path)
+  : fPath(std::move(path))
+  , fIn(fPath, std::ios::binary)
+{
+  if (!fIn) {
+    throw art::Exception(art::errors::FileOpenError)
+      << "Can't read engine fingerprints from '" << fPath << "'\n";
+  }
+
+  char magic[sizeof(details::FingerprintMagic)];
+  if (!fIn.read(magic, sizeof(magic))
+    || std::memcmp(magic, details::FingerprintMagic, sizeof(magic)))
+  {
+    throw art::Exception(art::errors::FileReadError)
+      << "'" << fPath << "' is not an engine fingerprint file\n";
+  }
+  auto const version = read<std::uint32_t>();
+  auto const recordSize = read<std::uint32_t>();
+  if ((version != details::FingerprintVersion)
+    || (recordSize != sizeof(Record_t)))
+  {
+    throw art::Exception(art::errors::FileReadError)
+      << "Engine fingerprint file '" << fPath << "' has version " << version
+      << " and records of " << recordSize << " bytes; only version "
+      << details::FingerprintVersion << " with records of "
+      << sizeof(Record_t) << " bytes is supported\n";
+  }
+
+  fIn.seekg(0, std::ios::end);
+  std::streamoff const fileSize = fIn.tellg();
+  std::streamoff recordsEnd = fileSize;
+
+  // look for the trailer
+  std::streamoff const tailSize
+    = sizeof(std::uint64_t) + sizeof(details::FingerprintEndMagic);
+  if (fileSize >= RecordsStart + tailSize) {
+    fIn.seekg(fileSize - tailSize);
+    auto const trailerStart = static_cast<std::streamoff>(read<std::uint64_t>());
+    fIn.read(magic, sizeof(magic));
+    if (fIn && !std::memcmp(magic, details::FingerprintEndMagic, sizeof(magic))
+      && (trailerStart >= RecordsStart) && (trailerStart < fileSize))
+    {
+      fIn.seekg(trailerStart);
+      auto const nEngines = read<std::uint32_t>();
+      for (std::uint32_t i = 0; i < nEngines; ++i) {
+        std::string name(read<std::uint32_t>(), '\0');
+        if (!name.empty() && !fIn.read(&name[0], name.size())) {
+          throw art::Exception(art::errors::FileReadError)
+            << "Engine fingerprint file '" << fPath << "' is corrupted\n";
+        }
+        fEngineNames.push_back(std::move(name));
+      }
+      recordsEnd = trailerStart;
+      fComplete = true;
+    }
+  } // if trailer
+
+  fNRecords = (recordsEnd - RecordsStart) / sizeof(Record_t);
+} // EngineFingerprintReader::EngineFingerprintReader()
+
+
+inline std::string
+rndm::NuRandomServiceHelper::EngineFingerprintReader::engineName
+  (std::uint32_t index) const
+{
+  return (index < fEngineNames.size())
+    ? fEngineNames[index]: "#" + std::to_string(index);
+} // EngineFingerprintReader::engineName()
+
+
+inline auto rndm::NuRandomServiceHelper::EngineFingerprintReader::record
+  (std::size_t index) -> Record_t
+{
+  fIn.clear();
+  fIn.seekg(RecordsStart + static_cast<std::streamoff>(index * sizeof(Record_t)));
+  return read<Record_t>();
+} // EngineFingerprintReader::record()
+
+
+template <typename T>
+T rndm::NuRandomServiceHelper::EngineFingerprintReader::read() {
+  T value;
+  if (!fIn.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+    throw art::Exception(art::errors::FileReadError)
+      << "Engine fingerprint file '" << fPath << "' is truncated\n";
+  }
+  return value;
+} // EngineFingerprintReader::read()
+
+
+//------------------------------------------------------------------------------
+namespace rndm::details {
+
+  /// Returns the difference of two files equal up to the end of the shorter.
+  inline std::optional<NuRandomServiceHelper::FingerprintDivergence_t>
+  lengthDivergence(
+    NuRandomServiceHelper::EngineFingerprintReader& first,
+    NuRandomServiceHelper::EngineFingerprintReader& second
+  ) {
+    std::size_t const nCommon = std::min(first.nRecords(), second.nRecords());
+    if (first.nRecords() == second.nRecords()) return std::nullopt;
+
+    NuRandomServiceHelper::FingerprintDivergence_t divergence;
+    divergence.index = nCommon;
+    if (nCommon < first.nRecords()) divergence.first = first.record(nCommon);
+    else                            divergence.second = second.record(nCommon);
+    return divergence;
+  } // lengthDivergence()
+
+} // namespace rndm::details
+
+
+inline auto rndm::NuRandomServiceHelper::findFirstDivergence
+  (EngineFingerprintReader& first, EngineFingerprintReader& second)
+  -> std::optional<FingerprintDivergence_t>
+{
+  std::size_t const nCommon = std::min(first.nRecords(), second.nRecords());
+  for (std::size_t i = 0; i < nCommon; ++i) {
+    auto const a = first.record(i), b = second.record(i);
+    if (!a.sameAs(b)) return FingerprintDivergence_t{ i, a, b };
+  }
+  return details::lengthDivergence(first, second);
+} // rndm::NuRandomServiceHelper::findFirstDivergence()
+
+
+inline auto rndm::NuRandomServiceHelper::bisectFirstDivergence
+  (EngineFingerprintReader& first, EngineFingerprintReader& second)
+  -> std::optional<FingerprintDivergence_t>
+{
+  std::size_t const nCommon = std::min(first.nRecords(), second.nRecords());
+
+  // find the first record in [ begin, end [ with different chain hash
+  std::size_t begin = 0, end = nCommon;
+  while (begin < end) {
+    std::size_t const middle = begin + (end - begin) / 2;
+    if (first.record(middle).chain == second.record(middle).chain)
+      begin = middle + 1;
+    else end = middle;
+  } // while
+
+  if (begin < nCommon)
+    return FingerprintDivergence_t{ begin, first.record(begin), second.record(begin) };
+  return details::lengthDivergence(first, second);
+} // rndm::NuRandomServiceHelper::bisectFirstDivergence()
+
+
+//------------------------------------------------------------------------------
+
+#endif // NURANDOM_RANDOMUTILS_PROVIDERS_ENGINEFINGERPRINTS_H
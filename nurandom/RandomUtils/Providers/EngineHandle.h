@@ -0,0 +1,70 @@
+/**
+ * @file EngineHandle.h
+ * @brief A compact handle to a registered random engine
+ * @date October 16th, 2026
+ * @see SeedMaster.h EngineId.h
+ *
+ * The handle is a dense index assigned by `rndm::SeedMaster` to a registered
+ * engine. It is cheap to copy and to store, and queries through it do not
+ * need to build an `EngineId` nor to look it up.
+ */
+
+#ifndef NURANDOM_RANDOMUTILS_PROVIDERS_ENGINEHANDLE_H
+#define NURANDOM_RANDOMUTILS_PROVIDERS_ENGINEHANDLE_H 1
+
+#include <cstdint> // std::uint32_t
+#include <limits>
+#include <ostream>
+
+namespace rndm {
+
+  namespace SeedMasterHelper {
+
+    /// Handle of a registered engine (index in the engine table of SeedMaster)
+    class EngineHandle {
+        public:
+      using index_t = std::uint32_t; ///< type of the index
+
+      /// Value of the index of an invalid handle
+      static constexpr index_t InvalidIndex = std::numeric_limits<index_t>::max();
+
+      /// Default constructor: an invalid handle
+      constexpr EngineHandle() = default;
+
+      /// Constructor: handle with the specified index
+      constexpr explicit EngineHandle(index_t index): fIndex(index) {}
+
+      /// Returns the index of the engine
+      constexpr index_t index() const { return fIndex; }
+
+      /// Returns whether the handle refers to any engine
+      constexpr bool isValid() const { return fIndex != InvalidIndex; }
+
+      /// Returns whether the handle refers to any engine
+      constexpr explicit operator bool() const { return isValid(); }
+
+      constexpr bool operator== (EngineHandle const& rhs) const
+        { return fIndex == rhs.fIndex; }
+      constexpr bool operator!= (EngineHandle const& rhs) const
+        { return fIndex != rhs.fIndex; }
+
+        private:
+      index_t fIndex = InvalidIndex; ///< index of the engine
+
+    }; // class EngineHandle
+
+
+    inline std::ostream& operator<<
+      (std::ostream& out, EngineHandle const& handle)
+    {
+      if (handle) out << "#" << handle.index();
+      else        out << "<invalid>";
+      return out;
+    } // operator<< (EngineHandle)
+
+  } // namespace SeedMasterHelper
+
+} // namespace rndm
+
+
+#endif // NURANDOM_RANDOMUTILS_PROVIDERS_ENGINEHANDLE_H
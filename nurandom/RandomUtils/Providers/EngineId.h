@@ -4,7 +4,8 @@
  * @author Rob Kutschke (kutschke@fnal.gov)
  * 
  * An identifier may consist of simply a module label or a module label plus an
- * instance name.
+ * instance name. Engines of replicated modules also carry the number of the
+ * schedule of their module replica.
  */
 
 #ifndef NURANDOM_RANDOMUTILS_PROVIDERS_ENGINEID_H
@@ -12,13 +13,25 @@
 
 #include <string>
 #include <ostream>
+#include <tuple> // std::tie()
 
 namespace rndm {
 
   /// Namespace for implementation details of SeedMaster
   namespace SeedMasterHelper {
     
-    /// Identifier for a engine, made of module name and optional instance name
+    /// Type of the number of an art schedule.
+    using ScheduleNumber_t = unsigned int;
+    
+    /**
+     * @brief Identifier for a engine, made of module name and optional instance name
+     *
+     * Replicated modules have one instance per schedule, all with the same
+     * label; their engines are distinguished by the schedule number.
+     * Engines of modules which are not replicated, as well as the engines of
+     * the replica on the first schedule, have schedule number `0`, so that
+     * they are identified exactly as in a job with a single schedule.
+     */
     struct EngineId {
       
       /// structure to identify a "global" flavour constructor
@@ -28,9 +41,13 @@ namespace rndm {
       static constexpr Global_t global{};
       
       /// Constructor (module name is required)
-      EngineId(std::string const& mod, std::string const& inst = std::string()):
+      EngineId(
+        std::string const& mod, std::string const& inst = std::string(),
+        ScheduleNumber_t sched = 0
+        ):
         moduleLabel(mod),
-        instanceName(inst)
+        instanceName(inst),
+        schedule(sched)
         {}
       
       /// Constructor (module name is required)
@@ -47,42 +64,51 @@ namespace rndm {
       /// Returns whether the instance label is defined
       bool hasInstanceName() const { return !instanceName.empty(); }
       
+      /// Returns whether this is the engine of a replica on a schedule but the first
+      bool isReplica() const { return schedule != 0; }
+      
       /// Sets this ID to the specified global instance
       void setGlobal(std::string inst)
         { moduleLabel.clear(); instanceName = inst; }
       
       
-      /// Returns true if both module and instance names match
+      /// Returns true if module and instance names and schedule match
       bool operator== (EngineId const& rhs) const
         {
           if ( moduleLabel  != rhs.moduleLabel  ) return false;
           if ( instanceName != rhs.instanceName ) return false;
+          if ( schedule     != rhs.schedule     ) return false;
           return true;
         } // operator== ()
       
-      /// Lexicographic sort (module name first, then instance name)
+      /// Lexicographic sort (module name first, then instance name, schedule)
       bool operator< (EngineId const& rhs) const
         {
-          if (moduleLabel  < rhs.moduleLabel) return true;
-          if (moduleLabel == rhs.moduleLabel) {
-            if (instanceName < rhs.instanceName) return true;
-          }
-          return false;
+          return std::tie(moduleLabel, instanceName, schedule)
+            < std::tie(rhs.moduleLabel, rhs.instanceName, rhs.schedule);
         } // operator< ()
       
-      /// Converts the information in a module_name[.instance_name] string
+      /// Converts the information in a module_name[.instance_name][[schedule]] string
       operator std::string() const
         {
           std::string id = moduleLabel;
           if (hasInstanceName()) id.append(1, '.').append(instanceName);
+          if (isReplica())
+            id.append(1, '[').append(std::to_string(schedule)).append(1, ']');
           return id;
         } // operator std::string()
       
       /// Converts the information in a module_name:instance_name string
-      std::string artName() const { return moduleLabel + ':' + instanceName; }
+      std::string artName() const
+        {
+          std::string name = moduleLabel + ':' + instanceName;
+          if (isReplica()) name += " (schedule " + std::to_string(schedule) + ")";
+          return name;
+        } // artName()
       
       std::string moduleLabel; ///< module label
       std::string instanceName; ///< instance name
+      ScheduleNumber_t schedule = 0; ///< schedule of the module replica
       
     }; // end class EngineId
     
@@ -24,6 +24,7 @@ namespace rndm {
       using SubRunNumber_t = std::uint32_t;
       using EventNumber_t  = std::uint32_t;
       using TimeValue_t    = std::uint64_t;
+      using ScheduleNumber_t = unsigned int;
       
       /// @{
       /// @name Public data members
@@ -40,6 +41,9 @@ namespace rndm {
       std::string moduleLabel;      ///< label of the running module instance
       
       bool isTimeValid;             ///< whether timestamp is valid
+      
+      /// schedule processing the event (never used to compute seeds)
+      ScheduleNumber_t schedule = 0;
       /// @}
       
       
@@ -55,6 +59,7 @@ namespace rndm {
           moduleType.clear();
           moduleLabel.clear();
           isTimeValid = false;
+          schedule = 0;
         } // clear()
       
     }; // class EventSeedInputData
@@ -0,0 +1,57 @@
+/**
+ * @file   JSONstring.h
+ * @brief  Writes strings as JSON string literals
+ * @date   October 16th, 2026
+ * @see    SeedMaster.h
+ *
+ * Used by the seed manifest of `rndm::SeedMaster` and by the benchmark
+ * programs writing their results in JSON format.
+ */
+
+#ifndef NURANDOM_RANDOMUTILS_PROVIDERS_JSONSTRING_H
+#define NURANDOM_RANDOMUTILS_PROVIDERS_JSONSTRING_H 1
+
+// C/C++ standard libraries
+#include <iomanip> // std::setw(), std::setfill()
+#include <ostream>
+#include <string>
+
+
+namespace rndm {
+
+  namespace details {
+
+    /**
+     * @brief Writes `s` into `out` as a JSON string literal, quotes included
+     * @param out the stream to write into
+     * @param s the string to be written
+     *
+     * Quotes and backslashes are escaped, and control characters are written
+     * as escape sequences.
+     */
+    inline void printJSONstring(std::ostream& out, std::string const& s)
+      {
+        out << '"';
+        for (char c: s) {
+          switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n";  break;
+            case '\t': out << "\\t";  break;
+            default:
+              if (static_cast<unsigned char>(c) < 0x20) {
+                out << "\\u" << std::hex << std::setfill('0') << std::setw(4)
+                  << static_cast<int>(c) << std::dec << std::setfill(' ');
+              }
+              else out << c;
+          } // switch
+        } // for
+        out << '"';
+      } // printJSONstring()
+
+  } // namespace details
+
+} // namespace rndm
+
+
+#endif // NURANDOM_RANDOMUTILS_PROVIDERS_JSONSTRING_H
@@ -0,0 +1,229 @@
+/**
+ * @file   nurandom/RandomUtils/Providers/JobSlotLease.cxx
+ * @brief  Lease of a job slot from a lock-protected file shared by local jobs.
+ * @date   October 16th, 2026
+ * @see    nurandom/RandomUtils/Providers/JobSlotLease.h
+ */
+
+// library header
+#include "nurandom/RandomUtils/Providers/JobSlotLease.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// POSIX
+#include <fcntl.h> // open()
+#include <signal.h> // kill()
+#include <sys/file.h> // flock()
+#include <unistd.h> // close(), getpid(), gethostname(), ...
+
+// C/C++ standard libraries
+#include <cerrno>
+#include <cstring> // std::strerror()
+#include <ctime> // std::time()
+#include <sstream>
+#include <string>
+#include <utility> // std::move()
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// A lease record, as stored in the lease file.
+  struct LeaseRecord_t {
+    unsigned int slot;
+    std::string host;
+    long pid;
+    long long expiration; ///< seconds since the epoch (`0`: never expires)
+  }; // LeaseRecord_t
+
+
+  /// Returns the name of this host.
+  std::string thisHost() {
+    char name[256] = { '\0' };
+    if (::gethostname(name, sizeof(name) - 1) != 0) return "localhost";
+    return name;
+  } // thisHost()
+
+
+  /// Returns whether a process with the specified ID exists on this host.
+  bool processExists(long pid) {
+    if (pid <= 0) return false;
+    return (::kill(static_cast<pid_t>(pid), 0) == 0) || (errno == EPERM);
+  } // processExists()
+
+
+  /// Exception for a failed system call on the lease file.
+  cet::exception leaseFileError
+    (std::string const& what, std::string const& path)
+  {
+    int const err = errno;
+    return cet::exception("JobSlotLease")
+      << "Failed to " << what << " lease file '" << path << "': "
+      << std::strerror(err) << " (errno=" << err << ")\n";
+  } // leaseFileError()
+
+
+  /// Keeps a file open and exclusively locked for the lifetime of the object.
+  class LockedFile {
+      public:
+    LockedFile(std::string const& path): fPath(path)
+      {
+        fFD = ::open(fPath.c_str(), O_RDWR | O_CREAT, 0664);
+        if (fFD < 0) throw leaseFileError("open", fPath);
+        int res;
+        while (((res = ::flock(fFD, LOCK_EX)) != 0) && (errno == EINTR));
+        if (res != 0) {
+          auto e = leaseFileError("lock", fPath);
+          ::close(fFD);
+          throw e;
+        }
+      }
+
+    LockedFile(LockedFile const&) = delete;
+    LockedFile& operator= (LockedFile const&) = delete;
+
+    ~LockedFile() { ::flock(fFD, LOCK_UN); ::close(fFD); }
+
+    /// Reads all the records in the file (ignoring malformed lines).
+    std::vector<LeaseRecord_t> read() const
+      {
+        std::string content;
+        char buffer[4096];
+        if (::lseek(fFD, 0, SEEK_SET) < 0) throw leaseFileError("read", fPath);
+        while (true) {
+          ssize_t const n = ::read(fFD, buffer, sizeof(buffer));
+          if (n == 0) break;
+          if (n < 0) {
+            if (errno == EINTR) continue;
+            throw leaseFileError("read", fPath);
+          }
+          content.append(buffer, n);
+        } // while
+
+        std::vector<LeaseRecord_t> records;
+        std::istringstream sstr(content);
+        std::string line;
+        while (std::getline(sstr, line)) {
+          std::istringstream lstr(line);
+          LeaseRecord_t record;
+          if (lstr >> record.slot >> record.host >> record.pid >> record.expiration)
+            records.push_back(std::move(record));
+        } // while
+        return records;
+      } // read()
+
+    /// Replaces the content of the file with the specified records.
+    void write(std::vector<LeaseRecord_t> const& records) const
+      {
+        std::ostringstream sstr;
+        for (LeaseRecord_t const& record: records) {
+          sstr << record.slot << ' ' << record.host << ' ' << record.pid
+            << ' ' << record.expiration << '\n';
+        }
+        std::string const content = sstr.str();
+        if (::ftruncate(fFD, 0) != 0) throw leaseFileError("truncate", fPath);
+        if (::lseek(fFD, 0, SEEK_SET) < 0) throw leaseFileError("write", fPath);
+        std::size_t written = 0;
+        while (written < content.size()) {
+          ssize_t const n
+            = ::write(fFD, content.data() + written, content.size() - written);
+          if (n < 0) {
+            if (errno == EINTR) continue;
+            throw leaseFileError("write", fPath);
+          }
+          written += n;
+        } // while
+        ::fsync(fFD);
+      } // write()
+
+      private:
+    std::string fPath;
+    int fFD = -1;
+  }; // class LockedFile
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+rndm::details::JobSlotLease::JobSlotLease(
+  std::string leaseFile, unsigned int maxSlots, std::chrono::seconds timeout
+)
+  : fLeaseFile(std::move(leaseFile))
+  , fMaxSlots(maxSlots)
+  , fTimeout(timeout)
+{
+  if (fMaxSlots == 0) {
+    throw cet::exception("JobSlotLease")
+      << "No job slot available in lease file '" << fLeaseFile
+      << "' (zero slots requested)\n";
+  }
+
+  std::string const host = thisHost();
+  long const pid = static_cast<long>(::getpid());
+  long long const now = static_cast<long long>(std::time(nullptr));
+
+  LockedFile file(fLeaseFile);
+
+  // keep only the leases still valid, and mark their slots as taken
+  std::vector<LeaseRecord_t> leases;
+  std::vector<bool> taken(fMaxSlots, false);
+  for (LeaseRecord_t& record: file.read()) {
+    // on this host, the lease lasts as long as the process holding it;
+    // the expiration applies only to the leases from other hosts
+    if (record.host == host) {
+      if (!processExists(record.pid)) continue;
+    }
+    else if ((record.expiration != 0) && (record.expiration <= now)) continue;
+    if (record.slot < fMaxSlots) taken[record.slot] = true;
+    leases.push_back(std::move(record));
+  } // for
+
+  unsigned int slot = 0;
+  while ((slot < fMaxSlots) && taken[slot]) ++slot;
+  if (slot == fMaxSlots) {
+    throw cet::exception("JobSlotLease")
+      << "All " << fMaxSlots << " job slots in lease file '" << fLeaseFile
+      << "' are currently leased.\n";
+  }
+
+  long long const expiration
+    = (fTimeout.count() > 0)? now + fTimeout.count(): 0;
+  leases.push_back({ slot, host, pid, expiration });
+  file.write(leases);
+
+  fSlot = slot;
+  fHeld = true;
+} // rndm::details::JobSlotLease::JobSlotLease()
+
+
+// -----------------------------------------------------------------------------
+rndm::details::JobSlotLease::~JobSlotLease() {
+  try { release(); }
+  catch (...) {} // the lease will be reclaimed as stale anyway
+} // rndm::details::JobSlotLease::~JobSlotLease()
+
+
+// -----------------------------------------------------------------------------
+void rndm::details::JobSlotLease::release() {
+  if (!fHeld) return;
+  fHeld = false;
+
+  std::string const host = thisHost();
+  long const pid = static_cast<long>(::getpid());
+
+  LockedFile file(fLeaseFile);
+  std::vector<LeaseRecord_t> leases = file.read();
+  std::vector<LeaseRecord_t> kept;
+  kept.reserve(leases.size());
+  for (LeaseRecord_t& record: leases) {
+    if ((record.slot == fSlot) && (record.host == host) && (record.pid == pid))
+      continue;
+    kept.push_back(std::move(record));
+  } // for
+  file.write(kept);
+} // rndm::details::JobSlotLease::release()
+
+
+// -----------------------------------------------------------------------------
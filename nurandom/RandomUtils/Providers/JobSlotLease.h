@@ -0,0 +1,96 @@
+/**
+ * @file   nurandom/RandomUtils/Providers/JobSlotLease.h
+ * @brief  Lease of a job slot from a lock-protected file shared by local jobs.
+ * @date   October 16th, 2026
+ * @see    nurandom/RandomUtils/Providers/JobSlotLease.cxx
+ *
+ * Library: `nurandom::RandomUtils_Providers`
+ */
+
+#ifndef NURANDOM_RANDOMUTILS_PROVIDERS_JOBSLOTLEASE_H
+#define NURANDOM_RANDOMUTILS_PROVIDERS_JOBSLOTLEASE_H 1
+
+// C/C++ standard libraries
+#include <chrono>
+#include <string>
+
+
+namespace rndm::details {
+
+  /**
+   * @brief Holds the lease of a job slot, assigned by a shared lease file.
+   *
+   * Jobs started on the same node (or on a file system supporting `flock()`)
+   * can share a lease file to be assigned distinct job slots without any
+   * manual bookkeeping. On construction, the lease file is locked, its content
+   * is read, and the lowest slot not currently leased is taken and recorded
+   * in the file. The slot is released when the object is destroyed.
+   *
+   * Each line of the lease file records one lease:
+   *
+   *     <slot> <host> <process ID> <expiration time>
+   *
+   * where the expiration time is in seconds since the Unix epoch, `0` meaning
+   * no expiration. A lease is considered stale, and its slot free again, if:
+   * * it was taken on this same host, by a process which does not exist
+   *   any more (e.g. a job which crashed without releasing its slot); or
+   * * it was taken on another host, and it expired.
+   *
+   * A lease from this host is held as long as its process is alive, whatever
+   * its expiration time. Leases from other hosts can't be checked for
+   * liveness, and they are held until they expire: a timeout should be set
+   * when jobs from many hosts share the same file. The timeout must be longer
+   * than the jobs themselves.
+   */
+  class JobSlotLease {
+      public:
+
+    /**
+     * @brief Leases the first free slot in `[ 0, maxSlots [` from `leaseFile`.
+     * @param leaseFile path of the lease file (created if not present)
+     * @param maxSlots number of available slots
+     * @param timeout lease duration (`0` for no expiration)
+     * @throw cet::exception (category: `"JobSlotLease"`) if the lease file
+     *        can't be used, or if all slots are taken
+     */
+    JobSlotLease(
+      std::string leaseFile, unsigned int maxSlots,
+      std::chrono::seconds timeout = std::chrono::seconds{ 0 }
+      );
+
+    // a lease can't be shared
+    JobSlotLease(JobSlotLease const&) = delete;
+    JobSlotLease& operator= (JobSlotLease const&) = delete;
+
+    /// Releases the slot.
+    ~JobSlotLease();
+
+    /// Returns the leased slot.
+    unsigned int slot() const { return fSlot; }
+
+    /// Returns the path of the lease file.
+    std::string const& leaseFile() const { return fLeaseFile; }
+
+    /// Returns the number of slots managed by the lease file.
+    unsigned int maxSlots() const { return fMaxSlots; }
+
+    /// Returns the lease duration (`0` if the lease does not expire).
+    std::chrono::seconds timeout() const { return fTimeout; }
+
+    /// Releases the slot now; further calls have no effect.
+    void release();
+
+      private:
+    std::string fLeaseFile; ///< Path of the lease file.
+    unsigned int fMaxSlots; ///< Number of slots managed by the lease file.
+    std::chrono::seconds fTimeout; ///< Lease duration (`0`: no expiration).
+    unsigned int fSlot = 0; ///< Leased slot.
+    bool fHeld = false; ///< Whether the slot is still leased.
+
+  }; // class JobSlotLease
+
+
+} // namespace rndm::details
+
+
+#endif // NURANDOM_RANDOMUTILS_PROVIDERS_JOBSLOTLEASE_H
@@ -16,6 +16,8 @@
 #include <string>
 #include <memory> // std::unique_ptr<>
 #include <type_traits> // std::make_signed<>
+#include <optional>
+#include <limits>
 
 // From art and its tool chain
 #include "messagefacility/MessageLogger/MessageLogger.h"
@@ -73,6 +75,43 @@ namespace rndm {
      * ~~~~
      * sets up the `perEvent` policy, and uses a `preDefinedSeed` for the seeds
      * before the first event.
+     * 
+     * Jump-ahead mode
+     * ----------------
+     * 
+     * Reseeding an engine on each event may require a full initialization of
+     * its state. Engines which can efficiently skip ahead in their sequence
+     * can instead be seeded only once per job, and at each event set to the
+     * state they had after that seeding, advanced by a number of steps that
+     * depends on the event: `f(event) x stride`, where `f(event)` is the
+     * position of the event in the sequence
+     * `(run x maxSubRunsPerRun + subRun) x maxEventsPerSubRun + event`.
+     * This mode is enabled by setting `eventMode` to `"jumpAhead"`:
+     * ~~~~
+     *   NuRandomService: {
+     *     policy            : "perEvent"
+     *     eventMode         : "jumpAhead"
+     *     jumpAhead: {
+     *       stride             : 1000000000
+     *       maxRuns            :       1000
+     *       maxSubRunsPerRun   :       1000
+     *       maxEventsPerSubRun :      10000
+     *     }
+     *   }
+     * ~~~~
+     * The steps for the last event, `maxRuns x maxSubRunsPerRun x
+     * maxEventsPerSubRun x stride`, must fit in 64 bits: the configuration is
+     * rejected otherwise.
+     * The per-job seed of each jumping engine is a hash of the engine ID,
+     * unless an `initSeedPolicy` is specified, in which case that policy
+     * provides it.
+     * Only engines registered with a jumper (see
+     * `NuRandomService::registerAndSeedJumpingEngine()`) are advanced;
+     * all the others are still reseeded with per-event seeds as described
+     * above, and like in that case they have no per-job seed unless an
+     * `initSeedPolicy` provides one. The stride is the number of random numbers
+     * an engine can provide in a single event without overlapping with the
+     * sequence of the next one.
      */
     template <typename SEED>
     class PerEventPolicy: public RandomSeedPolicyBase<SEED> {
@@ -84,6 +123,12 @@ namespace rndm {
       /// type for contextual event information
       using EventData_t = NuRandomServiceHelper::EventSeedInputData;
       
+      /// type of the number of steps an engine is advanced for an event
+      using EventSkip_t = typename base_t::EventSkip_t;
+      
+      /// type of a seed made of multiple words
+      using SeedWords_t = typename base_t::SeedWords_t;
+      
       typedef enum {
         saEventTimestamp_v1,             ///< event timestamp algorithm (v1)
         NAlgos,                          ///< total number of seed algorithms
@@ -114,12 +159,33 @@ namespace rndm {
        *   to the event. This also defies the purpose of the policy, since after
        *   this, to reproduce the random sequences the additional knowledge of
        *   which offset was used is necessary.
+       * - *eventMode* (string, default: `"reseed"`): `"reseed"` to reseed the
+       *   engines on each event, `"jumpAhead"` to seed them once per job and
+       *   advance them on each event (see the documentation of the class)
+       * - *jumpAhead* (table): configuration of the `jumpAhead` mode:
+       *     - *stride* (integer, default: 2^23): steps reserved to each event
+       *     - *maxRuns* (integer, default: 100000): run numbers must be smaller
+       *       than this
+       *     - *maxSubRunsPerRun* (integer, default: 1000): subrun numbers
+       *       must be smaller than this
+       *     - *maxEventsPerSubRun* (integer, default: 10000): event numbers
+       *       must be smaller than this
+       * 
+       * The product of the four `jumpAhead` parameters must fit in 64 bits.
        */
       virtual void configure(fhicl::ParameterSet const& pset) override;
       
       /// Prints the details of the configuration of the random generator
       virtual void print(std::ostream& out) const override;
       
+      /// Saves the state of the policy for the initial seeds, if any
+      virtual void saveState(std::ostream& out) const override
+        { if (initSeedPolicy) initSeedPolicy->saveState(out); }
+      
+      /// Restores the state of the policy for the initial seeds, if any
+      virtual void restoreState(std::istream& in) override
+        { if (initSeedPolicy) initSeedPolicy->restoreState(in); }
+      
       
       /// Default algorithm version
       static constexpr const char* DefaultVersion = "v1";
@@ -136,6 +202,21 @@ namespace rndm {
       /// Converts event ID and timestamp information into a string
       static std::string UniqueEventString(EventData_t const& info);
       
+      /// Returns seed words from a 128-bit hash of the event information
+      virtual SeedWords_t getEventSeedWords(
+        SeedMasterHelper::EngineId const& id, EventData_t const& info,
+        seed_t seed, std::size_t nWords
+        ) const override;
+      
+      /// Returns the jump-ahead steps for the event (`jumpAhead` mode only)
+      virtual std::optional<EventSkip_t> getEventSkip
+        (SeedMasterHelper::EngineId const& id, EventData_t const& info)
+        const override;
+      
+      /// Per-job seed of an engine jumping ahead (`jumpAhead` mode only).
+      virtual seed_t getJumpingEngineSeed
+        (SeedMasterHelper::EngineId const& id) override;
+      
       
         private:
       
@@ -149,6 +230,21 @@ namespace rndm {
       /// Policy used for initialization before the event (none by default).
       PolicyStruct_t<seed_t> initSeedPolicy;
       
+      // --- BEGIN -- Jump-ahead mode ------------------------------------------
+      bool jumpAhead = false; ///< Whether jump-ahead mode is enabled.
+      EventSkip_t jumpStride = 0; ///< Steps reserved to each event.
+      EventSkip_t maxRuns = 0; ///< Run numbers are below this.
+      EventSkip_t maxSubRunsPerRun = 0; ///< Subrun numbers are below this.
+      EventSkip_t maxEventsPerSubRun = 0; ///< Event numbers are below this.
+      
+      /// Returns the position of the event in the jump-ahead sequence.
+      EventSkip_t eventPosition(EventData_t const& info) const;
+      
+      /// Returns `a x b + c`, throwing an exception on overflow.
+      static EventSkip_t multiplyAdd
+        (EventSkip_t a, EventSkip_t b, EventSkip_t c);
+      // --- END -- Jump-ahead mode --------------------------------------------
+      
       /// Per-job seed: pre-event seeds are returned (or invalid if none).
       virtual seed_t createSeed(SeedMasterHelper::EngineId const& id) override;
       
@@ -166,7 +262,7 @@ namespace rndm {
        */
       virtual seed_t createEventSeed
         (SeedMasterHelper::EngineId const& id, EventData_t const& info)
-        override;
+        const override;
       
       /// Renders a seed valid
       template <typename T>
@@ -176,6 +272,10 @@ namespace rndm {
       static seed_t EventTimestamp_v1
         (SeedMasterHelper::EngineId const& id, EventData_t const& info);
       
+      /// Returns the string hashed by the EventTimestamp_v1 algorithm
+      static std::string EventTimestamp_v1_string
+        (SeedMasterHelper::EngineId const& id, EventData_t const& info);
+      
       
       //@{
       /// Algorithm name (manual) handling
@@ -228,9 +328,8 @@ namespace rndm {
     
     
     template <typename SEED>
-    auto PerEventPolicy<SEED>::EventTimestamp_v1
+    std::string PerEventPolicy<SEED>::EventTimestamp_v1_string
       (SeedMasterHelper::EngineId const& id, EventData_t const& info)
-      -> seed_t
     {
       if (!info.isTimeValid) {
         throw art::Exception(art::errors::InvalidNumber)
@@ -242,6 +341,16 @@ namespace rndm {
         + " Module: " + id.moduleLabel;
       if (!id.instanceName.empty())
         s.append(" Instance: ").append(id.instanceName);
+      return s;
+    } // PerEventPolicy<SEED>::EventTimestamp_v1_string()
+    
+    
+    template <typename SEED>
+    auto PerEventPolicy<SEED>::EventTimestamp_v1
+      (SeedMasterHelper::EngineId const& id, EventData_t const& info)
+      -> seed_t
+    {
+      std::string const s = EventTimestamp_v1_string(id, info);
       seed_t seed = SeedFromHash(s);
       MF_LOG_DEBUG("PerEventPolicy") << "Seed from: '" << s << "': " << seed;
       return seed;
@@ -274,6 +383,53 @@ namespace rndm {
       
       // EventTimestamp_v1 does not require specific configuration
       
+      // event mode
+      std::string const eventMode
+        = pset.get<std::string>("eventMode", "reseed");
+      if (eventMode == "jumpAhead") jumpAhead = true;
+      else if (eventMode == "reseed") jumpAhead = false;
+      else {
+        throw art::Exception(art::errors::Configuration)
+          << "Unsupported per-event mode '" << eventMode
+          << "' (supported: 'reseed', 'jumpAhead')\n";
+      }
+      if (jumpAhead) {
+        auto const& jumpConfig
+          = pset.get<fhicl::ParameterSet>("jumpAhead", {});
+        jumpStride = jumpConfig.get<EventSkip_t>
+          ("stride", EventSkip_t(1) << 23);
+        maxRuns = jumpConfig.get<EventSkip_t>("maxRuns", 100000);
+        maxSubRunsPerRun = jumpConfig.get<EventSkip_t>
+          ("maxSubRunsPerRun", 1000);
+        maxEventsPerSubRun = jumpConfig.get<EventSkip_t>
+          ("maxEventsPerSubRun", 10000);
+        if ((jumpStride == 0) || (maxRuns == 0) || (maxSubRunsPerRun == 0)
+          || (maxEventsPerSubRun == 0))
+        {
+          throw art::Exception(art::errors::Configuration)
+            << "Per-event jump-ahead mode requires stride ("
+            << jumpStride << "), maxRuns (" << maxRuns
+            << "), maxSubRunsPerRun (" << maxSubRunsPerRun
+            << ") and maxEventsPerSubRun (" << maxEventsPerSubRun
+            << ") all to be positive\n";
+        }
+        // all the events in range must have steps which fit in EventSkip_t,
+        // so that eventPosition() and getEventSkip() need no further check
+        try {
+          multiplyAdd(multiplyAdd(multiplyAdd
+            (maxRuns, maxSubRunsPerRun, 0), maxEventsPerSubRun, 0),
+            jumpStride, 0
+            );
+        }
+        catch (art::Exception const&) {
+          throw art::Exception(art::errors::Configuration)
+            << "Per-event jump-ahead mode with stride " << jumpStride
+            << " can't reach " << maxRuns << " runs of " << maxSubRunsPerRun
+            << " subruns of " << maxEventsPerSubRun
+            << " events: the steps would overflow; reduce some of them\n";
+        }
+      } // if jump ahead
+      
       
       // set the pre-event algorithm
       auto const& initSeedConfig
@@ -302,6 +458,12 @@ namespace rndm {
         << "\n  algorithm version: " << algoNames[algo];
       if (offset != 0)
         out << "\n  constant offset:   " << offset;
+      if (jumpAhead) {
+        out << "\n  jump-ahead mode:   stride " << jumpStride
+          << ", up to " << maxRuns << " runs, " << maxSubRunsPerRun
+          << " subruns per run and " << maxEventsPerSubRun
+          << " events per subrun";
+      }
       if (initSeedPolicy) {
         out << "\n  special policy for random seeds before the event: '"
           << policyName(initSeedPolicy.policy)
@@ -316,13 +478,90 @@ namespace rndm {
     template <typename SEED>
     typename PerEventPolicy<SEED>::seed_t PerEventPolicy<SEED>::createSeed
       (SeedMasterHelper::EngineId const& id)
-    { return initSeedPolicy? initSeedPolicy->getSeed(id): base_t::InvalidSeed; }
+    {
+      if (initSeedPolicy) return initSeedPolicy->getSeed(id);
+      return base_t::InvalidSeed;
+    } // PerEventPolicy<SEED>::createSeed()
+    
+    
+    //--------------------------------------------------------------------------
+    template <typename SEED>
+    typename PerEventPolicy<SEED>::seed_t
+    PerEventPolicy<SEED>::getJumpingEngineSeed
+      (SeedMasterHelper::EngineId const& id)
+    {
+      // in jump-ahead mode jumping engines are seeded once per job
+      if (!jumpAhead || initSeedPolicy) return createSeed(id);
+      std::string s = "Jump-ahead job seed Module: " + id.moduleLabel;
+      if (!id.instanceName.empty())
+        s.append(" Instance: ").append(id.instanceName);
+      return SeedFromHash(s);
+    } // PerEventPolicy<SEED>::getJumpingEngineSeed()
+    
+    
+    //--------------------------------------------------------------------------
+    template <typename SEED>
+    auto PerEventPolicy<SEED>::getEventSeedWords(
+      SeedMasterHelper::EngineId const& id, EventData_t const& info,
+      seed_t seed, std::size_t nWords
+    ) const -> SeedWords_t
+    {
+      if (algo != saEventTimestamp_v1)
+        return base_t::getEventSeedWords(id, info, seed, nWords);
+      return seedWordsFromHash(seed, EventTimestamp_v1_string(id, info), nWords);
+    } // PerEventPolicy<SEED>::getEventSeedWords()
+    
+    
+    //--------------------------------------------------------------------------
+    template <typename SEED>
+    auto PerEventPolicy<SEED>::getEventSkip
+      (SeedMasterHelper::EngineId const&, EventData_t const& info) const
+      -> std::optional<EventSkip_t>
+    {
+      if (!jumpAhead) return {};
+      return eventPosition(info) * jumpStride; // range checked in configure()
+    } // PerEventPolicy<SEED>::getEventSkip()
+    
+    
+    //--------------------------------------------------------------------------
+    template <typename SEED>
+    auto PerEventPolicy<SEED>::eventPosition(EventData_t const& info) const
+      -> EventSkip_t
+    {
+      if ((info.runNumber >= maxRuns)
+        || (info.subRunNumber >= maxSubRunsPerRun)
+        || (info.eventNumber >= maxEventsPerSubRun))
+      {
+        throw art::Exception(art::errors::InvalidNumber)
+          << "Event " << UniqueEventIDString(info)
+          << " is out of the range supported by the jump-ahead mode ("
+          << maxRuns << " runs, " << maxSubRunsPerRun << " subruns per run, "
+          << maxEventsPerSubRun << " events per subrun)\n";
+      }
+      return (info.runNumber * maxSubRunsPerRun + info.subRunNumber)
+        * maxEventsPerSubRun + info.eventNumber;
+    } // PerEventPolicy<SEED>::eventPosition()
+    
+    
+    //--------------------------------------------------------------------------
+    template <typename SEED>
+    auto PerEventPolicy<SEED>::multiplyAdd
+      (EventSkip_t a, EventSkip_t b, EventSkip_t c) -> EventSkip_t
+    {
+      constexpr EventSkip_t Max = std::numeric_limits<EventSkip_t>::max();
+      if (((b != 0) && (a > Max / b)) || (a * b > Max - c)) {
+        throw art::Exception(art::errors::InvalidNumber)
+          << "Per-event jump-ahead position overflow (" << a << " x " << b
+          << " + " << c << ")\n";
+      }
+      return a * b + c;
+    } // PerEventPolicy<SEED>::multiplyAdd()
     
     
     //--------------------------------------------------------------------------
     template <typename SEED>
     typename PerEventPolicy<SEED>::seed_t PerEventPolicy<SEED>::createEventSeed
-        (SeedMasterHelper::EngineId const& id, EventData_t const& info)
+        (SeedMasterHelper::EngineId const& id, EventData_t const& info) const
     {
       seed_t seed = base_t::InvalidSeed;
       switch (algo) {
@@ -16,6 +16,7 @@
 #include "nurandom/RandomUtils/Providers/StandardPolicies.h"
 #include "nurandom/RandomUtils/Providers/RandomPolicy.h"
 #include "nurandom/RandomUtils/Providers/PerEventPolicy.h"
+#include "nurandom/RandomUtils/Providers/SplitRandomPolicy.h"
 
 
 #endif // NURANDOM_RANDOMUTILS_PROVIDERS_POLICIES_H
@@ -30,6 +30,12 @@ namespace rndm::details {
   template <typename SEED>
   class PerEventPolicy;
   
+  template <typename SEED>
+  class SplitRandomPolicy;
+  
+  template <typename SEED>
+  class GridMappingPolicy;
+  
 } // namespace rndm::details
 
 
@@ -79,6 +79,10 @@ namespace rndm::details {
         return { policy, std::make_unique<RandomPolicy<SEED>>(config) };
       case Policy::perEvent:
         return { policy, std::make_unique<PerEventPolicy<SEED>>(config) };
+      case Policy::splitRandom:
+        return { policy, std::make_unique<SplitRandomPolicy<SEED>>(config) };
+      case Policy::gridMapping:
+        return { policy, std::make_unique<GridMappingPolicy<SEED>>(config) };
       case Policy::unDefined:
       default:
         // this should have been prevented by an exception by `policyFromName()`
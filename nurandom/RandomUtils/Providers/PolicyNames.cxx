@@ -90,6 +90,22 @@ namespace rndm::details {
   } // policyFromName()
   
   
+  // ---------------------------------------------------------------------------
+  std::vector<std::string> const& serviceConfigurationKeys() {
+    static std::vector<std::string> const keys {
+      // added by art
+      "service_type", "service_provider",
+      // common parameters
+      "policy", "verbosity", "endOfJobSummary", "endOfJobManifest",
+      "engineStateCache", "eventSeedPrefetch", "checkpoint",
+      "validateConfiguration", "seedCollisionMonitor", "engineFingerprints",
+      // parameters of the per-instance policies
+      "baseSeed", "maxUniqueEngines", "checkRange",
+    };
+    return keys;
+  } // serviceConfigurationKeys()
+  
+  
   // ---------------------------------------------------------------------------
   
   
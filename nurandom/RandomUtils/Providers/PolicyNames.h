@@ -27,6 +27,8 @@
   NURANDOM_SEED_SERVICE_POLICY(preDefinedSeed)           \
   NURANDOM_SEED_SERVICE_POLICY(random)                   \
   NURANDOM_SEED_SERVICE_POLICY(perEvent)                 \
+  NURANDOM_SEED_SERVICE_POLICY(splitRandom)              \
+  NURANDOM_SEED_SERVICE_POLICY(gridMapping)              \
   /**/
 
 
@@ -70,6 +72,17 @@ namespace rndm::details {
   Policy policyFromName(std::string const& name);
 
   // ---------------------------------------------------------------------------
+  /**
+   * @brief Returns the configuration keys which are not per-engine entries.
+   * 
+   * The configuration of `NuRandomService` (and `SeedMaster`) mixes parameters
+   * with per-engine entries (e.g. in `preDefinedSeed` policy). This is the
+   * list of all the keys of the parameters common to all policies and of the
+   * parameters of the policies with per-engine entries.
+   */
+  std::vector<std::string> const& serviceConfigurationKeys();
+
+  // ---------------------------------------------------------------------------
   
   
 } // namespace rndm::details
@@ -17,6 +17,7 @@
 #include <memory> // std::unique_ptr<>
 #include <random> // std::uniform_int_distribution, std::default_random_engine
 #include <chrono> // std::system_clock
+#include <sstream>
 
 // From art and its tool chain
 #include "messagefacility/MessageLogger/MessageLogger.h"
@@ -24,6 +25,7 @@
 
 // Some helper classes
 #include "nurandom/RandomUtils/Providers/RandomSeedPolicyBase.h"
+#include "nurandom/RandomUtils/Providers/CheckpointIO.h"
 
 
 namespace rndm {
@@ -65,6 +67,12 @@ namespace rndm {
       /// Prints the details of the configuration of the random generator
       virtual void print(std::ostream& out) const override;
       
+      /// Saves the master seed and the state of the seed generator
+      virtual void saveState(std::ostream& out) const override;
+      
+      /// Restores the master seed and the state of the seed generator
+      virtual void restoreState(std::istream& in) override;
+      
       
         private:
       class RandomImpl {
@@ -79,6 +87,14 @@ namespace rndm {
         seed_t max() const { return distribution.max(); }
         seed_t operator() () { return distribution(generator); }
         
+        /// Returns the state of the generator, in its standard text form
+        std::string state() const
+          { std::ostringstream sstr; sstr << generator; return sstr.str(); }
+        
+        /// Sets the state of the generator from its standard text form
+        bool setState(std::string const& state)
+          { std::istringstream sstr(state); return bool(sstr >> generator); }
+        
           private:
         seed_t seed; ///< seed given at construction, for the record
         std::default_random_engine generator; ///< random engine
@@ -121,6 +137,27 @@ namespace rndm {
     } // RandomPolicy<SEED>::print()
     
     
+    template <typename SEED>
+    void RandomPolicy<SEED>::saveState(std::ostream& out) const {
+      writeCheckpointValue(out, random_seed->master_seed());
+      writeCheckpointString(out, random_seed->state());
+    } // RandomPolicy<SEED>::saveState()
+    
+    
+    template <typename SEED>
+    void RandomPolicy<SEED>::restoreState(std::istream& in) {
+      // the master seed might have been taken from the clock
+      auto const master_seed = readCheckpointValue<seed_t>(in);
+      random_seed.reset
+        (new RandomImpl(master_seed, random_seed->min(), random_seed->max()));
+      if (!random_seed->setState(readCheckpointString(in))) {
+        throw art::Exception(art::errors::FileReadError)
+          << "Seed checkpoint: invalid state of the '" << this->getName()
+          << "' policy seed generator\n";
+      }
+    } // RandomPolicy<SEED>::restoreState()
+    
+    
   } // namespace details
   
 } // namespace rndm
@@ -19,9 +19,13 @@
 #include <array>
 #include <string>
 #include <bitset>
-#include <algorithm> // std::find()
+#include <algorithm> // std::find(), std::sort()
+#include <utility> // std::pair
 #include <sstream>
 #include <ostream> // std::endl
+#include <istream>
+#include <optional>
+#include <cstdint> // std::uint64_t
 
 // From art and its tool chain
 #include "messagefacility/MessageLogger/MessageLogger.h"
@@ -33,6 +37,8 @@
 // Some helper classes
 #include "nurandom/RandomUtils/Providers/EngineId.h"
 #include "nurandom/RandomUtils/Providers/EventSeedInputData.h"
+#include "nurandom/RandomUtils/Providers/SeedWords.h"
+#include "nurandom/RandomUtils/Providers/PolicyNames.h" // serviceConfigurationKeys()
 
 
 namespace rndm {
@@ -92,6 +98,12 @@ namespace rndm {
       /// type of data used for event seeds
       using EventData_t = NuRandomServiceHelper::EventSeedInputData;
       
+      /// type of the number of steps an engine is advanced by for an event
+      using EventSkip_t = std::uint64_t;
+      
+      /// type of a seed made of multiple words
+      using SeedWords_t = std::vector<seed_t>;
+      
       /// An invalid seed
       static constexpr seed_t InvalidSeed = 0;
       
@@ -109,11 +121,88 @@ namespace rndm {
       virtual seed_t getSeed(SeedMasterHelper::EngineId const& id)
         { return createSeed(id); }
       
-      /// Returns a random number specific to an event
+      /**
+       * @brief Returns a random number specific to an event
+       * @param id the engine to be seeded
+       * @param eventInfo information about the event
+       * @return the seed for the engine in the event
+       *
+       * The seed must depend only on the arguments and on the configuration:
+       * `SeedMaster` computes seeds of upcoming events in another thread,
+       * concurrently with the other calls to the policy, and this method must
+       * not change the state of the policy.
+       */
       virtual seed_t getEventSeed
         (SeedMasterHelper::EngineId const& id, EventData_t const& eventInfo)
+        const
         { return createEventSeed(id, eventInfo); }
       
+      /**
+       * @brief Returns how far an engine should be advanced for an event
+       * @param id ID of the engine
+       * @param eventInfo information about the event
+       * @return steps to advance the engine from its job state, if supported
+       * 
+       * Policies supporting jump-ahead of the engines return the number of
+       * steps the engine should be moved forward from its state right after
+       * the per-job seeding, in order to be ready for the specified event.
+       * By default, no jump-ahead is supported and no value is returned.
+       */
+      virtual std::optional<EventSkip_t> getEventSkip(
+        SeedMasterHelper::EngineId const& /* id */,
+        EventData_t const& /* eventInfo */
+        ) const
+        { return {}; }
+      
+      /**
+       * @brief Returns the per-job seed of an engine which can jump ahead
+       * @param id ID of the engine
+       * @return the seed for the engine
+       * @see getEventSkip()
+       * 
+       * Engines registered with a jumper ask their seed here rather than to
+       * `getSeed()`. Policies supporting jump-ahead may assign a per-job seed
+       * only to them, since all the others are reseeded on each event.
+       * By default, the seed is the same as from `getSeed()`.
+       */
+      virtual seed_t getJumpingEngineSeed(SeedMasterHelper::EngineId const& id)
+        { return getSeed(id); }
+      
+      /**
+       * @brief Returns a multi-word seed for the engine
+       * @param id ID of the engine
+       * @param seed the (single word) seed assigned to the engine
+       * @param nWords number of words requested
+       * @return a sequence of `nWords` seed words
+       * @see `expandSeedWords()`
+       * 
+       * By default, the seed is expanded into the requested number of words,
+       * starting with the seed itself.
+       */
+      virtual SeedWords_t getSeedWords(
+        SeedMasterHelper::EngineId const& /* id */,
+        seed_t seed, std::size_t nWords
+        ) const
+        { return expandSeedWords(seed, nWords); }
+      
+      /**
+       * @brief Returns a multi-word seed for the engine, specific to an event
+       * @param id ID of the engine
+       * @param eventInfo information about the event
+       * @param seed the (single word) event seed assigned to the engine
+       * @param nWords number of words requested
+       * @return a sequence of `nWords` seed words
+       * 
+       * Policies can override this to include more information than a single
+       * seed can hold. By default, the seed is expanded as in `getSeedWords()`.
+       */
+      virtual SeedWords_t getEventSeedWords(
+        SeedMasterHelper::EngineId const& /* id */,
+        EventData_t const& /* eventInfo */,
+        seed_t seed, std::size_t nWords
+        ) const
+        { return expandSeedWords(seed, nWords); }
+      
       /// Returns the given name of the policy
       std::string getName() const { return name; }
       
@@ -124,6 +213,35 @@ namespace rndm {
       /// Returns whether the returned seed should be unique
       virtual bool yieldsUniqueSeeds() const { return true; }
       
+      /**
+       * @brief Returns all the problems found in the configuration
+       * @return a list of descriptions of the problems (empty if none)
+       * @see `SeedMaster` configuration parameter `validateConfiguration`
+       * 
+       * Problems which would otherwise be spotted only when an engine asks for
+       * its seed (e.g. in per-engine configuration entries) are reported here
+       * all together. Problems which prevent the configuration of the policy
+       * are still reported by exceptions at configuration time.
+       * By default, there is nothing else to validate.
+       */
+      virtual std::vector<std::string> validate() const { return {}; }
+      
+      /**
+       * @brief Writes the internal state of the policy into a checkpoint
+       * @param out binary stream to write the state into
+       * @see restoreState(), `CheckpointIO.h`
+       * 
+       * Policies whose next seeds depend on the seeds already delivered
+       * (e.g. a counter or a random generator) must save here all that is
+       * needed for `restoreState()` to continue the same sequence.
+       * The configuration is not saved, since it is read again on restart.
+       * By default, policies have no state.
+       */
+      virtual void saveState(std::ostream& /* out */) const {}
+      
+      /// Restores the internal state written by `saveState()`
+      virtual void restoreState(std::istream& /* in */) {}
+      
         protected:
       std::string name; ///< name of the policy
       
@@ -131,8 +249,9 @@ namespace rndm {
       virtual seed_t createSeed(SeedMasterHelper::EngineId const&) = 0;
       
       /// Extracts a seed for specified event information; returns InvalidSeed
+      /// (like `getEventSeed()`, it must not change the state of the policy)
       virtual seed_t createEventSeed
-        (SeedMasterHelper::EngineId const&, EventData_t const&)
+        (SeedMasterHelper::EngineId const&, EventData_t const&) const
         { return InvalidSeed; }
       
     }; // class RandomSeedPolicyBase
@@ -188,6 +307,9 @@ namespace rndm {
       void EnsureRange
         (std::string policy, SeedMasterHelper::EngineId const& id, seed_t seed)
         const;
+      
+      /// Returns a description of the failed range check (empty if passed)
+      std::string rangeError(seed_t seed) const;
 
       /// Returns whether all the parameters are configured
       bool isConfigured() const;
@@ -261,13 +383,22 @@ namespace rndm {
       SeedMasterHelper::EngineId const& id, seed_t seed
     ) const {
       if (operator()(seed)) return;
-      seed_t offset = seed - BaseSeed;
       throw art::Exception(art::errors::LogicError)
         << "NuRandomService (policy: " << policy << ") for engine: "
-        << id << " the offset of seed " << seed << " is: " << offset << "."
+        << id << " " << rangeError(seed);
+    } // RangeCheckHelper<SEED>::EnsureRange()
+    
+    
+    template <typename SEED>
+    std::string RangeCheckHelper<SEED>::rangeError(seed_t seed) const {
+      if (operator()(seed)) return {};
+      seed_t offset = seed - BaseSeed;
+      std::ostringstream sstr;
+      sstr << "the offset of seed " << seed << " is: " << offset << "."
         "\nAllowed seed offsets are in the range 0....(N-1) where N is: "
         << MaxSeeds << " (as configured in maxUniqueEngines)";
-    } // RangeCheckHelper<SEED>::EnsureRange()
+      return sstr.str();
+    } // RangeCheckHelper<SEED>::rangeError()
     
     
     template <typename SEED> template <typename STREAM>
@@ -382,6 +513,11 @@ namespace rndm {
      * @brief Base class for policies reacting at engine instance level
      * @see CheckedRangePolicy
      *
+     * Each engine has its own entry in the configuration, with a number.
+     * Engines of replicated modules may instead have a sequence of numbers,
+     * one for each schedule: the number for schedule `0` is used also when
+     * the module is not replicated. A replica on a schedule other than the
+     * first requires such a sequence.
      */
     template <typename SEED>
     class PerInstancePolicy: public CheckedRangePolicy<SEED> {
@@ -404,6 +540,21 @@ namespace rndm {
       virtual void configure(fhicl::ParameterSet const& pset) override
         { base_t::configure(pset); static_configure(pset); }
       
+      /**
+       * @brief Returns all the problems found in the per-engine entries
+       * @return a list of descriptions of the problems (empty if none)
+       * 
+       * All the entries of the configuration which are not known parameters
+       * (see `details::serviceConfigurationKeys()`) are taken as per-engine
+       * entries, and checked for:
+       * * syntax: an entry is either a number, a sequence of numbers (one per
+       *   schedule), or a table of those;
+       * * validity and range of the resulting seed (see `instanceSeed()`);
+       * * uniqueness of the resulting seed, if the policy yields unique seeds
+       *   (sorting all the seeds).
+       */
+      virtual std::vector<std::string> validate() const override;
+      
         protected:
       fhicl::ParameterSet parameters; ///< configuration parameters
       
@@ -414,12 +565,31 @@ namespace rndm {
       seed_t getInstanceSeed(SeedMasterHelper::EngineId const& id) const
         { return getInstanceParameter<seed_t>(parameters, id); }
       
+      /// Returns the seed for an engine with the specified parameter
+      virtual seed_t instanceSeed(seed_t parameter) const { return parameter; }
+      
       
       /// Retrieves the parameter (seed) for the specified engine ID
       template <typename T>
       static T getInstanceParameter
         (fhicl::ParameterSet const& pset, SeedMasterHelper::EngineId const& id);
       
+      /**
+       * @brief Reads the parameter of the schedule of `id` from `key`
+       * @param pset the parameter set to read `key` from
+       * @param key the name of the entry (a number or a sequence)
+       * @param id the engine the parameter is for
+       * @param[out] param the parameter read
+       * @return whether `key` is present in `pset`
+       * @throw art::Exception (art::errors::Configuration) if the entry has
+       *        no value for the schedule of `id`
+       */
+      template <typename T>
+      static bool getScheduleParameter(
+        fhicl::ParameterSet const& pset, std::string const& key,
+        SeedMasterHelper::EngineId const& id, T& param
+        );
+      
       
       void static_configure(fhicl::ParameterSet const& pset);
       
@@ -434,6 +604,103 @@ namespace rndm {
     } // PerInstancePolicy<SEED>::configure()
     
     
+    template <typename SEED>
+    std::vector<std::string> PerInstancePolicy<SEED>::validate() const {
+      using SeedMasterHelper::EngineId;
+      
+      std::vector<std::string> problems;
+      auto const report = [&problems](auto const&... items)
+        {
+          std::ostringstream sstr;
+          (sstr << ... << items);
+          problems.push_back(sstr.str());
+        };
+      
+      // keys which are not engine entries
+      std::vector<std::string> const& reservedKeys = serviceConfigurationKeys();
+      
+      // collect all the engines and their seeds
+      std::vector<std::pair<seed_t, EngineId>> seeds;
+      auto const addSeed = [&, this](seed_t param, EngineId id)
+        {
+          seed_t const seed = instanceSeed(param);
+          if (seed == base_t::InvalidSeed) {
+            report("'", id, "': seed ", seed, " is not valid");
+            return;
+          }
+          std::string const error = this->range_check.rangeError(seed);
+          if (!error.empty()) {
+            report("'", id, "': ", error);
+            return;
+          }
+          seeds.emplace_back(seed, std::move(id));
+        }; // addSeed()
+      auto const addEngine = [&, this]
+        (fhicl::ParameterSet const& pset, std::string const& key, EngineId id)
+        {
+          if (pset.is_key_to_sequence(key)) { // one entry per schedule
+            std::vector<seed_t> params;
+            try { params = pset.get<std::vector<seed_t>>(key); }
+            catch (std::exception const&) {
+              report("'", id, "': not all the values are valid ",
+                this->getName(), " parameters");
+              return;
+            }
+            if (params.empty())
+              report("'", id, "': empty sequence (one value per schedule expected)");
+            for (std::size_t iSched = 0; iSched < params.size(); ++iSched) {
+              id.schedule = static_cast<SeedMasterHelper::ScheduleNumber_t>(iSched);
+              addSeed(params[iSched], id);
+            }
+            return;
+          }
+          if (!pset.is_key_to_atom(key)) {
+            report("'", id, "': expected a number, found a table");
+            return;
+          }
+          seed_t param;
+          try { param = pset.get<seed_t>(key); }
+          catch (std::exception const&) {
+            report("'", id, "': value '", pset.get<std::string>(key),
+              "' is not a valid ", this->getName(), " parameter");
+            return;
+          }
+          addSeed(param, std::move(id));
+        }; // addEngine()
+      
+      for (std::string const& key: parameters.get_names()) {
+        if (std::find(reservedKeys.begin(), reservedKeys.end(), key)
+          != reservedKeys.end()
+          )
+        {
+          continue;
+        }
+        if (!parameters.is_key_to_table(key)) {
+          addEngine(parameters, key, EngineId(key));
+          continue;
+        }
+        auto const instances = parameters.get<fhicl::ParameterSet>(key);
+        std::vector<std::string> const instanceNames = instances.get_names();
+        if (instanceNames.empty())
+          report("'", key, "': table of engine instances is empty");
+        for (std::string const& instanceName: instanceNames)
+          addEngine(instances, instanceName, EngineId(key, instanceName));
+      } // for
+      
+      if (!this->yieldsUniqueSeeds()) return problems;
+      
+      // uniqueness check: sort by seed, then look for neighbours
+      std::sort(seeds.begin(), seeds.end());
+      for (std::size_t i = 1; i < seeds.size(); ++i) {
+        if (seeds[i].first != seeds[i-1].first) continue;
+        report("'", seeds[i-1].second, "' and '", seeds[i].second,
+          "' share the same seed ", seeds[i].first);
+      } // for
+      
+      return problems;
+    } // PerInstancePolicy<SEED>::validate()
+    
+    
     // This method reads a element of type T from the instance configuration
     template <typename SEED> template <typename T>
     T PerInstancePolicy<SEED>::getInstanceParameter(
@@ -482,7 +749,7 @@ namespace rndm {
             << pset.get<fhicl::ParameterSet>(id.moduleLabel).to_compact_string()
             << ").\nNameless and named engine instances can't coexist.";
         }
-        if (!pset.get_if_present(id.moduleLabel, param)) {
+        if (!getScheduleParameter(pset, id.moduleLabel, id, param)) {
           throw art::Exception(art::errors::Configuration)
             << "NuRandomService: unable to find the parameter for '" << id << "'";
         }
@@ -504,7 +771,7 @@ namespace rndm {
             << id << "'";
         }
         
-        if (!subSet.get_if_present(id.instanceName, param)) {
+        if (!getScheduleParameter(subSet, id.instanceName, id, param)) {
           throw art::Exception(art::errors::Configuration)
             << "NuRandomService: unable to find the parameter value for: '"
             << id << "'";
@@ -515,6 +782,38 @@ namespace rndm {
     } // PerInstancePolicy<SEED>::getInstanceParameter<>()
     
     
+    template <typename SEED> template <typename T>
+    bool PerInstancePolicy<SEED>::getScheduleParameter(
+      fhicl::ParameterSet const& pset, std::string const& key,
+      SeedMasterHelper::EngineId const& id, T& param
+    ) {
+      if (!pset.has_key(key)) return false;
+      
+      if (!pset.is_key_to_sequence(key)) {
+        if (id.isReplica()) {
+          throw art::Exception(art::errors::Configuration)
+            << "NuRandomService: engine '" << id << "' belongs to a module"
+               " replica on schedule " << id.schedule
+            << ", but the configuration has a single value for it;"
+               " a sequence with one value per schedule is required.\n";
+        }
+        param = pset.get<T>(key);
+        return true;
+      }
+      
+      auto const params = pset.get<std::vector<T>>(key);
+      if (id.schedule >= params.size()) {
+        throw art::Exception(art::errors::Configuration)
+          << "NuRandomService: engine '" << id << "' belongs to a module"
+             " replica on schedule " << id.schedule
+          << ", but the configuration has values only for " << params.size()
+          << " schedules.\n";
+      }
+      param = params[id.schedule];
+      return true;
+    } // PerInstancePolicy<SEED>::getScheduleParameter<>()
+    
+    
   } // namespace details
   
 } // namespace rndm
@@ -0,0 +1,365 @@
+/**
+ * @file SeedCollisionMonitor.h
+ * @brief Bounded-memory detection of repeated per-event seeds
+ * @date October 16th, 2026
+ * @see SeedMaster.h
+ *
+ * Per-event seeds (e.g. from `perEvent` policy) are hashes, and nothing
+ * prevents two engines, or two events, from receiving the same one.
+ * Keeping all of them to check would take memory and time growing with the
+ * length of the job: this monitor streams them instead into a fixed-size
+ * probabilistic filter, and confirms the suspect repetitions against a small
+ * table of the most recent seeds.
+ */
+
+#ifndef NURANDOM_RANDOMUTILS_PROVIDERS_SEEDCOLLISIONMONITOR_H
+#define NURANDOM_RANDOMUTILS_PROVIDERS_SEEDCOLLISIONMONITOR_H 1
+
+// nurandom libraries
+#include "nurandom/RandomUtils/Providers/EngineId.h"
+#include "nurandom/RandomUtils/Providers/EventSeedInputData.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::fill()
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t, std::uint32_t
+#include <optional>
+#include <unordered_map>
+#include <utility> // std::swap(), std::move()
+#include <vector>
+
+
+namespace rndm {
+
+  namespace SeedMasterHelper {
+
+    /**
+     * @brief Detects repeated per-event seeds with constant memory.
+     * @tparam SEED type of the seed
+     *
+     * Each seed is added with `insert()`, together with the engine and the
+     * event it was assigned to. Seeds go into a Bloom filter: when the filter
+     * reports the seed as already seen, the seed is looked up in the table of
+     * the most recent `historySize` seeds. If it is there (for a different
+     * engine or a different event), the repetition is confirmed and returned;
+     * otherwise it is counted as unconfirmed: either the filter gave a false
+     * positive, or the previous occurrence is older than the table.
+     * All the recent occurrences of a seed are linked in the table, so that
+     * an assignment inserted again is recognised even when the seed was
+     * assigned to another engine in between.
+     *
+     * A single Bloom filter fills up over a long job, and then reports every
+     * seed as seen. To keep the rate of false positives bounded, two
+     * generations are kept: each one holds up to `generationSize` seeds, after
+     * which the older generation is discarded. Repetitions are therefore
+     * detected within a window of at least `generationSize` seeds, and at most
+     * twice that.
+     *
+     * Memory and time per seed are constant over the job: two filters of
+     * `filterBits` bits each, and a table of `historySize` entries.
+     */
+    template <typename SEED>
+    class SeedCollisionMonitor {
+        public:
+      using seed_t = SEED; ///< type of the seed
+      using EventData_t = NuRandomServiceHelper::EventSeedInputData;
+
+      /// Configuration of the monitor
+      struct Config_t {
+        /// Bits in each of the two filter generations (rounded up to a power
+        /// of 2); default: 16 Mibit (2 MiB)
+        std::size_t filterBits = std::size_t(1) << 24;
+        unsigned int nHashes = 4U; ///< Hash functions per seed.
+        std::size_t generationSize = 1000000U; ///< Seeds per filter generation.
+        std::size_t historySize = 65536U; ///< Seeds in the exact table.
+      }; // Config_t
+
+      /// Identification of an event
+      struct EventKey_t {
+        EventData_t::RunNumber_t run = 0;
+        EventData_t::SubRunNumber_t subRun = 0;
+        EventData_t::EventNumber_t event = 0;
+
+        bool operator== (EventKey_t const& other) const
+          {
+            return (run == other.run) && (subRun == other.subRun)
+              && (event == other.event);
+          }
+      }; // EventKey_t
+
+      /// A seed assigned to an engine in an event
+      struct Occurrence_t {
+        seed_t seed = 0;
+        EngineId engine { "" };
+        EventKey_t event;
+      }; // Occurrence_t
+
+      /// A confirmed repetition: the same seed in two occurrences
+      struct Collision_t {
+        Occurrence_t previous; ///< Earlier occurrence of the seed.
+        Occurrence_t current; ///< Occurrence just inserted.
+      }; // Collision_t
+
+
+      /// Constructor: sets up all the memory the monitor is going to use.
+      explicit SeedCollisionMonitor(Config_t config = {});
+
+      /**
+       * @brief Adds a seed, and returns whether it was seen recently
+       * @param seed the seed
+       * @param engine the engine the seed was assigned to
+       * @param event the event the seed was assigned in
+       * @return the confirmed collision, if any
+       *
+       * Adding again the same seed for the same engine and event is not a
+       * collision, as long as the earlier insertion is still in the table of
+       * the recent seeds.
+       */
+      std::optional<Collision_t> insert
+        (seed_t seed, EngineId const& engine, EventData_t const& event);
+
+      // --- BEGIN --- Statistics ----------------------------------------------
+      /// Number of seeds inserted (the same assignment again is not counted).
+      std::size_t nSeeds() const { return fNSeeds; }
+
+      /// Number of seeds which the filter reported as already seen.
+      std::size_t nCandidates() const { return fNCandidates; }
+
+      /// Number of confirmed collisions.
+      std::size_t nConfirmed() const { return fNConfirmed; }
+
+      /// Number of seeds reported by the filter but not in the recent table.
+      std::size_t nUnconfirmed() const { return fNUnconfirmed; }
+
+      /// Returns the configuration of the monitor.
+      Config_t const& config() const { return fConfig; }
+
+      /// Prints a summary of the statistics into `out`.
+      template <typename Stream>
+      void printSummary(Stream&& out) const;
+      // --- END --- Statistics ------------------------------------------------
+
+        private:
+      using Filter_t = std::vector<std::uint64_t>; ///< A filter generation.
+
+      Config_t fConfig; ///< Configuration (with the actual filter size).
+      std::uint64_t fBitMask; ///< Mask to bring a hash into the filter range.
+
+      Filter_t fCurrent; ///< Filter of the current generation.
+      Filter_t fPrevious; ///< Filter of the previous generation.
+      std::size_t fInGeneration = 0; ///< Seeds in the current generation.
+
+      /// Link of an occurrence in the ring to the previous one of its seed.
+      struct HistoryLink_t {
+        std::size_t number = 0; ///< Insertion number of this occurrence.
+        std::size_t previousSlot = 0; ///< Slot of the previous occurrence.
+        std::size_t previousNumber = 0; ///< Its insertion number (`0`: none).
+      }; // HistoryLink_t
+
+      std::vector<Occurrence_t> fHistory; ///< Ring of the recent occurrences.
+      std::vector<HistoryLink_t> fHistoryLinks; ///< Links of `fHistory`.
+      std::size_t fNextHistory = 0; ///< Next slot in the ring.
+      /// Slot in the ring of the last occurrence of each recent seed.
+      std::unordered_map<seed_t, std::size_t> fHistoryIndex;
+
+      std::size_t fNSeeds = 0;
+      std::size_t fNCandidates = 0;
+      std::size_t fNConfirmed = 0;
+      std::size_t fNUnconfirmed = 0;
+
+      /// Returns whether all the bits of `hash` are set in `filter`.
+      bool inFilter(Filter_t const& filter, std::uint64_t hash) const;
+
+      /// Sets all the bits of `hash` in `filter`.
+      void addToFilter(Filter_t& filter, std::uint64_t hash) const;
+
+      /// Returns the bit of the hash function `i` for the specified hash.
+      std::uint64_t bit(std::uint64_t hash, unsigned int i) const
+        {
+          // double hashing: the second hash is odd, to cover the whole range
+          return (hash + i * ((hash >> 32) | 1U)) & fBitMask;
+        }
+
+      /// Records the occurrence in the recent table.
+      void addToHistory(Occurrence_t&& occurrence);
+
+      /// Returns whether the same assignment is among the recent occurrences
+      /// of its seed, the last of which is in `slot`.
+      bool inHistory(std::size_t slot, Occurrence_t const& occurrence) const;
+
+      /// Mixes the bits of the seed (SplitMix64 finalizer).
+      static std::uint64_t hashSeed(seed_t seed)
+        {
+          std::uint64_t z = static_cast<std::uint64_t>(seed);
+          z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+          z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+          return z ^ (z >> 31);
+        }
+
+      /// Returns the smallest power of 2 not smaller than `n` (at least 64).
+      static std::size_t roundUpToPowerOf2(std::size_t n)
+        {
+          std::size_t p = 64;
+          while (p < n) p <<= 1;
+          return p;
+        }
+
+    }; // class SeedCollisionMonitor<>
+
+
+  } // namespace SeedMasterHelper
+
+} // namespace rndm
+
+
+//==============================================================================
+//===  Template implementation
+//===
+template <typename SEED>
+rndm::SeedMasterHelper::SeedCollisionMonitor<SEED>::SeedCollisionMonitor
+  (Config_t config)
+  : fConfig(std::move(config))
+{
+  fConfig.filterBits = roundUpToPowerOf2(fConfig.filterBits);
+  if (fConfig.nHashes == 0) fConfig.nHashes = 1;
+  if (fConfig.generationSize == 0) fConfig.generationSize = 1;
+  if (fConfig.historySize == 0) fConfig.historySize = 1;
+  fBitMask = fConfig.filterBits - 1;
+
+  fCurrent.assign(fConfig.filterBits / 64, 0ULL);
+  fPrevious.assign(fConfig.filterBits / 64, 0ULL);
+  fHistory.resize(fConfig.historySize);
+  fHistoryLinks.resize(fConfig.historySize);
+  fHistoryIndex.reserve(fConfig.historySize);
+} // SeedCollisionMonitor<>::SeedCollisionMonitor()
+
+
+//------------------------------------------------------------------------------
+template <typename SEED>
+auto rndm::SeedMasterHelper::SeedCollisionMonitor<SEED>::insert
+  (seed_t seed, EngineId const& engine, EventData_t const& event)
+  -> std::optional<Collision_t>
+{
+  Occurrence_t occurrence
+    { seed, engine, { event.runNumber, event.subRunNumber, event.eventNumber } };
+
+  std::uint64_t const hash = hashSeed(seed);
+  bool const candidate = inFilter(fCurrent, hash) || inFilter(fPrevious, hash);
+  std::optional<Collision_t> collision;
+  if (candidate) {
+    auto const iKnown = fHistoryIndex.find(seed);
+    if (iKnown != fHistoryIndex.end()) {
+      if (inHistory(iKnown->second, occurrence))
+        return std::nullopt; // same assignment again: nothing new to record
+      collision = Collision_t{ fHistory[iKnown->second], occurrence };
+    }
+  } // if candidate
+
+  // only new assignments are counted (and take room in the history)
+  ++fNSeeds;
+  if (candidate) {
+    ++fNCandidates;
+    if (collision) ++fNConfirmed;
+    else           ++fNUnconfirmed;
+  }
+
+  addToFilter(fCurrent, hash);
+  if (++fInGeneration >= fConfig.generationSize) {
+    std::swap(fPrevious, fCurrent);
+    std::fill(fCurrent.begin(), fCurrent.end(), 0ULL);
+    fInGeneration = 0;
+  }
+  addToHistory(std::move(occurrence));
+  return collision;
+} // SeedCollisionMonitor<>::insert()
+
+
+//------------------------------------------------------------------------------
+template <typename SEED> template <typename Stream>
+void rndm::SeedMasterHelper::SeedCollisionMonitor<SEED>::printSummary
+  (Stream&& out) const
+{
+  out << "Per-event seed collision monitor: " << nSeeds() << " seeds, "
+    << nConfirmed() << " confirmed collisions, " << nUnconfirmed()
+    << " possible ones (not in the last " << fConfig.historySize
+    << " seeds); filter: 2 x " << fConfig.filterBits << " bits, "
+    << fConfig.nHashes << " hashes, " << fConfig.generationSize
+    << " seeds per generation";
+} // SeedCollisionMonitor<>::printSummary()
+
+
+//------------------------------------------------------------------------------
+template <typename SEED>
+bool rndm::SeedMasterHelper::SeedCollisionMonitor<SEED>::inFilter
+  (Filter_t const& filter, std::uint64_t hash) const
+{
+  for (unsigned int i = 0; i < fConfig.nHashes; ++i) {
+    std::uint64_t const b = bit(hash, i);
+    if (!(filter[b >> 6] & (1ULL << (b & 63)))) return false;
+  }
+  return true;
+} // SeedCollisionMonitor<>::inFilter()
+
+
+template <typename SEED>
+void rndm::SeedMasterHelper::SeedCollisionMonitor<SEED>::addToFilter
+  (Filter_t& filter, std::uint64_t hash) const
+{
+  for (unsigned int i = 0; i < fConfig.nHashes; ++i) {
+    std::uint64_t const b = bit(hash, i);
+    filter[b >> 6] |= (1ULL << (b & 63));
+  }
+} // SeedCollisionMonitor<>::addToFilter()
+
+
+//------------------------------------------------------------------------------
+template <typename SEED>
+void rndm::SeedMasterHelper::SeedCollisionMonitor<SEED>::addToHistory
+  (Occurrence_t&& occurrence)
+{
+  std::size_t const slot = fNextHistory;
+  fNextHistory = (fNextHistory + 1) % fHistory.size();
+
+  // the occurrence being overwritten leaves the index, unless the same seed
+  // has a newer occurrence (whose slot is the one in the index)
+  if (fNSeeds > fHistory.size()) {
+    auto const iOld = fHistoryIndex.find(fHistory[slot].seed);
+    if ((iOld != fHistoryIndex.end()) && (iOld->second == slot))
+      fHistoryIndex.erase(iOld);
+  }
+
+  // link to the previous occurrence of the same seed, if still recorded
+  HistoryLink_t link;
+  link.number = fNSeeds;
+  auto const iPrevious = fHistoryIndex.find(occurrence.seed);
+  if (iPrevious != fHistoryIndex.end()) {
+    link.previousSlot = iPrevious->second;
+    link.previousNumber = fHistoryLinks[iPrevious->second].number;
+  }
+
+  fHistoryIndex[occurrence.seed] = slot;
+  fHistory[slot] = std::move(occurrence);
+  fHistoryLinks[slot] = link;
+} // SeedCollisionMonitor<>::addToHistory()
+
+
+template <typename SEED>
+bool rndm::SeedMasterHelper::SeedCollisionMonitor<SEED>::inHistory
+  (std::size_t slot, Occurrence_t const& occurrence) const
+{
+  std::size_t number = fHistoryLinks[slot].number;
+  // a slot overwritten by a newer occurrence has a different number
+  while ((number > 0) && (fHistoryLinks[slot].number == number)) {
+    Occurrence_t const& known = fHistory[slot];
+    if ((known.engine == occurrence.engine) && (known.event == occurrence.event))
+      return true;
+    number = fHistoryLinks[slot].previousNumber;
+    slot = fHistoryLinks[slot].previousSlot;
+  } // while
+  return false;
+} // SeedCollisionMonitor<>::inHistory()
+
+
+//------------------------------------------------------------------------------
+
+#endif // NURANDOM_RANDOMUTILS_PROVIDERS_SEEDCOLLISIONMONITOR_H
@@ -15,6 +15,9 @@
 #include <map>
 #include <memory> // std::unique_ptr<>
 #include <utility> // std::forward()
+#include <optional>
+#include <functional> // std::function<>
+#include <istream>
 
 // From art and its tool chain
 #include "fhiclcpp/ParameterSet.h"
@@ -25,8 +28,12 @@
 #include "nurandom/RandomUtils/Providers/PolicyNames.h" // rndm::details::Policy
 #include "nurandom/RandomUtils/Providers/MapKeyIterator.h"
 #include "nurandom/RandomUtils/Providers/EngineId.h"
+#include "nurandom/RandomUtils/Providers/EngineHandle.h"
 #include "nurandom/RandomUtils/Providers/Policies.h"
 #include "nurandom/RandomUtils/Providers/EventSeedInputData.h"
+#include "nurandom/RandomUtils/Providers/CheckpointIO.h"
+#include "nurandom/RandomUtils/Providers/SeedCollisionMonitor.h"
+#include "nurandom/RandomUtils/Providers/JSONstring.h"
 
 // more headers included in the implementation section below
 
@@ -49,12 +56,77 @@ namespace rndm {
    *        policy           : "autoIncrement" // Required: Other legal value are listed in SEED_SERVICE_POLICIES
    *        verbosity        : 0               // Optional: default=0, no informational printout
    *        endOfJobSummary  : false           // Optional: print list of all managed seeds at end of job.
+   *        endOfJobManifest : ""              // Optional: write all managed seeds in JSON format into this file at end of job.
+   *        engineStateCache : { size: 0 }     // Optional: keep up to this many CLHEP engine states after seeding, for reuse.
+   *        eventSeedPrefetch: { events: 0 }   // Optional: compute per-event seeds this many events in advance, in background.
+   *        validateConfiguration: false       // Optional: check all the per-engine entries at construction.
+   *        seedCollisionMonitor: {            // Optional: watch per-event seeds for repetitions
+   *          filterBits     : 16777216       //   bits in each filter generation
+   *          hashes         : 4              //   hash functions per seed
+   *          generationSize : 1000000        //   seeds per filter generation
+   *          historySize    : 65536          //   recent seeds kept to confirm a repetition
+   *        }
+   *        engineFingerprints: ""             // Optional: write the hash of each engine state after each module and event into this file.
+   *        checkpoint       : {               // Optional: binary checkpoint of all the seed state, for restarting jobs
+   *          file         : "seeds.ckpt"     //   where to write the checkpoint (required)
+   *          everyNEvents : 0                //   write every these many events (0: only at end of job)
+   *          restore      : false            //   restore the state from `file` (if present) at start
+   *        }
    *     }
    *     
    * The policy parameter tells the service to which algorithm to use.
    * If the value of the policy parameter is not one of the known policies, the code will
    * throw an exception.
    *
+   * The end-of-job summary is meant for humans. For tools, the same information
+   * is available in machine-readable form from `printManifest()`, which
+   * `NuRandomService` writes into the file specified by `endOfJobManifest`.
+   *
+   * The `checkpoint` table makes `NuRandomService` save the complete state of
+   * the seeds (see `saveCheckpoint()`), so that a job that is restarted with
+   * `restore: true` assigns the same seeds as the original one did.
+   *
+   * The `eventSeedPrefetch` table makes `NuRandomService` compute in a
+   * background thread the per-event seeds of the next events, when event IDs
+   * and timestamps are predictable (e.g. `EmptyEvent` source with
+   * `GeneratedEventTimestamp` in `deterministic` mode); see
+   * `NuRandomServiceHelper::EventSeedPrefetcher`. The seeds are the same as
+   * without it; unpredicted events get their seeds computed on demand.
+   *
+   * With `validateConfiguration` enabled, the configuration of the policy is
+   * checked completely on construction, and all the problems found are
+   * reported together in a single exception. For the policies with per-engine
+   * entries (`preDefinedOffset` and `preDefinedSeed`), all the entries are
+   * checked for syntax, range and (except for `preDefinedSeed`) uniqueness,
+   * rather than each one when its engine first asks for a seed. Note that
+   * all the entries are checked, including the ones for engines which are
+   * never going to be registered in the job.
+   *
+   * The `seedCollisionMonitor` table, when present, makes all the per-event
+   * seeds go through a `SeedMasterHelper::SeedCollisionMonitor`, which uses a
+   * fixed amount of memory however long the job is. Each confirmed repetition
+   * (the same seed given to two engines, or in two events) is reported as a
+   * warning; the policy may still legitimately produce the same seed twice,
+   * since per-event seeds are hashes. Note that when a policy yields unique
+   * seeds, repetitions within the same event are already an error.
+   *
+   * With `engineFingerprints`, `NuRandomService` writes a 32-byte record
+   * with the hash of the state of each CLHEP engine it knows, after each
+   * module processes each event (see `NuRandomServiceHelper::EngineFingerprintWriter`).
+   * The `CompareEngineFingerprints` program finds the first event and engine
+   * where two such files differ.
+   *
+   * Engines of replicated art modules are identified also by the schedule of
+   * their module replica (`EngineId::schedule`). For the policies assigning
+   * seeds once per job, each replica is a different engine with its own seed.
+   * The replica on the first schedule gets the same seeds as the module in a
+   * job with a single schedule only with the policies assigning seeds by
+   * engine ID (`preDefinedSeed`, `preDefinedOffset`): the other ones assign
+   * seeds in order of request, and the requests of the other replicas may come
+   * before the ones of modules constructed later. Per-event seeds are computed
+   * from module label and instance name only: the seed of an engine in an
+   * event does not depend on which schedule processes that event.
+   *
    * Code instanciating a SeedMaster can request a seed by making one of the
    * following two calls:
    *     
@@ -102,6 +174,41 @@ namespace rndm {
    * the `offset` is set to 0; on the second unique call to `getSeed` it is set to 1,
    * and so on.
    *
+   * Instead of `nJob`, jobs started together (e.g. many jobs on the same node)
+   * can lease their job number from a shared lease file, so that each gets a
+   * different one without any bookkeeping:
+   *
+   *     jobSlotLease: {
+   *       file         : "/path/to/jobs.lease" // Required: shared lease file
+   *       maxJobs      : 64  // Required: number of job slots
+   *       firstJob     : 0   // Optional: job number of the first slot (0)
+   *       leaseTimeout : 0   // Optional: lease duration [s] (0: whole job)
+   *     }
+   *
+   * The job number is `firstJob` plus the lowest slot not leased by another
+   * running job; the slot is released at the end of the job, and slots left
+   * over by crashed jobs on the same host are reclaimed. The lease timeout
+   * applies only to jobs from other hosts: a job on the same host holds its
+   * slot for as long as it runs.
+   *
+   * If the policy is defined as `gridMapping`, the additional configurable
+   * items are:
+   *
+   *     NuRandomService : {
+   *        policy           : "gridMapping"
+   *        // ... and all the common ones, plus:
+   *        grid             : [ [ 3, 10 ], [ 17, 500 ], [ 5, 64 ] ] // Required
+   *        maxUniqueEngines : 20    // Required: seeds per job
+   *        maxSeed          : 900000000 // Optional: largest allowed seed
+   *        checkRange       : true  // Optional: legal values true (default) or false
+   *     }
+   *
+   * This is `linearMapping` with the job number given as a position in a
+   * multi-level grid of jobs: each level is a `[ index, extent ]` pair, from
+   * the outermost (e.g. submission) to the innermost (e.g. process on a node).
+   * The configuration fails if the seeds of the whole grid do not fit in the
+   * seed range, so that no job can overflow into the seeds of another one.
+   *
    * If the policy is defined as `preDefinedOffset`, the additional configurable
    * items are:
    *     
@@ -167,6 +274,22 @@ namespace rndm {
    *     
    * (this assumes that the configuration of the SeedMaster is read from
    * `services.NuRandomService`, that is the case in the art framework).
+   *
+   * The `splitRandom` policy is a reproducible version of `random`:
+   *
+   *     NuRandomService : {
+   *        policy           : "splitRandom"
+   *        // ... and all the common ones, plus:
+   *        masterSeed: master_seed // optional: a 64-bit integer
+   *        nJob      : 0           // optional: the number of this job
+   *        maxSeed   : 900000000   // optional: the largest seed
+   *     }
+   *
+   * The seeds are drawn from a SplitMix64 sequence, which gives the same
+   * seeds on all platforms. Each job number selects a disjoint subsequence.
+   * If `masterSeed` is omitted, it is taken from the operating system entropy
+   * source rather than from the clock, so that jobs started at the same time
+   * are still independent.
    * 
    * The FHiCL grammar to specify the offsets takes two forms.  If no instance name
    * is given, the offset is given by:
@@ -180,6 +303,11 @@ namespace rndm {
    *        instanceName2 : offset2
    *     }
    *     
+   * Engines of replicated modules need a sequence of offsets, one for each
+   * schedule, in place of a single offset:
+   *     
+   *     moduleLabel : [ offset0, offset1, offset2, offset3 ]
+   *     
    * `SeedMaster` does several additional checks, except for the `preDefinedSeed` policy.
    *
    * If one (module label, instance name) has the same seed as another (module label, instance name),
@@ -202,6 +330,12 @@ namespace rndm {
       
     using EngineId = SeedMasterHelper::EngineId; ///< type of engine ID
     
+    /// type of number of the art schedule
+    using ScheduleNumber_t = SeedMasterHelper::ScheduleNumber_t;
+    
+    /// type of compact handle to a registered engine
+    using EngineHandle = SeedMasterHelper::EngineHandle;
+    
     /// type of a function setting a seed
     using Seeder_t = std::function<void(EngineId const&, seed_t)>;
     
@@ -209,6 +343,24 @@ namespace rndm {
     /// Type of abstract class for policy implementation
     using PolicyImpl_t = details::RandomSeedPolicyBase<seed_t>;
     
+      public:
+    /// type of the number of steps an engine is advanced for an event
+    using EventSkip_t = typename PolicyImpl_t::EventSkip_t;
+    
+    /// type of a function moving an engine to its state for an event
+    using Jumper_t = std::function<void(EngineId const&, EventSkip_t)>;
+    
+    /// type of a seed made of multiple words
+    using SeedWords_t = typename PolicyImpl_t::SeedWords_t;
+    
+    /// type of a function setting a multi-word seed
+    using MultiSeeder_t = std::function<void(EngineId const&, SeedWords_t const&)>;
+    
+    /// an engine to be registered by `registerNewSeeders()`, with its seeder
+    using SeederRegistration_t = std::pair<EngineId, Seeder_t>;
+    
+      private:
+    
     /// Type for seed data base
     using map_type = std::map<EngineId, seed_t>;
     
@@ -231,15 +383,46 @@ namespace rndm {
       void autoApplySeed(Args... args) const
         { if (!isFrozen()) applySeed(std::forward<Args>(args)...); }
       
+      bool hasMultiSeeder() const { return bool(multiSeeder); }
+      std::size_t nSeedWords() const { return nWords; }
+      void setMultiSeeder(MultiSeeder_t new_seeder, std::size_t n)
+        { multiSeeder = new_seeder; nWords = n; }
+      
+      /// Execute the multi-word seeder
+      void applySeedWords(EngineId const& id, SeedWords_t const& words) const
+        { if (hasMultiSeeder()) multiSeeder(id, words); }
+      
+      bool hasJumper() const { return bool(jumper); }
+      void setJumper(Jumper_t new_jumper) { jumper = new_jumper; }
+      
+      EngineHandle handle() const { return engineHandle; }
+      void setHandle(EngineHandle new_handle) { engineHandle = new_handle; }
+      
+      /// Execute the jumper (whatever arguments it has...)
+      template <typename... Args>
+      void applyJump(Args... args) const
+        { if (hasJumper()) jumper(std::forward<Args>(args)...); }
+      
         private:
       Seeder_t seeder;      ///< engine seeder
+      Jumper_t jumper;      ///< engine jump-ahead function (optional)
+      MultiSeeder_t multiSeeder; ///< engine multi-word seeder (optional)
+      std::size_t nWords = 0; ///< number of words for the multi-word seeder
       bool autoseed = true; ///< whether seeding can be automatic
+      EngineHandle engineHandle; ///< handle of the engine (if assigned)
       
     }; // EngineInfo_t
     
     /// type of map of seeders associated with the engines
     using EngineData_t = std::map<EngineId, EngineInfo_t>;
     
+    /// Direct access to the information of an engine with a handle
+    struct HandleData_t {
+      typename EngineData_t::iterator engine; ///< engine information
+      typename map_type::iterator configured; ///< configured seed
+      typename map_type::iterator current; ///< current seed
+    }; // HandleData_t
+    
       public:
     /// type of data used for event seeds
     using EventData_t = typename PolicyImpl_t::EventData_t;
@@ -288,11 +471,71 @@ namespace rndm {
     seed_t getEventSeed(EventData_t const& data, EngineId const& id);
     //@}
     
+    /**
+     * @brief Returns the seed for the engine, expanded into `nWords` words
+     * @return the seed words, empty if the engine seed is not valid
+     * @see `details::RandomSeedPolicyBase::getSeedWords()`
+     */
+    SeedWords_t getSeedWords(EngineId const& id, std::size_t nWords);
+    
+    /**
+     * @brief Returns the event seed for the engine, as `nWords` words
+     * @return the seed words, empty if the engine has no event seed
+     * @see `details::RandomSeedPolicyBase::getEventSeedWords()`
+     */
+    SeedWords_t getEventSeedWords
+      (EventData_t const& data, EngineId const& id, std::size_t nWords);
+    
     /// Returns the last computed seed value for the specified engine ID
     seed_t getCurrentSeed(EngineId const& id) const
       { return getSeedFromMap(currentSeeds, id); }
     
     
+    // --- BEGIN --- Access by handle ------------------------------------------
+    /**
+     * @name Access by handle
+     *
+     * A registered engine can be assigned a handle (`engineHandle()`), a dense
+     * index which gives access to its seeds in constant time and without
+     * creating any `EngineId`. Handles stay valid for the lifetime of the
+     * SeedMaster, also across checkpoint restoration.
+     */
+    /// @{
+    
+    /**
+     * @brief Returns the handle of a registered engine, assigning it if needed
+     * @param id ID of the engine
+     * @return the handle of the engine
+     * @throw art::Exception (art::errors::LogicError) if engine not registered
+     *
+     * The configured seed of the engine is computed if not done yet.
+     * Further calls for the same engine return the same handle.
+     */
+    EngineHandle engineHandle(EngineId const& id);
+    
+    /// Returns whether `handle` refers to an engine of this object
+    bool hasEngine(EngineHandle handle) const
+      { return handle.isValid() && (handle.index() < handles.size()); }
+    
+    /// Returns the ID of the engine with the specified handle
+    EngineId const& engineId(EngineHandle handle) const
+      { return handleData(handle).engine->first; }
+    
+    /// Returns the configured seed of the engine with the specified handle
+    seed_t getSeed(EngineHandle handle) const
+      { return handleData(handle).configured->second; }
+    
+    /// Returns the last seed of the engine with the specified handle
+    seed_t getCurrentSeed(EngineHandle handle) const
+      { return handleData(handle).current->second; }
+    
+    /// Reseeds the engine with the specified handle; @see reseed(EngineId const&)
+    seed_t reseed(EngineHandle handle);
+    
+    /// @}
+    // --- END --- Access by handle --------------------------------------------
+    
+    
     /**
      * @brief Register the specified function to reseed the engine id
      * @param id ID of the engine to be associated to the seeder
@@ -320,6 +563,56 @@ namespace rndm {
     void registerNewSeeder(EngineId const& id, Seeder_t seeder);
     
     
+    /**
+     * @brief Registers many new engines at once, and returns their seeds
+     * @param engines the IDs of the engines, each with its seeder
+     * @return the configured seed of each engine, in the same order
+     * @throw art::Exception (art::errors::LogicError) if an engine is already
+     *        registered or appears twice, or if a seed is not unique
+     * @see registerNewSeeder(), getSeed()
+     *
+     * This is equivalent to calling `registerNewSeeder()` and then `getSeed()`
+     * on each of the engines, but the checks are performed once for the
+     * whole batch: the uniqueness of the new seeds is verified by sorting them
+     * together with the ones already assigned, rather than comparing each new
+     * seed with all the others.
+     * If any check fails, no engine of the batch is registered (although the
+     * policy may have already produced their seeds).
+     * The engines are not seeded.
+     */
+    std::vector<seed_t> registerNewSeeders
+      (std::vector<SeederRegistration_t> const& engines);
+    
+    
+    /**
+     * @brief Register the function to move the engine `id` to an event state
+     * @param id ID of the engine to be associated to the jumper
+     * @param jumper function moving the engine to its state for an event
+     *
+     * The jumper is invoked by reseedEvent() instead of reseeding the engine,
+     * if the policy supports jump-ahead (see
+     * `details::RandomSeedPolicyBase::getEventSkip()`). It receives the number
+     * of steps the engine needs to be advanced from the state it had after it
+     * was last seeded by its seeder.
+     */
+    void registerJumper(EngineId const& id, Jumper_t jumper);
+    
+    
+    /**
+     * @brief Register the function to set a multi-word seed to engine `id`
+     * @param id ID of the engine to be associated to the seeder
+     * @param seeder function setting the seed words to the engine
+     * @param nWords number of seed words the engine takes
+     *
+     * When reseed() or reseedEvent() reseed the engine, they use this seeder
+     * with `nWords` seed words (see `getSeedWords()` and
+     * `getEventSeedWords()`) instead of the single-word seeder.
+     * The first word is always the seed returned by those methods.
+     */
+    void registerMultiSeeder
+      (EngineId const& id, MultiSeeder_t seeder, std::size_t nWords);
+    
+    
     /// Forces SeedMaster not to change the seed of a registered engine
     void freezeSeed(EngineId const& id, seed_t seed);
     
@@ -342,17 +635,140 @@ namespace rndm {
      *
      * Reseeding does not happen if either there is no seeder registered with
      * that engine, or if that engine is already frozen.
+     * 
+     * If the engine has a jumper registered and the policy supports
+     * jump-ahead, the engine is moved forward instead of being reseeded,
+     * and its configured seed is returned.
      */
     seed_t reseedEvent(EngineId const& id, EventData_t const& data);
     
     /// Prints known (EngineId,seed) pairs
     template<typename Stream> void print(Stream&&) const;
     
+    /**
+     * @brief Writes a JSON manifest of the policy and of all known seeds
+     * @param out the stream to write the manifest into
+     *
+     * The manifest is a JSON object with the policy name (`policy`), the
+     * printout of the policy configuration (`policyConfiguration`) and a list
+     * of `engines`. Each engine entry reports module label (`module`),
+     * instance name (`instance`), schedule of the module replica (`schedule`,
+     * `0` if not replicated), whether it's a global engine (`global`),
+     * the configured seed and the last seed (`configuredSeed`, `lastSeed`;
+     * `null` if not valid) and a `status`, one of:
+     * * `"configured"`: seed set from the policy once for all the job
+     * * `"perEvent"`: seed set on each event
+     * * `"frozen"`: seed overridden by the user (e.g. from module configuration)
+     * * `"invalid"`: no valid seed was ever assigned
+     * * `"mismatch"`: the last seed differs from the configured one (error!)
+     *
+     * All the seeds are written in a single pass.
+     */
+    void printManifest(std::ostream& out) const;
+    
+    /**
+     * @brief Writes the complete seed state into a binary checkpoint
+     * @param out the binary stream to write the checkpoint into
+     * @param label free text stored in the checkpoint (e.g. last event)
+     * @see restoreCheckpoint()
+     *
+     * The checkpoint contains the internal state of the policy (see
+     * `details::RandomSeedPolicyBase::saveState()`) and, for each known
+     * engine, its configured and current seeds and whether it is frozen.
+     * Seeds for the current event are not saved, since they are recomputed
+     * on each event.
+     * The format is compact and native to the platform, and it is not meant
+     * to be portable.
+     */
+    void saveCheckpoint(std::ostream& out, std::string const& label = "") const;
+    
+    /**
+     * @brief Restores the state written by `saveCheckpoint()`
+     * @param in the binary stream to read the checkpoint from
+     * @return the label stored in the checkpoint
+     * @throw art::Exception (art::errors::Configuration) if the checkpoint
+     *        was written with a different policy or seed type
+     * @throw art::Exception (art::errors::FileReadError) on corrupted data
+     *
+     * The seeds of the checkpoint replace the known ones, so that engines
+     * registered afterwards receive the same seeds they had in the job that
+     * wrote the checkpoint, and the policy continues from where it was.
+     * The frozen status is applied only to the engines already registered;
+     * the others get it again, from their configuration, on registration.
+     * Restoring takes a time linear with the number of engines.
+     */
+    std::string restoreCheckpoint(std::istream& in);
+    
     /// Returns an object to iterate in range-for through configured engine IDs
     EngineInfoIteratorBox engineIDsRange() const { return { engineData }; }
     
-    /// Prepares for a new event
-    void onNewEvent();
+    /**
+     * @brief Prepares for a new event
+     * @param schedule the schedule which is going to process the event
+     *
+     * Per-event seeds are remembered separately for each schedule (see
+     * `EventData_t::schedule`), so that events processed concurrently on
+     * different schedules do not mix their seeds.
+     */
+    void onNewEvent(ScheduleNumber_t schedule = 0);
+    
+    
+    // --- BEGIN --- Per-event seeds computed in advance -----------------------
+    /// @name Per-event seeds computed in advance
+    /// @{
+    
+    /// type of a set of per-event seeds, one per engine
+    using EventSeeds_t = std::map<EngineId, seed_t>;
+    
+    /// Returns the number of registered engines
+    std::size_t nEngines() const { return engineData.size(); }
+    
+    /**
+     * @brief Returns the engines `reseedEvent()` reseeds with a per-event seed
+     * @return the sorted list of engine IDs
+     *
+     * These are all the registered engines which are not frozen and which
+     * have no jump-ahead function.
+     */
+    std::vector<EngineId> eventSeededEngines() const;
+    
+    /**
+     * @brief Computes the per-event seeds of the specified engines
+     * @param data information on the event (module information is ignored)
+     * @param ids the engines to compute the seed of, sorted
+     * @return the per-event seeds of the engines
+     * @throw art::Exception (art::errors::LogicError) on duplicate seeds
+     *
+     * The seeds are not recorded: they can be handed to `adoptEventSeeds()`
+     * when the event is actually processed.
+     * This method only uses the policy, which computes per-event seeds without
+     * changing its own state: it can be called from a thread other than the
+     * one using this object, as long as the policy is not being replaced.
+     */
+    EventSeeds_t computeEventSeeds
+      (EventData_t data, std::vector<EngineId> const& ids) const;
+    
+    /**
+     * @brief Sets the seeds of the current event, computed in advance
+     * @param eventSeeds seeds from `computeEventSeeds()` for this event
+     * @param data information on the event the seeds were computed for
+     *
+     * This must be called right after `onNewEvent()`. The seeds are used by
+     * `getEventSeed()` and `reseedEvent()` as if they had just been computed;
+     * they also become the current seeds of all their engines.
+     * Engines not in `eventSeeds` get their seed computed on demand.
+     */
+    void adoptEventSeeds(EventSeeds_t&& eventSeeds, EventData_t const& data);
+    
+    /// @}
+    // --- END --- Per-event seeds computed in advance -------------------------
+    
+    /// Type of the monitor of repeated per-event seeds.
+    using CollisionMonitor_t = SeedMasterHelper::SeedCollisionMonitor<seed_t>;
+    
+    /// Returns the monitor of per-event seeds (`nullptr` if not enabled).
+    CollisionMonitor_t const* collisionMonitor() const
+      { return collision_monitor.get(); }
     
     /// Prints to the framework Info logger
     void print() const { print(mf::LogVerbatim("SEEDS")); }    
@@ -367,17 +783,29 @@ namespace rndm {
     /// List of seeds computed from configuration information.
     map_type configuredSeeds;
     
-    /// List of event seeds already computed.
-    map_type knownEventSeeds;
+    /// List of event seeds already computed, per schedule.
+    std::vector<map_type> knownEventSeeds;
     
     /// List of seeds already computed.
     map_type currentSeeds;
     
     EngineData_t engineData; ///< list of all engine information
+    
+    std::vector<HandleData_t> handles; ///< direct access by engine handle
 
     /// Helper function to parse the policy name
     void setPolicy(std::string policyName);
     
+    /**
+     * @brief Calls `op` with the information of each seed, in a single pass.
+     * @param op callable as `op(id, configuredSeed, currentSeed, frozen)`
+     *
+     * The seed maps and the engine information share the same sorting, so they
+     * are walked in parallel instead of looking up each engine.
+     */
+    template <typename Op>
+    void forEachSeed(Op op) const;
+    
     /// @{
     /// @brief Throws if the seed has already been used
     /// 
@@ -388,9 +816,43 @@ namespace rndm {
       { return ensureUnique(id, seed, configuredSeeds); }
     /// @}
     
+    /// Throws if any of the `newSeeds` has been used by another engine
+    void ensureUnique
+      (std::vector<std::pair<EngineId const*, seed_t>> const& newSeeds) const;
+    
     /// the instance of the random policy
     std::unique_ptr<PolicyImpl_t> policy_impl;
     
+    /// monitor of repeated per-event seeds (if enabled)
+    std::unique_ptr<CollisionMonitor_t> collision_monitor;
+    
+    /// Adds a new per-event seed to the monitor, and reports repetitions.
+    void monitorEventSeed
+      (EngineId const& id, seed_t seed, EventData_t const& data);
+    
+    /// Creates the collision monitor from the configuration, if requested.
+    static std::unique_ptr<CollisionMonitor_t> makeCollisionMonitor
+      (fhicl::ParameterSet const& pSet);
+    
+    
+    /// Returns the data of the engine with the specified handle
+    /// @throw art::Exception (art::errors::LogicError) if handle is not valid
+    HandleData_t const& handleData(EngineHandle handle) const;
+    
+    /// Updates the seed access of all handles after the seed maps changed
+    void updateHandles();
+    
+    /// Reseeds the engine `id` with its configured `seed` (unless invalid)
+    seed_t applyConfiguredSeed
+      (EngineId const& id, EngineInfo_t const& engineInfo, seed_t seed) const;
+    
+    /// Returns the event seeds already computed on the specified schedule
+    map_type& eventSeedsOf(ScheduleNumber_t schedule)
+      {
+        if (schedule >= knownEventSeeds.size())
+          knownEventSeeds.resize(schedule + 1);
+        return knownEventSeeds[schedule];
+      }
     
     /// Returns a seed from the specified map, or InvalidSeed if not present
     static seed_t getSeedFromMap(map_type const& seeds, EngineId const& id)
@@ -411,10 +873,11 @@ namespace rndm {
 
 // C++ include files
 #include <ostream>
+#include <sstream>
 #include <iomanip> // std::setw()
 #include <ostream> // std::endl
-#include <algorithm> // std::find(), std::copy()
-#include <iterator> // std::ostream_iterator<>, std::distance()
+#include <algorithm> // std::find(), std::copy(), std::equal(), std::sort()...
+#include <iterator> // std::ostream_iterator<>, std::distance(), std::next()
 
 // Supporting library include files
 #include "messagefacility/MessageLogger/MessageLogger.h"
@@ -443,6 +906,20 @@ rndm::SeedMaster<SEED>::SeedMaster(fhicl::ParameterSet const& pSet):
   
   policy_impl = std::move(details::makeRandomSeedPolicy<seed_t>(pSet).ptr);
   
+  if (pSet.get<bool>("validateConfiguration", false)) {
+    std::vector<std::string> const problems = policy_impl->validate();
+    if (!problems.empty()) {
+      art::Exception e(art::errors::Configuration);
+      e << "SeedMaster: " << problems.size()
+        << " problem(s) found in the configuration of policy '"
+        << policy_impl->getName() << "':";
+      for (std::string const& problem: problems) e << "\n - " << problem;
+      throw e << "\n";
+    }
+  } // if validate
+  
+  collision_monitor = makeCollisionMonitor(pSet);
+  
   if ( verbosity > 0 )
     print(mf::LogVerbatim("SeedMaster"));
   
@@ -491,6 +968,82 @@ void rndm::SeedMaster<SEED>::registerNewSeeder
 } // SeedMaster<SEED>::registerNewSeeder()
 
 
+//----------------------------------------------------------------------------
+template <typename SEED>
+auto rndm::SeedMaster<SEED>::registerNewSeeders
+  (std::vector<SeederRegistration_t> const& engines) -> std::vector<seed_t>
+{
+  //
+  // check the batch: no engine twice, none already registered
+  //
+  std::vector<EngineId const*> sortedIDs;
+  sortedIDs.reserve(engines.size());
+  for (auto const& engine: engines) sortedIDs.push_back(&engine.first);
+  std::sort(sortedIDs.begin(), sortedIDs.end(),
+    [](EngineId const* a, EngineId const* b){ return *a < *b; });
+  auto const iDuplicate = std::adjacent_find(sortedIDs.begin(), sortedIDs.end(),
+    [](EngineId const* a, EngineId const* b){ return *a == *b; });
+  if (iDuplicate != sortedIDs.end()) {
+    throw art::Exception(art::errors::LogicError)
+      << "SeedMaster(): Engine with ID='" << **iDuplicate
+      << "' registered twice in the same batch";
+  }
+  for (EngineId const* id: sortedIDs) {
+    if (!hasEngine(*id)) continue;
+    throw art::Exception(art::errors::LogicError)
+      << "SeedMaster(): Engine with ID='" << *id << "' already registered";
+  } // for
+  
+  //
+  // collect the seeds (some may have been assigned already), check them once
+  //
+  std::vector<seed_t> seeds;
+  seeds.reserve(engines.size());
+  std::vector<std::pair<EngineId const*, seed_t>> newSeeds;
+  for (auto const& [ id, seeder ]: engines) {
+    auto const iSeed = configuredSeeds.find(id);
+    if (iSeed != configuredSeeds.end()) {
+      seeds.push_back(iSeed->second);
+      continue;
+    }
+    seeds.push_back(policy_impl->getSeed(id));
+    newSeeds.emplace_back(&id, seeds.back());
+  } // for
+  if (policy_impl->yieldsUniqueSeeds()) ensureUnique(newSeeds);
+  
+  //
+  // commit
+  //
+  for (auto const& [ id, seed ]: newSeeds) {
+    configuredSeeds.emplace(*id, seed);
+    // same treatment of invalid seeds as in getSeed()
+    if (seed != InvalidSeed) currentSeeds[*id] = seed;
+    else                     currentSeeds.emplace(*id, seed);
+  } // for
+  for (auto const& [ id, seeder ]: engines) registerSeeder(id, seeder);
+  
+  return seeds;
+} // SeedMaster<SEED>::registerNewSeeders()
+
+
+//----------------------------------------------------------------------------
+template <typename SEED>
+void rndm::SeedMaster<SEED>::registerJumper
+  (EngineId const& id, Jumper_t jumper)
+{
+  engineData[id].setJumper(jumper);
+} // SeedMaster<SEED>::registerJumper()
+
+
+//----------------------------------------------------------------------------
+template <typename SEED>
+void rndm::SeedMaster<SEED>::registerMultiSeeder
+  (EngineId const& id, MultiSeeder_t seeder, std::size_t nWords)
+{
+  engineData[id].setMultiSeeder(seeder, nWords);
+} // SeedMaster<SEED>::registerMultiSeeder()
+
+
 //----------------------------------------------------------------------------
 template <typename SEED>
 void rndm::SeedMaster<SEED>::freezeSeed(EngineId const& id, seed_t seed) {
@@ -507,12 +1060,86 @@ typename rndm::SeedMaster<SEED>::seed_t rndm::SeedMaster<SEED>::reseed
 {
   auto const& engineInfo = engineData.at(id);
   if (engineInfo.isFrozen()) return InvalidSeed;
-  seed_t seed = getSeed(id);
+  return applyConfiguredSeed(id, engineInfo, getSeed(id));
+} // SeedMaster<SEED>::reseed()
+
+
+template <typename SEED>
+typename rndm::SeedMaster<SEED>::seed_t rndm::SeedMaster<SEED>::reseed
+  (EngineHandle handle)
+{
+  HandleData_t const& data = handleData(handle);
+  EngineInfo_t const& engineInfo = data.engine->second;
+  if (engineInfo.isFrozen()) return InvalidSeed;
+  return applyConfiguredSeed
+    (data.engine->first, engineInfo, data.configured->second);
+} // SeedMaster<SEED>::reseed(EngineHandle)
+
+
+template <typename SEED>
+typename rndm::SeedMaster<SEED>::seed_t
+rndm::SeedMaster<SEED>::applyConfiguredSeed
+  (EngineId const& id, EngineInfo_t const& engineInfo, seed_t seed) const
+{
   if (seed != InvalidSeed) { // reseed
-    engineInfo.applySeed(id, seed);
+    if (engineInfo.hasMultiSeeder()) {
+      engineInfo.applySeedWords
+        (id, policy_impl->getSeedWords(id, seed, engineInfo.nSeedWords()));
+    }
+    else engineInfo.applySeed(id, seed);
   }
   return seed;
-} // SeedMaster<SEED>::reseed()
+} // SeedMaster<SEED>::applyConfiguredSeed()
+
+
+//----------------------------------------------------------------------------
+template <typename SEED>
+auto rndm::SeedMaster<SEED>::engineHandle(EngineId const& id) -> EngineHandle
+{
+  auto const iEngine = engineData.find(id);
+  if (iEngine == engineData.end()) {
+    throw art::Exception(art::errors::LogicError)
+      << "SeedMaster(): no handle for engine '" << id
+      << "', which is not registered";
+  }
+  if (iEngine->second.handle()) return iEngine->second.handle();
+  
+  if (handles.size() >= EngineHandle::InvalidIndex) {
+    throw art::Exception(art::errors::LogicError)
+      << "SeedMaster(): too many engine handles";
+  }
+  
+  getSeed(id); // makes sure that the seed entries exist
+  EngineHandle const handle
+    { static_cast<typename EngineHandle::index_t>(handles.size()) };
+  handles.push_back
+    ({ iEngine, configuredSeeds.find(id), currentSeeds.find(id) });
+  iEngine->second.setHandle(handle);
+  return handle;
+} // SeedMaster<SEED>::engineHandle()
+
+
+template <typename SEED>
+auto rndm::SeedMaster<SEED>::handleData(EngineHandle handle) const
+  -> HandleData_t const&
+{
+  if (!hasEngine(handle)) {
+    throw art::Exception(art::errors::LogicError)
+      << "SeedMaster(): invalid engine handle " << handle;
+  }
+  return handles[handle.index()];
+} // SeedMaster<SEED>::handleData()
+
+
+template <typename SEED>
+void rndm::SeedMaster<SEED>::updateHandles() {
+  for (HandleData_t& data: handles) {
+    EngineId const& id = data.engine->first;
+    getSeed(id); // the engine may be missing from the new seed maps
+    data.configured = configuredSeeds.find(id);
+    data.current = currentSeeds.find(id);
+  } // for
+} // SeedMaster<SEED>::updateHandles()
 
 
 template <typename SEED>
@@ -521,9 +1148,22 @@ typename rndm::SeedMaster<SEED>::seed_t rndm::SeedMaster<SEED>::reseedEvent
 {
   auto const& engineInfo = engineData.at(id);
   if (engineInfo.isFrozen()) return InvalidSeed;
+  if (engineInfo.hasJumper()) {
+    std::optional<EventSkip_t> const skip
+      = policy_impl->getEventSkip(id, data);
+    if (skip) {
+      engineInfo.applyJump(id, *skip);
+      return getSeed(id); // the engine is still on its job seed
+    }
+  } // if jumper
   seed_t seed = getEventSeed(data, id);
   if (seed != InvalidSeed) { // reseed
-    engineInfo.autoApplySeed(id, seed);
+    if (engineInfo.hasMultiSeeder()) {
+      engineInfo.applySeedWords(id,
+        policy_impl->getEventSeedWords(id, data, seed, engineInfo.nSeedWords())
+        );
+    }
+    else engineInfo.autoApplySeed(id, seed);
   }
   return seed;
 } // SeedMaster<SEED>::reseedEvent()
@@ -554,10 +1194,10 @@ void rndm::SeedMaster<SEED>::print(Stream&& log) const {
       << std::setw(SepWidth2) << ""
       << "ModuleLabel.InstanceName";
     
-    for (auto const& p: currentSeeds) {
-      EngineId const& ID = p.first;
-      seed_t configuredSeed = getSeedFromMap(configuredSeeds, ID);
-      seed_t currentSeed = p.second;
+    forEachSeed([&log](
+      EngineId const& ID, seed_t configuredSeed, seed_t currentSeed,
+      bool frozen
+    ) {
       
       if (configuredSeed == InvalidSeed) {
         if (currentSeed == InvalidSeed) {
@@ -596,13 +1236,201 @@ void rndm::SeedMaster<SEED>::print(Stream&& log) const {
         }
       } // if per job
       if (ID.isGlobal()) log << " (global)";
-      if (hasEngine(ID) && engineData.at(ID).isFrozen()) log << " [overridden]";
-    } // for all seeds
+      if (frozen) log << " [overridden]";
+    }); // for all seeds
   } // if any seed
   log << '\n' << std::endl;
 } // SeedMaster<SEED>::print(Stream)
 
 
+//----------------------------------------------------------------------------
+template <typename SEED>
+void rndm::SeedMaster<SEED>::printManifest(std::ostream& out) const {
+  
+  // writes a string as JSON string literal
+  auto const printString = [&out](std::string const& s)
+    { details::printJSONstring(out, s); };
+  
+  // writes a seed, or `null` if invalid
+  auto const printSeed = [&out](seed_t seed)
+    { if (seed == InvalidSeed) out << "null"; else out << seed; };
+  
+  std::ostringstream sstr;
+  policy_impl->print(sstr);
+  
+  out << "{\n  \"policy\": ";
+  printString(policy_impl->getName());
+  out << ",\n  \"policyConfiguration\": ";
+  printString(sstr.str());
+  out << ",\n  \"engines\": [";
+  
+  bool first = true;
+  forEachSeed([&](
+    EngineId const& ID, seed_t configuredSeed, seed_t currentSeed,
+    bool frozen
+  ) {
+    char const* status = "configured";
+    if (frozen)                                 status = "frozen";
+    else if (configuredSeed == InvalidSeed)
+      status = (currentSeed == InvalidSeed)? "invalid": "perEvent";
+    else if (configuredSeed != currentSeed)     status = "mismatch";
+    
+    out << (first? "\n    { \"module\": ": ",\n    { \"module\": ");
+    first = false;
+    printString(ID.moduleLabel);
+    out << ", \"instance\": ";
+    printString(ID.instanceName);
+    out << ", \"schedule\": " << ID.schedule
+      << ", \"global\": " << (ID.isGlobal()? "true": "false")
+      << ", \"configuredSeed\": ";
+    printSeed(configuredSeed);
+    out << ", \"lastSeed\": ";
+    printSeed(currentSeed);
+    out << ", \"status\": \"" << status << "\" }";
+  }); // for all seeds
+  
+  out << (first? "]\n}\n": "\n  ]\n}\n");
+  
+} // SeedMaster<SEED>::printManifest()
+
+
+//----------------------------------------------------------------------------
+template <typename SEED>
+void rndm::SeedMaster<SEED>::saveCheckpoint
+  (std::ostream& out, std::string const& label /* = "" */) const
+{
+  using namespace details;
+  
+  out.write(CheckpointMagic, sizeof(CheckpointMagic));
+  writeCheckpointValue(out, CheckpointVersion);
+  writeCheckpointValue(out, static_cast<std::uint32_t>(sizeof(seed_t)));
+  writeCheckpointString(out, policy_impl->getName());
+  writeCheckpointString(out, label);
+  
+  std::ostringstream policyState;
+  policy_impl->saveState(policyState);
+  writeCheckpointString(out, policyState.str());
+  
+  writeCheckpointValue(out, static_cast<std::uint64_t>(currentSeeds.size()));
+  forEachSeed([&out](
+    EngineId const& ID, seed_t configuredSeed, seed_t currentSeed,
+    bool frozen
+  ) {
+    writeCheckpointString(out, ID.moduleLabel);
+    writeCheckpointString(out, ID.instanceName);
+    writeCheckpointValue(out, static_cast<std::uint32_t>(ID.schedule));
+    writeCheckpointValue
+      (out, static_cast<std::uint8_t>(frozen? CheckpointFrozen: 0));
+    writeCheckpointValue(out, configuredSeed);
+    writeCheckpointValue(out, currentSeed);
+  }); // for all seeds
+  
+} // SeedMaster<SEED>::saveCheckpoint()
+
+
+//----------------------------------------------------------------------------
+template <typename SEED>
+std::string rndm::SeedMaster<SEED>::restoreCheckpoint(std::istream& in) {
+  using namespace details;
+  
+  char magic[sizeof(CheckpointMagic)];
+  if (!in.read(magic, sizeof(magic))
+    || !std::equal(magic, magic + sizeof(magic), CheckpointMagic))
+  {
+    throw art::Exception(art::errors::FileReadError)
+      << "SeedMaster: input is not a seed checkpoint\n";
+  }
+  auto const version = readCheckpointValue<std::uint32_t>(in);
+  if ((version < CheckpointOldestVersion) || (version > CheckpointVersion)) {
+    throw art::Exception(art::errors::Configuration)
+      << "SeedMaster: seed checkpoint version " << version
+      << " not supported (expected: " << CheckpointOldestVersion << " to "
+      << CheckpointVersion << ")\n";
+  }
+  auto const seedSize = readCheckpointValue<std::uint32_t>(in);
+  if (seedSize != sizeof(seed_t)) {
+    throw art::Exception(art::errors::Configuration)
+      << "SeedMaster: seed checkpoint has " << seedSize
+      << "-byte seeds, while " << sizeof(seed_t) << " are expected\n";
+  }
+  std::string const policyName = readCheckpointString(in);
+  if (policyName != policy_impl->getName()) {
+    throw art::Exception(art::errors::Configuration)
+      << "SeedMaster: seed checkpoint was written with policy '" << policyName
+      << "', but the current policy is '" << policy_impl->getName() << "'\n";
+  }
+  std::string label = readCheckpointString(in);
+  
+  std::istringstream policyState(readCheckpointString(in));
+  policy_impl->restoreState(policyState);
+  
+  map_type restoredConfigured, restoredCurrent;
+  auto const nEngines = readCheckpointValue<std::uint64_t>(in);
+  for (std::uint64_t iEngine = 0; iEngine < nEngines; ++iEngine) {
+    std::string moduleLabel = readCheckpointString(in);
+    std::string instanceName = readCheckpointString(in);
+    // version 1 predates replicated modules: all engines are on schedule 0
+    auto const schedule
+      = (version >= 2)? readCheckpointValue<std::uint32_t>(in): 0U;
+    auto const flags = readCheckpointValue<std::uint8_t>(in);
+    auto const configuredSeed = readCheckpointValue<seed_t>(in);
+    auto const currentSeed = readCheckpointValue<seed_t>(in);
+    
+    EngineId const ID(moduleLabel, instanceName, schedule); // global if no module
+    
+    // engines were written sorted: insertion at the end is constant time
+    if (configuredSeed != InvalidSeed)
+      restoredConfigured.emplace_hint(restoredConfigured.end(), ID, configuredSeed);
+    restoredCurrent.emplace_hint(restoredCurrent.end(), ID, currentSeed);
+    
+    if (flags & CheckpointFrozen) {
+      auto const iEngine = engineData.find(ID);
+      if (iEngine != engineData.end()) iEngine->second.freeze();
+    }
+  } // for
+  
+  configuredSeeds = std::move(restoredConfigured);
+  currentSeeds = std::move(restoredCurrent);
+  knownEventSeeds.clear();
+  updateHandles();
+  
+  if (verbosity > 0) {
+    mf::LogInfo("SeedMaster") << "Restored " << nEngines
+      << " engine seeds from checkpoint '" << label << "'";
+  }
+  return label;
+} // SeedMaster<SEED>::restoreCheckpoint()
+
+
+//----------------------------------------------------------------------------
+template <typename SEED> template <typename Op>
+void rndm::SeedMaster<SEED>::forEachSeed(Op op) const {
+  
+  // configuredSeeds and engineData keys are (almost) a subset of currentSeeds;
+  // all of them are sorted the same way, so we keep them in step
+  auto iConfigured = configuredSeeds.cbegin();
+  auto const cend = configuredSeeds.cend();
+  auto iEngine = engineData.cbegin();
+  auto const eend = engineData.cend();
+  
+  for (auto const& p: currentSeeds) {
+    EngineId const& ID = p.first;
+    
+    while ((iConfigured != cend) && (iConfigured->first < ID)) ++iConfigured;
+    while ((iEngine != eend) && (iEngine->first < ID)) ++iEngine;
+    
+    seed_t const configuredSeed
+      = ((iConfigured != cend) && (iConfigured->first == ID))
+      ? iConfigured->second: InvalidSeed;
+    bool const frozen = (iEngine != eend) && (iEngine->first == ID)
+      && iEngine->second.isFrozen();
+    
+    op(ID, configuredSeed, p.second, frozen);
+  } // for all seeds
+  
+} // SeedMaster<SEED>::forEachSeed()
+
+
 //----------------------------------------------------------------------------
 template <typename SEED>
 typename rndm::SeedMaster<SEED>::seed_t rndm::SeedMaster<SEED>::getSeed
@@ -614,7 +1442,9 @@ typename rndm::SeedMaster<SEED>::seed_t rndm::SeedMaster<SEED>::getSeed
   if (iSeed != configuredSeeds.end()) return iSeed->second;
 
   // Compute the seed.
-  seed = policy_impl->getSeed(id);
+  auto const iEngine = engineData.find(id);
+  seed = ((iEngine != engineData.end()) && iEngine->second.hasJumper())
+    ? policy_impl->getJumpingEngineSeed(id): policy_impl->getSeed(id);
   if (policy_impl->yieldsUniqueSeeds()) ensureUnique(id, seed);
   
   // Save the result.
@@ -637,17 +1467,19 @@ typename rndm::SeedMaster<SEED>::seed_t rndm::SeedMaster<SEED>::getEventSeed
   (EventData_t const& data, EngineId const& id)
 {
   // Check for an already computed seed.
-  typename map_type::iterator iSeed = knownEventSeeds.find(id);
+  map_type& eventSeeds = eventSeedsOf(data.schedule);
+  typename map_type::iterator iSeed = eventSeeds.find(id);
   seed_t seed = InvalidSeed;
-  if (iSeed != knownEventSeeds.end()) return iSeed->second;
+  if (iSeed != eventSeeds.end()) return iSeed->second;
 
   // Compute the seed.
   seed = policy_impl->getEventSeed(id, data);
   if ((seed != InvalidSeed) && policy_impl->yieldsUniqueSeeds())
-    ensureUnique(id, seed, knownEventSeeds);
+    ensureUnique(id, seed, eventSeeds);
+  if (collision_monitor) monitorEventSeed(id, seed, data);
     
   // Save the result.
-  knownEventSeeds[id] = seed;
+  eventSeeds[id] = seed;
   
   // for configured-seed policies, per-event seed is invalid;
   // in that case we don't expect to change the seed,
@@ -671,12 +1503,152 @@ typename rndm::SeedMaster<SEED>::seed_t rndm::SeedMaster<SEED>::getEventSeed
 
 //----------------------------------------------------------------------------
 template <typename SEED>
-inline void rndm::SeedMaster<SEED>::onNewEvent() {
-  // forget all we know about the current event
-  knownEventSeeds.clear();
+auto rndm::SeedMaster<SEED>::getSeedWords
+  (EngineId const& id, std::size_t nWords) -> SeedWords_t
+{
+  seed_t const seed = getSeed(id);
+  if (seed == InvalidSeed) return {};
+  return policy_impl->getSeedWords(id, seed, nWords);
+} // SeedMaster<SEED>::getSeedWords()
+
+
+template <typename SEED>
+auto rndm::SeedMaster<SEED>::getEventSeedWords
+  (EventData_t const& data, EngineId const& id, std::size_t nWords)
+  -> SeedWords_t
+{
+  seed_t const seed = getEventSeed(data, id);
+  if (seed == InvalidSeed) return {};
+  return policy_impl->getEventSeedWords(id, data, seed, nWords);
+} // SeedMaster<SEED>::getEventSeedWords()
+
+
+//----------------------------------------------------------------------------
+template <typename SEED>
+inline void rndm::SeedMaster<SEED>::onNewEvent
+  (ScheduleNumber_t schedule /* = 0 */)
+{
+  // forget all we know about the event this schedule was processing
+  if (schedule < knownEventSeeds.size()) knownEventSeeds[schedule].clear();
 } // SeedMaster<SEED>::onNewEvent()
 
 
+//----------------------------------------------------------------------------
+template <typename SEED>
+auto rndm::SeedMaster<SEED>::eventSeededEngines() const
+  -> std::vector<EngineId>
+{
+  std::vector<EngineId> IDs;
+  for (auto const& [ id, engineInfo ]: engineData) {
+    if (engineInfo.isFrozen() || engineInfo.hasJumper()) continue;
+    IDs.push_back(id);
+  }
+  return IDs;
+} // SeedMaster<SEED>::eventSeededEngines()
+
+
+template <typename SEED>
+auto rndm::SeedMaster<SEED>::computeEventSeeds
+  (EventData_t data, std::vector<EngineId> const& ids) const -> EventSeeds_t
+{
+  data.moduleType.clear();
+  
+  EventSeeds_t eventSeeds;
+  std::vector<std::pair<seed_t, EngineId const*>> validSeeds;
+  validSeeds.reserve(ids.size());
+  for (EngineId const& id: ids) {
+    data.moduleLabel = id.moduleLabel;
+    seed_t const seed = policy_impl->getEventSeed(id, data);
+    eventSeeds.emplace_hint(eventSeeds.end(), id, seed);
+    if (seed != InvalidSeed) validSeeds.emplace_back(seed, &id);
+  } // for
+  
+  if (!policy_impl->yieldsUniqueSeeds()) return eventSeeds;
+  
+  std::sort(validSeeds.begin(), validSeeds.end(),
+    [](auto const& a, auto const& b){ return a.first < b.first; });
+  auto const iClash = std::adjacent_find(validSeeds.begin(), validSeeds.end(),
+    [](auto const& a, auto const& b){ return a.first == b.first; });
+  if (iClash != validSeeds.end()) {
+    throw art::Exception(art::errors::LogicError)
+      << "NuRandomService::ensureUnique() seed: " << iClash->first
+      << " already used by module.instance: " << *(iClash->second) << "\n"
+      << "May not be reused by module.instance: "
+      << *(std::next(iClash)->second);
+  }
+  return eventSeeds;
+} // SeedMaster<SEED>::computeEventSeeds()
+
+
+template <typename SEED>
+void rndm::SeedMaster<SEED>::adoptEventSeeds
+  (EventSeeds_t&& eventSeeds, EventData_t const& data)
+{
+  map_type& known = eventSeedsOf(data.schedule);
+  known = std::move(eventSeeds);
+  
+  if (collision_monitor) {
+    for (auto const& [ id, seed ]: known) monitorEventSeed(id, seed, data);
+  }
+  
+  // both maps are sorted by engine ID: update the current seeds in one pass
+  // (invalid seeds do not replace current ones, as in `getEventSeed()`)
+  auto iCurrent = currentSeeds.begin();
+  for (auto const& [ id, seed ]: known) {
+    while ((iCurrent != currentSeeds.end()) && (iCurrent->first < id))
+      ++iCurrent;
+    if ((iCurrent != currentSeeds.end()) && (iCurrent->first == id)) {
+      if (seed != InvalidSeed) iCurrent->second = seed;
+    }
+    else iCurrent = std::next(currentSeeds.emplace_hint(iCurrent, id, seed));
+  } // for
+} // SeedMaster<SEED>::adoptEventSeeds()
+
+
+//----------------------------------------------------------------------------
+template <typename SEED>
+void rndm::SeedMaster<SEED>::monitorEventSeed
+  (EngineId const& id, seed_t seed, EventData_t const& data)
+{
+  if (seed == InvalidSeed) return; // not a per-event seed
+  auto const collision = collision_monitor->insert(seed, id, data);
+  if (!collision) return;
+  
+  auto const& prev = collision->previous;
+  mf::LogWarning("SeedMaster")
+    << "Per-event seed " << seed << " assigned to " << id << " in event "
+    << data.runNumber << ":" << data.subRunNumber << ":" << data.eventNumber
+    << " was already assigned to " << prev.engine << " in event "
+    << prev.event.run << ":" << prev.event.subRun << ":" << prev.event.event;
+} // SeedMaster<SEED>::monitorEventSeed()
+
+
+template <typename SEED>
+auto rndm::SeedMaster<SEED>::makeCollisionMonitor
+  (fhicl::ParameterSet const& pSet) -> std::unique_ptr<CollisionMonitor_t>
+{
+  fhicl::ParameterSet monitorPSet;
+  if (!pSet.get_if_present("seedCollisionMonitor", monitorPSet)) return {};
+  
+  typename CollisionMonitor_t::Config_t config;
+  config.filterBits
+    = monitorPSet.get<std::size_t>("filterBits", config.filterBits);
+  config.nHashes = monitorPSet.get<unsigned int>("hashes", config.nHashes);
+  config.generationSize
+    = monitorPSet.get<std::size_t>("generationSize", config.generationSize);
+  config.historySize
+    = monitorPSet.get<std::size_t>("historySize", config.historySize);
+  if ((config.filterBits == 0) || (config.nHashes == 0)
+    || (config.generationSize == 0) || (config.historySize == 0))
+  {
+    throw art::Exception(art::errors::Configuration)
+      << "SeedMaster: all the `seedCollisionMonitor` parameters must be"
+      " positive.\n";
+  }
+  return std::make_unique<CollisionMonitor_t>(config);
+} // SeedMaster<SEED>::makeCollisionMonitor()
+
+
 //----------------------------------------------------------------------------
 template <typename SEED>
 void rndm::SeedMaster<SEED>::setPolicy(std::string policyName) {
@@ -707,4 +1679,42 @@ void rndm::SeedMaster<SEED>::ensureUnique
 } // SeedMaster<SEED>::ensureUnique()
 
 
+template <typename SEED>
+void rndm::SeedMaster<SEED>::ensureUnique
+  (std::vector<std::pair<EngineId const*, seed_t>> const& newSeeds) const
+{
+  if (newSeeds.empty()) return;
+  
+  // sort all the seeds, known ones first on ties, and look for neighbours
+  struct SeedRecord_t {
+    seed_t seed;
+    bool isNew;
+    EngineId const* id;
+    bool operator< (SeedRecord_t const& other) const
+      {
+        return (seed != other.seed)? (seed < other.seed): (isNew < other.isNew);
+      }
+  }; // SeedRecord_t
+  
+  std::vector<SeedRecord_t> allSeeds;
+  allSeeds.reserve(configuredSeeds.size() + newSeeds.size());
+  for (auto const& [ id, seed ]: configuredSeeds)
+    allSeeds.push_back({ seed, false, &id });
+  for (auto const& [ id, seed ]: newSeeds)
+    allSeeds.push_back({ seed, true, id });
+  std::sort(allSeeds.begin(), allSeeds.end());
+  
+  auto const iClash = std::adjacent_find(allSeeds.begin(), allSeeds.end(),
+    [](SeedRecord_t const& a, SeedRecord_t const& b)
+      { return (a.seed == b.seed) && !(*a.id == *b.id); }
+    );
+  if (iClash == allSeeds.end()) return;
+  
+  throw art::Exception(art::errors::LogicError)
+    << "NuRandomService::ensureUnique() seed: " << iClash->seed
+    << " already used by module.instance: " << *(iClash->id) << "\n"
+    << "May not be reused by module.instance: " << *(std::next(iClash)->id);
+} // SeedMaster<SEED>::ensureUnique(vector)
+
+
 #endif // NURANDOM_RANDOMUTILS_PROVIDERS_SEEDMASTER_H
@@ -0,0 +1,141 @@
+/**
+ * @file   SeedWords.h
+ * @brief  Utilities to create seeds made of multiple words
+ * @date   October 16th, 2026
+ * @see    RandomSeedPolicyBase.h
+ *
+ * Some random engines can be initialized with more than one seed word
+ * (e.g. CLHEP engines via `setSeeds(long const*, int)`). These utilities
+ * expand a single seed, or a string hash, into such a sequence of words.
+ * Each word is a positive value of up to `SeedWordBits` bits, never zero
+ * (CLHEP seed arrays are terminated by a zero value).
+ */
+
+#ifndef NURANDOM_RANDOMUTILS_PROVIDERS_SEEDWORDS_H
+#define NURANDOM_RANDOMUTILS_PROVIDERS_SEEDWORDS_H 1
+
+// C/C++ standard libraries
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <string>
+#include <vector>
+
+
+namespace rndm {
+
+  namespace details {
+
+    /// Number of significant bits of each seed word.
+    constexpr unsigned int SeedWordBits = 31;
+
+
+    /**
+     * @brief SplitMix64 generator (Steele, Lea, Flood, 2014)
+     *
+     * A fast generator with a 64-bit state, whose output is a good hash of a
+     * Weyl sequence. It is used here to expand a seed into several words.
+     */
+    class SplitMix64 {
+        public:
+      /// Increment of the Weyl sequence (golden ratio)
+      static constexpr std::uint64_t Gamma = 0x9e3779b97f4a7c15ULL;
+
+      /// Constructor: starts the sequence from the specified state
+      explicit SplitMix64(std::uint64_t seed): state(seed) {}
+
+      /// Returns the next number of the sequence
+      std::uint64_t operator() () { return mix(state += Gamma); }
+
+      /// Mixing (finalization) function of SplitMix64
+      static constexpr std::uint64_t mix(std::uint64_t z)
+        {
+          z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+          z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+          return z ^ (z >> 31);
+        }
+
+        private:
+      std::uint64_t state; ///< current state of the sequence
+    }; // class SplitMix64
+
+
+    /// 64-bit FNV-1a hash of a string, with an optional different basis
+    inline std::uint64_t FNV1a64
+      (std::string const& s, std::uint64_t basis = 0xcbf29ce484222325ULL)
+      {
+        std::uint64_t h = basis;
+        for (unsigned char c: s) { h ^= c; h *= 0x100000001b3ULL; }
+        return h;
+      }
+
+
+    /// Converts a 64-bit random number into a valid seed word
+    template <typename SEED>
+    SEED makeSeedWord(std::uint64_t bits)
+      {
+        SEED const word = static_cast<SEED>(bits >> (64 - SeedWordBits));
+        return (word == 0)? SEED(1): word;
+      }
+
+
+    /**
+     * @brief Expands a seed into `nWords` seed words
+     * @tparam SEED type of seed and seed word
+     * @param seed the seed to be expanded (becomes the first word)
+     * @param nWords number of words
+     * @return a sequence of `nWords` words
+     *
+     * The first word is the seed itself, so that different seeds yield
+     * different sequences. The other words are extracted from a SplitMix64
+     * sequence started from the seed.
+     */
+    template <typename SEED>
+    std::vector<SEED> expandSeedWords(SEED seed, std::size_t nWords)
+      {
+        std::vector<SEED> words;
+        if (nWords == 0) return words;
+        words.reserve(nWords);
+        words.push_back(seed);
+        SplitMix64 gen(static_cast<std::uint64_t>(seed));
+        while (words.size() < nWords) words.push_back(makeSeedWord<SEED>(gen()));
+        return words;
+      } // expandSeedWords()
+
+
+    /**
+     * @brief Creates seed words from a string, with 128 bits of hash
+     * @tparam SEED type of seed and seed word
+     * @param seed the first word
+     * @param info the string to be hashed into the other words
+     * @param nWords number of words
+     * @return a sequence of `nWords` words
+     *
+     * The words following the first are extracted from two SplitMix64
+     * sequences started from two independent 64-bit hashes of `info`.
+     * Different strings will then yield different sequences with a
+     * probability driven by 128 bits of hash (for enough words), rather than
+     * by the size of a single seed.
+     */
+    template <typename SEED>
+    std::vector<SEED> seedWordsFromHash
+      (SEED seed, std::string const& info, std::size_t nWords)
+      {
+        std::vector<SEED> words;
+        if (nWords == 0) return words;
+        words.reserve(nWords);
+        words.push_back(seed);
+        SplitMix64 gen1(FNV1a64(info));
+        SplitMix64 gen2(FNV1a64(info, SplitMix64::mix(0x6e7552616e646f6dULL)));
+        while (words.size() < nWords) {
+          std::uint64_t const r2 = gen2();
+          words.push_back(makeSeedWord<SEED>(gen1() ^ ((r2 << 17) | (r2 >> 47))));
+        }
+        return words;
+      } // seedWordsFromHash()
+
+  } // namespace details
+
+} // namespace rndm
+
+
+#endif // NURANDOM_RANDOMUTILS_PROVIDERS_SEEDWORDS_H
@@ -0,0 +1,232 @@
+/**
+ * @file   SplitRandomPolicy.h
+ * @brief  Implementation of the random seed assignment policy "splitRandom"
+ * @date   October 16th, 2026
+ * @see    SeedMaster.h RandomPolicy.h
+ *
+ * No code in this files is directly serviceable.
+ * Documentation is up to date though.
+ */
+
+#ifndef NURANDOM_RANDOMUTILS_PROVIDERS_SPLITRANDOMPOLICY_H
+#define NURANDOM_RANDOMUTILS_PROVIDERS_SPLITRANDOMPOLICY_H 1
+
+// C/C++ standard libraries
+#include <chrono> // std::steady_clock
+#include <cstdint> // std::uint64_t
+#include <ostream>
+#include <random> // std::random_device
+#include <type_traits> // std::make_unsigned_t<>
+
+// POSIX
+#include <unistd.h> // getpid()
+#if defined(__linux__)
+#  include <sys/random.h> // getrandom()
+#endif // __linux__
+
+// From art and its tool chain
+#include "fhiclcpp/ParameterSet.h"
+#include "canvas/Utilities/Exception.h"
+
+// Some helper classes
+#include "nurandom/RandomUtils/Providers/RandomSeedPolicyBase.h"
+#include "nurandom/RandomUtils/Providers/CheckpointIO.h"
+#include "nurandom/RandomUtils/Providers/SeedWords.h" // SplitMix64
+
+
+namespace rndm {
+
+  namespace details {
+
+    /// Returns the upper 64 bits of the 128-bit product `a * b`.
+    constexpr std::uint64_t mulHigh64(std::uint64_t a, std::uint64_t b)
+      {
+        std::uint64_t const aLow = a & 0xffffffffULL, aHigh = a >> 32;
+        std::uint64_t const bLow = b & 0xffffffffULL, bHigh = b >> 32;
+        std::uint64_t const low = aLow * bLow;
+        std::uint64_t const mid1 = aHigh * bLow + (low >> 32);
+        std::uint64_t const mid2 = aLow * bHigh + (mid1 & 0xffffffffULL);
+        return aHigh * bHigh + (mid1 >> 32) + (mid2 >> 32);
+      } // mulHigh64()
+
+
+    /// Returns 64 bits of entropy from the operating system.
+    inline std::uint64_t systemEntropy64()
+      {
+        std::uint64_t bits = 0;
+#if defined(__linux__)
+        if (::getrandom(&bits, sizeof(bits), 0) == sizeof(bits)) return bits;
+#endif // __linux__
+        std::random_device device;
+        bits = (std::uint64_t(device()) << 32) ^ std::uint64_t(device());
+        // in case the random device is deterministic, add something unique
+        bits ^= SplitMix64::mix(static_cast<std::uint64_t>
+          (std::chrono::steady_clock::now().time_since_epoch().count()));
+        bits ^= SplitMix64::mix(static_cast<std::uint64_t>(::getpid()) << 32);
+        return bits;
+      } // systemEntropy64()
+
+
+    /** ************************************************************************
+     * @brief Implementation of the "splitRandom" policy
+     *
+     * Like the `random` policy, this policy extracts seeds randomly, between
+     * 1 and `maxSeed`, both extremes included. Unlike it, the sequence is
+     * fully specified and does not depend on the standard library:
+     *
+     * * the generator is SplitMix64, whose state is a Weyl sequence
+     *   `masterSeed + n * Gamma`: the sequence of job `nJob` starts at
+     *   `n = nJob * 2^32`, jumping there in constant time, so that jobs with
+     *   the same master seed and different job numbers use disjoint
+     *   subsequences (as long as each job takes fewer than 2^32 seeds);
+     * * the 64-bit output is mapped into the seed range with Lemire's
+     *   multiply-and-shift reduction.
+     *
+     * When `masterSeed` is not specified, it is taken from the entropy source
+     * of the operating system (`getrandom()`), so that jobs started at the
+     * same time still get independent sequences.
+     */
+    template <typename SEED>
+    class SplitRandomPolicy: public RandomSeedPolicyBase<SEED> {
+        public:
+      using base_t = RandomSeedPolicyBase<SEED>;
+      using this_t = SplitRandomPolicy<SEED>;
+      using seed_t = typename base_t::seed_t;
+
+      /// Number of draws reserved to each job (log2)
+      static constexpr unsigned int JobStreamBits = 32;
+
+      /// Configures from a parameter set
+      /// @see configure()
+      SplitRandomPolicy(fhicl::ParameterSet const& pset): base_t("splitRandom")
+        { this_t::configure(pset); }
+
+
+      /**
+       * @brief Configure this policy
+       * @param pset the parameter set for the configuration
+       *
+       * Parameters:
+       * - *masterSeed* (unsigned 64-bit integer, optional): the seed of the
+       *   seed generator; by default, it's taken from the operating system
+       *   entropy source
+       * - *nJob* (unsigned integer, default: 0): the number of this job,
+       *   selecting its own subsequence of the seed generator
+       * - *maxSeed* (unsigned integer, default: 900000000): the largest seed
+       *   to be delivered
+       */
+      virtual void configure(fhicl::ParameterSet const& pset) override;
+
+      /// Prints the details of the configuration of the random generator
+      virtual void print(std::ostream& out) const override;
+
+      /// Saves the position in the seed sequence
+      virtual void saveState(std::ostream& out) const override;
+
+      /// Restores the position in the seed sequence
+      virtual void restoreState(std::istream& in) override;
+
+
+        private:
+      std::uint64_t master_seed = 0; ///< seed of the whole sequence
+      std::uint64_t nJob = 0; ///< number of the job (subsequence)
+      std::uint64_t nDrawn = 0; ///< seeds drawn by this job so far
+      seed_t max_seed = 1; ///< largest seed to be delivered
+      bool fromEntropy = false; ///< whether the master seed is from OS
+
+      /// Returns the next 64-bit number of the subsequence of this job
+      std::uint64_t next();
+
+      /// Extracts a random seed
+      virtual seed_t createSeed(SeedMasterHelper::EngineId const&) override;
+
+    }; // class SplitRandomPolicy<>
+
+
+    template <typename SEED>
+    void SplitRandomPolicy<SEED>::configure(fhicl::ParameterSet const& pset) {
+      constexpr seed_t MagicMaxSeed = 900000000;
+
+      fromEntropy
+        = !pset.get_if_present<std::uint64_t>("masterSeed", master_seed);
+      if (fromEntropy) master_seed = systemEntropy64();
+
+      nJob = pset.get<std::uint64_t>("nJob", 0);
+      if (nJob >= (std::uint64_t(1) << (64 - JobStreamBits))) {
+        throw art::Exception(art::errors::Configuration)
+          << "splitRandom policy: job number " << nJob
+          << " is too large (must be smaller than 2^"
+          << (64 - JobStreamBits) << ")\n";
+      }
+
+      max_seed = pset.get<seed_t>("maxSeed", MagicMaxSeed);
+      if (max_seed < 1) {
+        throw art::Exception(art::errors::Configuration)
+          << "splitRandom policy: maxSeed (" << max_seed
+          << ") must be at least 1\n";
+      }
+
+      nDrawn = 0;
+    } // SplitRandomPolicy<SEED>::configure()
+
+
+    template <typename SEED>
+    std::uint64_t SplitRandomPolicy<SEED>::next() {
+      if (nDrawn >= (std::uint64_t(1) << JobStreamBits)) {
+        throw art::Exception(art::errors::LogicError)
+          << "splitRandom policy: job " << nJob << " exhausted its "
+          << (std::uint64_t(1) << JobStreamBits) << " seeds\n";
+      }
+      // jump ahead: the state after n steps is master_seed + n * Gamma
+      std::uint64_t const position = (nJob << JobStreamBits) + nDrawn++;
+      return SplitMix64::mix(master_seed + (position + 1) * SplitMix64::Gamma);
+    } // SplitRandomPolicy<SEED>::next()
+
+
+    template <typename SEED>
+    auto SplitRandomPolicy<SEED>::createSeed(SeedMasterHelper::EngineId const&)
+      -> seed_t
+    {
+      // Lemire's reduction of a 64-bit number into [ 0 ; max_seed [
+      using useed_t = std::make_unsigned_t<seed_t>;
+      return static_cast<seed_t>
+        (mulHigh64(next(), static_cast<useed_t>(max_seed))) + 1;
+    } // SplitRandomPolicy<SEED>::createSeed()
+
+
+    /// Prints the details of the configuration of the random generator
+    template <typename SEED>
+    void SplitRandomPolicy<SEED>::print(std::ostream& out) const {
+      base_t::print(out);
+      out
+        << "\n  master seed: " << master_seed
+          << (fromEntropy? " (from system entropy)": "")
+        << "\n  job number:  " << nJob
+        << "\n  seed within: [ 1 ; " << max_seed << " ]"
+        ;
+    } // SplitRandomPolicy<SEED>::print()
+
+
+    template <typename SEED>
+    void SplitRandomPolicy<SEED>::saveState(std::ostream& out) const {
+      writeCheckpointValue(out, master_seed);
+      writeCheckpointValue(out, nJob);
+      writeCheckpointValue(out, nDrawn);
+    } // SplitRandomPolicy<SEED>::saveState()
+
+
+    template <typename SEED>
+    void SplitRandomPolicy<SEED>::restoreState(std::istream& in) {
+      // the master seed might have been taken from the system
+      master_seed = readCheckpointValue<std::uint64_t>(in);
+      nJob = readCheckpointValue<std::uint64_t>(in);
+      nDrawn = readCheckpointValue<std::uint64_t>(in);
+    } // SplitRandomPolicy<SEED>::restoreState()
+
+
+  } // namespace details
+
+} // namespace rndm
+
+
+#endif // NURANDOM_RANDOMUTILS_PROVIDERS_SPLITRANDOMPOLICY_H
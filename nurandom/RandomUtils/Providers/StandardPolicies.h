@@ -14,7 +14,12 @@
 #define NURANDOM_RANDOMUTILS_PROVIDERS_STANDARDPOLICIES_H 1
 
 // C/C++ standard libraries
+#include <array>
+#include <chrono>
+#include <limits> // std::numeric_limits<>
+#include <memory> // std::unique_ptr<>
 #include <string>
+#include <vector>
 #include <ostream> // std::endl
 
 // From art and its tool chain
@@ -24,6 +29,8 @@
 // Some helper classes
 #include "nurandom/RandomUtils/Providers/RandomSeedPolicyBase.h"
 #include "nurandom/RandomUtils/Providers/EngineId.h"
+#include "nurandom/RandomUtils/Providers/CheckpointIO.h"
+#include "nurandom/RandomUtils/Providers/JobSlotLease.h"
 
 
 namespace rndm {
@@ -72,6 +79,14 @@ namespace rndm {
       /// Prints the configuration of this policy
       virtual void print(std::ostream& out) const override;
       
+      /// Saves the next seed to be delivered
+      virtual void saveState(std::ostream& out) const override
+        { writeCheckpointValue(out, next_seed); }
+      
+      /// Restores the next seed to be delivered
+      virtual void restoreState(std::istream& in) override
+        { next_seed = readCheckpointValue<seed_t>(in); }
+      
         protected:
       seed_t first_seed;
       seed_t next_seed; ///< next seed delivered
@@ -128,10 +143,23 @@ namespace rndm {
        * 
        * Parameters:
        * - *nJob* (unsigned integer): the number of this job; the first seed
+       * - *jobSlotLease* (table, alternative to *nJob*): the job number is
+       *   leased from a file shared by all the jobs (see `JobSlotLease`):
+       *   - *file* (string, mandatory): path of the lease file
+       *   - *maxJobs* (unsigned integer, mandatory): number of job slots
+       *   - *firstJob* (unsigned integer, default: 0): job number of the first
+       *     slot
+       *   - *leaseTimeout* (unsigned integer, default: 0): duration of the
+       *     lease in seconds for jobs on other hosts (`0`: until the job
+       *     ends); jobs on this host hold their lease while they run
        * - *checkRange* (boolean, default: true): whether to verify that each
        *   seed is within the expected range
        * - *maxUniqueEngines* (unsigned integer, mandatory) the maximum number
        *   on seeds we expect to create
+       *
+       * The leased job slot is held until the policy is destroyed, at the end
+       * of the job. Slots of jobs from this host which ended without releasing
+       * them are reclaimed automatically.
        */
       virtual void configure(fhicl::ParameterSet const& pset) override
         {
@@ -143,11 +171,23 @@ namespace rndm {
       /// Prints the configuration of this policy
       virtual void print(std::ostream& out) const override;
       
+      /// Saves the next seed to be delivered
+      virtual void saveState(std::ostream& out) const override
+        { writeCheckpointValue(out, next_seed); }
+      
+      /// Restores the next seed to be delivered
+      virtual void restoreState(std::istream& in) override
+        { next_seed = readCheckpointValue<seed_t>(in); }
+      
         protected:
       seed_t first_seed; ///< base seed
       seed_t next_seed; ///< next seed delivered
       unsigned int nSeedsPerJob;
       
+      /// Lease of the job slot (if the job number is leased).
+      std::unique_ptr<JobSlotLease> jobSlotLease;
+      seed_t nJob; ///< job number
+      
       /// Returns the next random number
       virtual seed_t createSeed(SeedMasterHelper::EngineId const&) override
         { return next_seed++; }
@@ -161,8 +201,29 @@ namespace rndm {
     void LinearMappingPolicy<SEED>::static_configure
       (fhicl::ParameterSet const& pset)
     {
+      fhicl::ParameterSet leaseConfig;
+      if (pset.get_if_present("jobSlotLease", leaseConfig)) {
+        if (pset.has_key("nJob")) {
+          throw art::Exception(art::errors::Configuration)
+            << "linearMapping policy: specify either 'nJob' or 'jobSlotLease',"
+            " not both.\n";
+        }
+        jobSlotLease.reset(); // release a slot held from a previous configuration
+        jobSlotLease = std::make_unique<JobSlotLease>(
+          leaseConfig.get<std::string>("file"),
+          leaseConfig.get<unsigned int>("maxJobs"),
+          std::chrono::seconds
+            { leaseConfig.get<unsigned int>("leaseTimeout", 0U) }
+          );
+        first_seed
+          = leaseConfig.get<seed_t>("firstJob", 0) + jobSlotLease->slot();
+        mf::LogInfo("SeedMaster")
+          << "linearMapping: leased job slot #" << jobSlotLease->slot()
+          << " from '" << jobSlotLease->leaseFile() << "' (job number "
+          << first_seed << ")";
+      }
       // this code is for legacy support, and it could disappear in the future
-      if (!pset.get_if_present<seed_t>("nJob", first_seed)) {
+      else if (!pset.get_if_present<seed_t>("nJob", first_seed)) {
         if (!pset.get_if_present<seed_t>("baseSeed", first_seed)) {
           // this is going to fail; I am doing this just to get
           // the more appropriate error message possible
@@ -178,6 +239,7 @@ namespace rndm {
         }
       }
     //  first_seed = pset.get<seed_t>("nJob");
+      nJob = first_seed;
       nSeedsPerJob = pset.get<seed_t>("maxUniqueEngines");
       first_seed *= nSeedsPerJob;
       ++first_seed; // we don't want 0 as a seed
@@ -194,10 +256,161 @@ namespace rndm {
       out
         << "\n  first seed:    " << first_seed
         << "\n  seeds per job: " << nSeedsPerJob;
+      if (jobSlotLease) {
+        out << "\n  job number:    " << nJob << " (slot #"
+          << jobSlotLease->slot() << " leased from '"
+          << jobSlotLease->leaseFile() << "')";
+      }
     } // LinearMappingPolicy<SEED>::print()
     
     
     
+    /** ************************************************************************
+     * @brief Implementation of the "gridMapping" policy
+     * @see LinearMappingPolicy
+     *
+     * This is a `linearMapping` policy where the job number is not given
+     * directly, but as a position in a grid of jobs (e.g. campaign, submission,
+     * node, process). The job number is the position in the grid in
+     * mixed-radix notation, with the first level being the most significant.
+     */
+    template <typename SEED>
+    class GridMappingPolicy: public CheckedRangePolicy<SEED> {
+        public:
+      using base_t = CheckedRangePolicy<SEED>;
+      using this_t = GridMappingPolicy<SEED>;
+      using seed_t = typename base_t::seed_t;
+      
+      /// A level of the grid: index of this job, and number of indices.
+      using Level_t = std::array<seed_t, 2U>;
+      
+      /// Configures from a parameter set
+      /// @see configure()
+      GridMappingPolicy(fhicl::ParameterSet const& pset):
+        base_t("gridMapping")
+        { this_t::configure(pset); }
+      
+      
+      /**
+       * @brief Configure this policy
+       * @param pset the parameter set for the configuration
+       * 
+       * Parameters:
+       * - *grid* (list of `[ index, extent ]` pairs, mandatory): position of
+       *   this job in each level of the grid (`index`), and size of that level
+       *   (`extent`); the first level is the outermost one
+       * - *maxUniqueEngines* (unsigned integer, mandatory) the maximum number
+       *   on seeds we expect to create in each job
+       * - *maxSeed* (unsigned integer, default: largest seed value): the
+       *   largest seed allowed; the whole grid must fit below it
+       * - *checkRange* (boolean, default: true): whether to verify that each
+       *   seed is within the expected range
+       * 
+       * The configuration is rejected if the seeds of the full grid do not fit
+       * in the seed range, even if the seeds of this job would.
+       */
+      virtual void configure(fhicl::ParameterSet const& pset) override
+        {
+          base_t::range_check.SetConfigLabels("", "", "checkRange");
+          base_t::configure(pset);
+          static_configure(pset);
+        }
+      
+      /// Prints the configuration of this policy
+      virtual void print(std::ostream& out) const override;
+      
+      /// Saves the next seed to be delivered
+      virtual void saveState(std::ostream& out) const override
+        { writeCheckpointValue(out, next_seed); }
+      
+      /// Restores the next seed to be delivered
+      virtual void restoreState(std::istream& in) override
+        { next_seed = readCheckpointValue<seed_t>(in); }
+      
+        protected:
+      std::vector<Level_t> grid; ///< position of this job in the grid
+      seed_t nJob; ///< job number (position in the flattened grid)
+      seed_t nJobs; ///< total number of jobs in the grid
+      seed_t first_seed; ///< base seed
+      seed_t next_seed; ///< next seed delivered
+      seed_t nSeedsPerJob;
+      
+      /// Returns the next random number
+      virtual seed_t createSeed(SeedMasterHelper::EngineId const&) override
+        { return next_seed++; }
+      
+      void static_configure(fhicl::ParameterSet const& pset);
+      
+    }; // class GridMappingPolicy<>
+    
+    
+    template <typename SEED>
+    void GridMappingPolicy<SEED>::static_configure
+      (fhicl::ParameterSet const& pset)
+    {
+      grid = pset.get<std::vector<Level_t>>("grid");
+      nSeedsPerJob = pset.get<seed_t>("maxUniqueEngines");
+      seed_t const maxSeed
+        = pset.get<seed_t>("maxSeed", std::numeric_limits<seed_t>::max());
+      
+      if (grid.empty()) {
+        throw art::Exception(art::errors::Configuration)
+          << "gridMapping policy: 'grid' needs at least one level.\n";
+      }
+      if (nSeedsPerJob < 1) {
+        throw art::Exception(art::errors::Configuration)
+          << "gridMapping policy: 'maxUniqueEngines' must be at least 1.\n";
+      }
+      
+      // flatten the grid, checking that its full extent fits in the seed range
+      // (seeds go from 1 to nJobs * nSeedsPerJob)
+      nJob = 0;
+      nJobs = 1;
+      for (std::size_t iLevel = 0; iLevel < grid.size(); ++iLevel) {
+        auto const [ index, extent ] = grid[iLevel];
+        if ((extent < 1) || (index < 0) || (index >= extent)) {
+          throw art::Exception(art::errors::Configuration)
+            << "gridMapping policy: invalid grid level #" << iLevel
+            << ": index " << index << " is not within [ 0 ; " << extent
+            << " [\n";
+        }
+        if (nJobs > maxSeed / extent) {
+          throw art::Exception(art::errors::Configuration)
+            << "gridMapping policy: the grid has more than " << maxSeed
+            << " jobs already at level #" << iLevel << "\n";
+        }
+        nJob = nJob * extent + index;
+        nJobs *= extent;
+      } // for levels
+      if (nJobs > (maxSeed - 1) / nSeedsPerJob) {
+        throw art::Exception(art::errors::Configuration)
+          << "gridMapping policy: " << nJobs << " jobs with "
+          << nSeedsPerJob << " seeds each do not fit within the largest seed ("
+          << maxSeed << ")\n";
+      }
+      
+      first_seed = nJob * nSeedsPerJob + 1; // we don't want 0 as a seed
+      next_seed = first_seed;
+      base_t::range_check.SetBaseSeed(first_seed);
+      base_t::range_check.SetNSeeds(nSeedsPerJob);
+      base_t::CheckRangeConfiguration();
+    } // GridMappingPolicy<SEED>::static_configure()
+    
+    
+    template <typename SEED>
+    void GridMappingPolicy<SEED>::print(std::ostream& out) const {
+      base_t::print(out);
+      out << "\n  grid position: [";
+      for (Level_t const& level: grid)
+        out << " " << level[0] << "/" << level[1];
+      out
+        << " ] (job " << nJob << " of " << nJobs << ")"
+        << "\n  first seed:    " << first_seed
+        << "\n  seeds per job: " << nSeedsPerJob;
+    } // GridMappingPolicy<SEED>::print()
+    
+    
+    
     /** ************************************************************************
      * @brief Implementation of the "preDefinedSeed" policy
      *
@@ -322,9 +535,13 @@ namespace rndm {
         protected:
       seed_t base_seed;
       
-      /// Returns the seed stored in the parameter set
+      /// Returns the seed from the offset stored in the parameter set
       virtual seed_t createSeed(SeedMasterHelper::EngineId const& id) override
-        { return base_seed + base_t::getInstanceSeed(id); }
+        { return instanceSeed(base_t::getInstanceSeed(id)); }
+      
+      /// Returns the seed for an engine with the specified offset
+      virtual seed_t instanceSeed(seed_t offset) const override
+        { return base_seed + offset; }
       
       void static_configure(fhicl::ParameterSet const&);
       
@@ -0,0 +1,154 @@
+/**
+ * @file   CompareEngineFingerprints.cc
+ * @brief  Finds where two jobs start to use random engines differently
+ * @date   October 16th, 2026
+ * @see    nurandom/RandomUtils/Providers/EngineFingerprints.h
+ *
+ * This program does not depend on art. It compares two files of engine state
+ * hashes, written by `NuRandomService` with the `engineFingerprints`
+ * configuration parameter, and reports the first event and engine where the
+ * two jobs differ.
+ *
+ * Usage:
+ *
+ *     CompareEngineFingerprints FileA FileB [--bisect]
+ *
+ * Options:
+ * * `--bisect`: read only a logarithmic number of records, relying on the
+ *   hash of the whole sequence stored in each record; by default, the files
+ *   are compared record by record from the start
+ *
+ * The two jobs are expected to process the same events with the same modules,
+ * on a single schedule: with more schedules, the order of the records depends
+ * on the processing order, which is not reproducible.
+ *
+ * The program exits with code 0 if the files are equivalent, 1 if they
+ * differ and 2 on errors.
+ */
+
+// nurandom libraries
+#include "nurandom/RandomUtils/Providers/EngineFingerprints.h"
+
+// framework libraries
+#include "canvas/Utilities/Exception.h"
+
+// C/C++ standard libraries
+#include <iomanip> // std::setw(), std::setfill()
+#include <iostream>
+#include <optional>
+#include <stdexcept> // std::runtime_error
+#include <string>
+
+
+namespace {
+
+  using rndm::NuRandomServiceHelper::EngineFingerprintReader;
+  using Record_t = EngineFingerprintReader::Record_t;
+
+  //----------------------------------------------------------------------------
+  //--- program configuration
+  //---
+  struct Config_t {
+    std::string firstPath;
+    std::string secondPath;
+    bool bisect = false;
+  }; // Config_t
+
+
+  /// Error in the command line arguments.
+  struct UsageError: std::runtime_error { using std::runtime_error::runtime_error; };
+
+
+  /// Parses the command line
+  Config_t ParseCommandLine(int argc, char const** argv) {
+    Config_t config;
+    for (int iParam = 1; iParam < argc; ++iParam) {
+      std::string const param = argv[iParam];
+      if (param == "--bisect") config.bisect = true;
+      else if (param.substr(0, 2) == "--")
+        throw UsageError("unknown option: " + param);
+      else if (config.firstPath.empty()) config.firstPath = param;
+      else if (config.secondPath.empty()) config.secondPath = param;
+      else throw UsageError("unexpected argument: '" + param + "'");
+    } // for
+
+    if (config.secondPath.empty())
+      throw UsageError("please specify two fingerprint files");
+    return config;
+  } // ParseCommandLine()
+
+
+  void PrintUsage(char const* programName) {
+    std::cerr << "Usage: " << programName << " FileA FileB [--bisect]"
+      "\n  --bisect    find the first difference by bisection"
+      << std::endl;
+  } // PrintUsage()
+
+
+  //----------------------------------------------------------------------------
+  /// Prints the content of a record, if present.
+  void PrintRecord(
+    std::ostream& out, EngineFingerprintReader const& file,
+    std::optional<Record_t> const& record
+  ) {
+    out << "  " << file.path() << ": ";
+    if (!record) {
+      out << "(no more records)\n";
+      return;
+    }
+    out << "event " << record->run << ":" << record->subRun << ":"
+      << record->event << ", engine '" << file.engineName(record->engine)
+      << "', state hash 0x" << std::hex << std::setfill('0') << std::setw(16)
+      << record->hash << std::dec << std::setfill(' ') << "\n";
+  } // PrintRecord()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  Config_t config;
+  try {
+    config = ParseCommandLine(argc, argv);
+  }
+  catch (UsageError const& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    PrintUsage(argv[0]);
+    return 2;
+  }
+
+  try {
+    EngineFingerprintReader first(config.firstPath), second(config.secondPath);
+    for (EngineFingerprintReader const* file: { &first, &second }) {
+      std::cout << "'" << file->path() << "': " << file->nRecords()
+        << " records";
+      if (!file->isComplete()) std::cout << " (incomplete: no engine names)";
+      std::cout << std::endl;
+    } // for
+
+    auto const divergence = config.bisect
+      ? bisectFirstDivergence(first, second)
+      : findFirstDivergence(first, second);
+
+    if (!divergence) {
+      std::cout << "The two files are equivalent." << std::endl;
+      return 0;
+    }
+
+    std::cout << "First difference at record #" << divergence->index << ":\n";
+    PrintRecord(std::cout, first, divergence->first);
+    PrintRecord(std::cout, second, divergence->second);
+    if (divergence->index > 0) {
+      std::cout << "Last common record:\n";
+      PrintRecord(std::cout, first, first.record(divergence->index - 1));
+    }
+    std::cout << std::flush;
+    return 1;
+  }
+  catch (art::Exception const& e) {
+    std::cerr << e.what() << std::endl;
+    return 2;
+  }
+
+} // main()
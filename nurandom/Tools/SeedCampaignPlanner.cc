@@ -0,0 +1,550 @@
+/**
+ * @file   SeedCampaignPlanner.cc
+ * @brief  Generates all the seeds of a production campaign and finds clashes
+ * @date   October 16th, 2026
+ * @see    nurandom/RandomUtils/Providers/PolicyFactory.h
+ *
+ * This program does not depend on art. Given the configuration of
+ * `NuRandomService`, a range of job indices and a list of engines, it
+ * generates the seed that each engine would get in each job of the campaign,
+ * and it verifies that all of them are different.
+ *
+ * Usage:
+ *
+ *     SeedCampaignPlanner ConfigFile --jobs First-Last --engines Engines [options]
+ *
+ * The configuration file is looked up in `FHICL_FILE_PATH`, like _art_ does.
+ *
+ * Options:
+ * * `--jobs` _First_`-`_Last_: range of job indices (both included; required)
+ * * `--engines` _Module[.Instance][,...]_: engines of each job; can be
+ *   repeated
+ * * `--engineFile` _Path_: file with one engine (_Module[.Instance]_) per
+ *   line; empty lines and lines starting with `#` are ignored
+ * * `--configKey` _Key_: where the `NuRandomService` configuration is in the
+ *   configuration file (default: `services.NuRandomService`; empty: the whole
+ *   file)
+ * * `--jobParameter` _Name_: policy parameter set to the job index in each
+ *   job (default: `nJob` for `linearMapping` and `splitRandom`, `masterSeed`
+ *   for `random`; for the other policies, all the jobs have the same
+ *   configuration unless this option is specified)
+ * * `--maxSeedsInMemory` _N_: seeds kept in memory at once (default: 2^24);
+ *   beyond that, sorted blocks of seeds are written into temporary files
+ * * `--tmpDir` _Path_: directory for the temporary files (default: `.`)
+ * * `--threads` _N_: threads used to sort the seeds (default: all available)
+ * * `--maxReport` _N_: seed clashes printed in detail (default: 20)
+ *
+ * The seeds are stored as records of 16 bytes, sorted in blocks that fit the
+ * memory limit, and the blocks are finally merged to find equal seeds.
+ * The memory needed is then bounded, and the disk space needed is 16 bytes
+ * per seed in the campaign.
+ *
+ * Policies with seeds set on each event (`perEvent`) give no seed per job and
+ * are not supported, unless an `initSeedPolicy` is configured.
+ *
+ * Policies drawing seeds at random need a fixed `masterSeed` to be planned:
+ * a `splitRandom` configuration without it is rejected, since its jobs could
+ * never be reproduced.
+ *
+ * A `jobSlotLease` in the configuration is not used: the job indices are
+ * taken as the job numbers the jobs would lease (`firstJob` plus the slot),
+ * and no slot is taken from the lease file.
+ *
+ * The program exits with code 0 if all the seeds are unique, 1 if there are
+ * clashes and 2 on errors.
+ */
+
+// nurandom libraries
+#include "nurandom/RandomUtils/Providers/PolicyFactory.h"
+#include "nurandom/RandomUtils/Providers/Policies.h"
+#include "nurandom/RandomUtils/Providers/EngineId.h"
+
+// framework libraries
+#include "cetlib/filepath_maker.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/intermediate_table.h"
+#include "fhiclcpp/parse.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "canvas/Utilities/Exception.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::sort(), std::inplace_merge()
+#include <cstdint> // std::uint64_t, std::uint32_t
+#include <cstdio> // std::remove()
+#include <fstream>
+#include <iostream>
+#include <limits> // std::numeric_limits<>
+#include <memory> // std::unique_ptr<>
+#include <queue> // std::priority_queue<>
+#include <sstream>
+#include <stdexcept> // std::runtime_error
+#include <string>
+#include <thread>
+#include <tuple> // std::tie()
+#include <vector>
+#include <unistd.h> // getpid()
+
+
+namespace {
+
+  using seed_t = unsigned long;
+  using EngineId = rndm::SeedMasterHelper::EngineId;
+
+
+  //----------------------------------------------------------------------------
+  //--- program configuration
+  //---
+  struct Config_t {
+    std::string configPath;
+    std::string configKey = "services.NuRandomService";
+    std::uint32_t firstJob = 0;
+    std::uint32_t lastJob = 0;
+    bool hasJobs = false;
+    std::vector<EngineId> engines;
+    std::string jobParameter;
+    std::size_t maxSeedsInMemory = 1U << 24;
+    std::string tmpDir = ".";
+    unsigned int nThreads = 0;
+    unsigned int maxReport = 20;
+  }; // Config_t
+
+
+  /// Error in the command line arguments.
+  struct UsageError: std::runtime_error { using std::runtime_error::runtime_error; };
+
+
+  /// Converts a `Module[.Instance]` string into an engine ID
+  EngineId ParseEngine(std::string const& spec) {
+    auto const iDot = spec.find('.');
+    if (spec.empty() || (iDot == 0))
+      throw UsageError("invalid engine specification: '" + spec + "'");
+    return (iDot == std::string::npos)
+      ? EngineId(spec): EngineId(spec.substr(0, iDot), spec.substr(iDot + 1));
+  } // ParseEngine()
+
+
+  /// Adds to `engines` all the comma-separated engines in `specs`
+  void ParseEngineList(std::vector<EngineId>& engines, std::string const& specs)
+  {
+    std::istringstream sstr(specs);
+    std::string spec;
+    while (std::getline(sstr, spec, ',')) engines.push_back(ParseEngine(spec));
+  } // ParseEngineList()
+
+
+  /// Adds to `engines` the engines listed in the specified file
+  void ReadEngineFile(std::vector<EngineId>& engines, std::string const& path)
+  {
+    std::ifstream file(path);
+    if (!file) throw UsageError("can't read engine file '" + path + "'");
+    std::string line;
+    while (std::getline(file, line)) {
+      auto const first = line.find_first_not_of(" \t");
+      if ((first == std::string::npos) || (line[first] == '#')) continue;
+      auto const last = line.find_last_not_of(" \t\r");
+      engines.push_back(ParseEngine(line.substr(first, last - first + 1)));
+    } // while
+  } // ReadEngineFile()
+
+
+  /// Converts a string into an unsigned number, or throws UsageError
+  unsigned long long ParseNumber
+    (std::string const& value, std::string const& option)
+  {
+    std::istringstream sstr(value);
+    unsigned long long n;
+    if (value.empty() || (value[0] == '-') || !(sstr >> n) || !sstr.eof())
+      throw UsageError("invalid value '" + value + "' for " + option);
+    return n;
+  } // ParseNumber()
+
+
+  /// Parses the command line
+  Config_t ParseCommandLine(int argc, char const** argv) {
+    Config_t config;
+    for (int iParam = 1; iParam < argc; ++iParam) {
+      std::string const param = argv[iParam];
+      if (param.substr(0, 2) != "--") {
+        if (!config.configPath.empty())
+          throw UsageError("unexpected argument: '" + param + "'");
+        config.configPath = param;
+        continue;
+      }
+      if (++iParam >= argc)
+        throw UsageError("option " + param + " requires a value");
+      std::string const value = argv[iParam];
+      if (param == "--jobs") {
+        auto const iDash = value.find('-', 1);
+        auto const first = ParseNumber(value.substr(0, iDash), param);
+        auto const last = (iDash == std::string::npos)
+          ? first: ParseNumber(value.substr(iDash + 1), param);
+        if (last < first)
+          throw UsageError("empty job range: '" + value + "'");
+        if (last > std::numeric_limits<std::uint32_t>::max())
+          throw UsageError("job index too large: '" + value + "'");
+        config.firstJob = first;
+        config.lastJob = last;
+        config.hasJobs = true;
+      }
+      else if (param == "--engines")      ParseEngineList(config.engines, value);
+      else if (param == "--engineFile")   ReadEngineFile(config.engines, value);
+      else if (param == "--configKey")    config.configKey = value;
+      else if (param == "--jobParameter") config.jobParameter = value;
+      else if (param == "--maxSeedsInMemory")
+        config.maxSeedsInMemory = ParseNumber(value, param);
+      else if (param == "--tmpDir")       config.tmpDir = value;
+      else if (param == "--threads")
+        config.nThreads = ParseNumber(value, param);
+      else if (param == "--maxReport")
+        config.maxReport = ParseNumber(value, param);
+      else throw UsageError("unknown option: " + param);
+    } // for
+
+    if (config.configPath.empty())
+      throw UsageError("please specify a configuration file");
+    if (!config.hasJobs)
+      throw UsageError("please specify the job range (--jobs)");
+    if (config.engines.empty()) {
+      throw UsageError
+        ("please specify the engines (--engines and/or --engineFile)");
+    }
+    if (config.maxSeedsInMemory == 0)
+      throw UsageError("--maxSeedsInMemory must be positive");
+    if (config.nThreads == 0)
+      config.nThreads = std::max(1U, std::thread::hardware_concurrency());
+    return config;
+  } // ParseCommandLine()
+
+
+  /// Reads the configuration of the seed service from the specified file
+  fhicl::ParameterSet ReadSeedServiceConfiguration(Config_t const& config) {
+    cet::filepath_lookup policy("FHICL_FILE_PATH");
+    fhicl::intermediate_table table
+      = fhicl::parse_document(config.configPath, policy);
+    fhicl::ParameterSet const pset = fhicl::ParameterSet::make(table);
+    return config.configKey.empty()
+      ? pset: pset.get<fhicl::ParameterSet>(config.configKey);
+  } // ReadSeedServiceConfiguration()
+
+
+  /// Returns the parameter to be set to the job index for the policy
+  std::string JobParameter
+    (Config_t const& config, fhicl::ParameterSet const& pset)
+  {
+    if (!config.jobParameter.empty()) return config.jobParameter;
+    std::string const policy = pset.get<std::string>("policy");
+    if ((policy == "linearMapping") || (policy == "splitRandom")) return "nJob";
+    if (policy == "random") return "masterSeed";
+    return {};
+  } // JobParameter()
+
+
+  /// Throws UsageError if the jobs of the campaign could not be reproduced
+  void CheckReproducible(fhicl::ParameterSet const& pset) {
+    if (pset.get<std::string>("policy") != "splitRandom") return;
+    if (pset.has_key("masterSeed")) return;
+    throw UsageError("the 'splitRandom' configuration has no 'masterSeed':"
+      " each job would draw it from the system, and the campaign could not be"
+      " reproduced");
+  } // CheckReproducible()
+
+
+  void StartMessageFacility() {
+    // the policies are chatty at INFO level
+    std::string const MessageFacilityConfiguration = R"(
+    destinations : {
+      stderr: {
+        type:      cerr
+        threshold: WARNING
+      } // stderr
+    } // destinations
+    )";
+    mf::StartMessageFacility
+      (fhicl::ParameterSet::make(MessageFacilityConfiguration));
+    mf::SetApplicationName("SeedCampaignPlanner");
+  } // StartMessageFacility()
+
+
+  //----------------------------------------------------------------------------
+  //--- seed records and their sorting
+  //---
+
+  /// One seed of the campaign, with the job and the engine it belongs to
+  struct SeedRecord_t {
+    std::uint64_t seed;
+    std::uint32_t job;
+    std::uint32_t engine; ///< index in the engine list
+
+    bool operator< (SeedRecord_t const& other) const
+      {
+        return std::tie(seed, job, engine)
+          < std::tie(other.seed, other.job, other.engine);
+      }
+  }; // SeedRecord_t
+
+
+  /// Sorts the records, splitting the work among `nThreads` threads
+  void ParallelSort(std::vector<SeedRecord_t>& records, unsigned int nThreads)
+  {
+    std::size_t const nBlocks = std::max<std::size_t>
+      (1U, std::min<std::size_t>(nThreads, records.size() / 4096));
+    std::vector<std::size_t> bounds;
+    for (std::size_t iBlock = 0; iBlock <= nBlocks; ++iBlock)
+      bounds.push_back(records.size() * iBlock / nBlocks);
+
+    std::vector<std::thread> threads;
+    for (std::size_t iBlock = 0; iBlock < nBlocks; ++iBlock) {
+      threads.emplace_back([&records, b = bounds[iBlock], e = bounds[iBlock + 1]]
+        { std::sort(records.begin() + b, records.begin() + e); });
+    }
+    for (std::thread& thread: threads) thread.join();
+
+    // merge the sorted blocks pairwise, doubling the block size each time
+    for (std::size_t step = 1; step < nBlocks; step *= 2) {
+      for (std::size_t iBlock = 0; iBlock + step < nBlocks; iBlock += 2 * step)
+      {
+        std::size_t const end = std::min(iBlock + 2 * step, nBlocks);
+        std::inplace_merge(records.begin() + bounds[iBlock],
+          records.begin() + bounds[iBlock + step], records.begin() + bounds[end]);
+      } // for
+    } // for
+  } // ParallelSort()
+
+
+  /// Sorted block of records written into a temporary file
+  class SortedRun {
+      public:
+    SortedRun(std::string path, std::vector<SeedRecord_t> const& records)
+      : fPath(std::move(path))
+      {
+        std::ofstream out(fPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<char const*>(records.data()),
+          records.size() * sizeof(SeedRecord_t));
+        if (!out.flush())
+          throw std::runtime_error("can't write temporary file '" + fPath + "'");
+      }
+    ~SortedRun() { fIn.reset(); std::remove(fPath.c_str()); }
+    SortedRun(SortedRun const&) = delete;
+    SortedRun& operator=(SortedRun const&) = delete;
+
+    /// Reads the next record; returns false at the end of the run
+    bool next(SeedRecord_t& record)
+      {
+        if (!fIn) {
+          fIn = std::make_unique<std::ifstream>(fPath, std::ios::binary);
+          if (!*fIn)
+            throw std::runtime_error("can't read temporary file '" + fPath + "'");
+        }
+        return bool
+          (fIn->read(reinterpret_cast<char*>(&record), sizeof(SeedRecord_t)));
+      }
+
+      private:
+    std::string fPath;
+    std::unique_ptr<std::ifstream> fIn;
+  }; // SortedRun
+
+
+  //----------------------------------------------------------------------------
+  //--- clash detection
+  //---
+
+  /// Counts (and reports) equal seeds in a sorted sequence of records
+  class ClashDetector {
+      public:
+    ClashDetector(std::vector<EngineId> const& engines, unsigned int maxReport)
+      : fEngines(engines), fMaxReport(maxReport)
+      {}
+
+    /// Processes the next record of the sorted sequence
+    void add(SeedRecord_t const& record)
+      {
+        ++fNSeeds;
+        if (fHasLast && (record.seed == fLast.seed)) {
+          if (!fInClash) ++fNClashingSeeds;
+          fInClash = true;
+          if (++fNClashes <= fMaxReport) {
+            std::cout << "Seed " << record.seed << " assigned to "
+              << Describe(fLast) << " and to " << Describe(record) << "\n";
+          }
+        }
+        else fInClash = false;
+        fLast = record;
+        fHasLast = true;
+      }
+
+    unsigned long long nSeeds() const { return fNSeeds; }
+    unsigned long long nClashes() const { return fNClashes; }
+    unsigned long long nClashingSeeds() const { return fNClashingSeeds; }
+
+      private:
+    std::vector<EngineId> const& fEngines;
+    unsigned int fMaxReport;
+    SeedRecord_t fLast{};
+    bool fHasLast = false;
+    bool fInClash = false;
+    unsigned long long fNSeeds = 0;
+    unsigned long long fNClashes = 0; ///< records equal to the previous one
+    unsigned long long fNClashingSeeds = 0; ///< seed values used more than once
+
+    std::string Describe(SeedRecord_t const& record) const
+      {
+        return "job " + std::to_string(record.job) + " engine '"
+          + std::string(fEngines[record.engine]) + "'";
+      }
+  }; // ClashDetector
+
+
+  /// Merges the sorted runs, passing the records in order to the detector
+  void MergeRuns
+    (std::vector<std::unique_ptr<SortedRun>>& runs, ClashDetector& detector)
+  {
+    using Entry_t = std::pair<SeedRecord_t, std::size_t>; // record, run index
+    auto const greater = [](Entry_t const& a, Entry_t const& b)
+      { return b.first < a.first; };
+    std::priority_queue<Entry_t, std::vector<Entry_t>, decltype(greater)>
+      heads(greater);
+
+    SeedRecord_t record;
+    for (std::size_t iRun = 0; iRun < runs.size(); ++iRun)
+      if (runs[iRun]->next(record)) heads.emplace(record, iRun);
+
+    while (!heads.empty()) {
+      auto const [ head, iRun ] = heads.top();
+      heads.pop();
+      detector.add(head);
+      if (runs[iRun]->next(record)) heads.emplace(record, iRun);
+    } // while
+  } // MergeRuns()
+
+
+  //----------------------------------------------------------------------------
+  /// Generates and checks all the seeds of the campaign; returns the exit code
+  int PlanCampaign(Config_t const& config, fhicl::ParameterSet pset) {
+
+    CheckReproducible(pset);
+    std::string const jobParameter = JobParameter(config, pset);
+    if (pset.erase("jobSlotLease")) {
+      // the planned jobs must not lease slots from the production lease file
+      std::cout << "Job slot lease not used: the job indices are the job"
+        " numbers." << std::endl;
+    }
+    if (jobParameter.empty()) {
+      mf::LogWarning("SeedCampaignPlanner")
+        << "Policy '" << pset.get<std::string>("policy")
+        << "' has no job parameter: all jobs use the same configuration"
+        " (see --jobParameter).";
+    }
+
+    std::size_t const nEngines = config.engines.size();
+    std::uint64_t const nJobs
+      = std::uint64_t(config.lastJob) - config.firstJob + 1;
+    std::cout << "Planning " << nJobs << " jobs (" << config.firstJob << "-"
+      << config.lastJob << ") with " << nEngines << " engines each, "
+      << (nJobs * nEngines) << " seeds"
+      << (jobParameter.empty()? "": ", job index in '" + jobParameter + "'")
+      << "." << std::endl;
+
+    std::vector<SeedRecord_t> records;
+    records.reserve(std::min<std::uint64_t>
+      (config.maxSeedsInMemory, nJobs * nEngines));
+    std::vector<std::unique_ptr<SortedRun>> runs;
+    auto const spill = [&]()
+      {
+        ParallelSort(records, config.nThreads);
+        runs.push_back(std::make_unique<SortedRun>(
+          config.tmpDir + "/SeedCampaignPlanner_" + std::to_string(getpid())
+            + "_" + std::to_string(runs.size()) + ".seeds",
+          records
+          ));
+        records.clear();
+      };
+
+    unsigned int nInvalid = 0;
+    for (std::uint64_t job = config.firstJob; job <= config.lastJob; ++job) {
+      if (!jobParameter.empty()) pset.put_or_replace(jobParameter, job);
+      auto policy = rndm::details::makeRandomSeedPolicy<seed_t>(pset);
+      for (std::size_t iEngine = 0; iEngine < nEngines; ++iEngine) {
+        seed_t const seed = policy->getSeed(config.engines[iEngine]);
+        if (seed == rndm::details::RandomSeedPolicyBase<seed_t>::InvalidSeed) {
+          if (nInvalid++ == 0) {
+            std::cerr << "No valid seed for job " << job << " engine '"
+              << std::string(config.engines[iEngine]) << "'"
+              << " (per-event policies are not supported)" << std::endl;
+          }
+          continue;
+        }
+        records.push_back({ seed, static_cast<std::uint32_t>(job),
+          static_cast<std::uint32_t>(iEngine) });
+        if (records.size() >= config.maxSeedsInMemory) spill();
+      } // for engines
+    } // for jobs
+    if (nInvalid > 0) {
+      std::cerr << nInvalid << " seeds were not valid." << std::endl;
+      return 2;
+    }
+
+    ClashDetector detector(config.engines, config.maxReport);
+    if (runs.empty()) { // all in memory
+      ParallelSort(records, config.nThreads);
+      for (SeedRecord_t const& record: records) detector.add(record);
+    }
+    else {
+      if (!records.empty()) spill();
+      std::cout << "Merging " << runs.size() << " sorted blocks from disk..."
+        << std::endl;
+      MergeRuns(runs, detector);
+    }
+
+    if (detector.nClashes() > config.maxReport) {
+      std::cout << "... and " << (detector.nClashes() - config.maxReport)
+        << " more.\n";
+    }
+    std::cout << detector.nSeeds() << " seeds checked: ";
+    if (detector.nClashes() == 0) {
+      std::cout << "all unique." << std::endl;
+      return 0;
+    }
+    std::cout << detector.nClashingSeeds() << " seed values are used more than"
+      " once (" << detector.nClashes() << " extra uses)." << std::endl;
+    return 1;
+  } // PlanCampaign()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv) {
+
+  auto const printUsageError = [argv](UsageError const& e)
+    {
+      std::cerr << "SeedCampaignPlanner: " << e.what()
+        << "\nUsage: " << argv[0]
+        << " ConfigFile --jobs First-Last --engines Module[.Instance][,...]"
+        " [options]" << std::endl;
+    };
+
+  Config_t config;
+  try {
+    config = ParseCommandLine(argc, argv);
+  }
+  catch (UsageError const& e) {
+    printUsageError(e);
+    return 2;
+  }
+
+  StartMessageFacility();
+
+  try {
+    return PlanCampaign(config, ReadSeedServiceConfiguration(config));
+  }
+  catch (UsageError const& e) {
+    printUsageError(e);
+    return 2;
+  }
+  catch (std::exception const& e) { // includes art and FHiCL exceptions
+    std::cerr << "SeedCampaignPlanner: " << e.what() << std::endl;
+    return 2;
+  }
+
+} // main()
@@ -0,0 +1,134 @@
+/**
+ * @file   CheckDeterministicTimestamp_module.cc
+ * @brief  Verifies the time stamps of `GeneratedEventTimestamp` in
+ *         deterministic mode.
+ * @date   October 16th, 2026
+ * @see    test_deterministictimestamp.fcl
+ */
+
+
+// supporting libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// framework libraries
+#include "canvas/Utilities/Exception.h"
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "fhiclcpp/ParameterSet.h"
+
+// C/C++ standard libraries
+#include <cstdint>
+#include <optional>
+#include <string>
+
+
+namespace testing {
+
+  /**
+   * @brief Verifies that each event has the time stamp from its ID
+   *
+   * The module recomputes the time stamp of each event from its ID with the
+   * same configuration as the `GeneratedEventTimestamp` plugin of the source,
+   * and checks that the event has it. Since the time stamp depends only on
+   * the event ID and on the configuration, every run of the same job gets the
+   * same ones. The module also checks that the time stamps increase with the
+   * events, and optionally that the first event has a time stamp known in
+   * advance.
+   * At the end of the job, an exception is thrown if any check failed.
+   *
+   * Configuration parameters
+   * -------------------------
+   *
+   * * *timestamp* (table, mandatory): the configuration of the
+   *   `GeneratedEventTimestamp` plugin, in `deterministic` mode; the
+   *   parameters have the same defaults as in the plugin
+   * * *firstTimestamp* (integer, optional): the expected time stamp of the
+   *   first event
+   *
+   */
+  class CheckDeterministicTimestamp: public art::EDAnalyzer {
+
+      public:
+
+    explicit CheckDeterministicTimestamp(fhicl::ParameterSet const& pset);
+
+    virtual void analyze(art::Event const& event) override;
+
+    virtual void endJob() override;
+
+      private:
+
+    std::uint64_t epoch; ///< Time stamp of event `0:0:0`.
+    std::uint64_t stride; ///< Time between events.
+    std::uint64_t subRunStride; ///< Time between subruns.
+    std::uint64_t runStride; ///< Time between runs.
+    /// Expected time stamp of the first event.
+    std::optional<std::uint64_t> firstTime;
+
+    std::optional<std::uint64_t> lastTime; ///< Time stamp of the last event.
+
+    unsigned int nEvents = 0; ///< Number of checked events.
+    unsigned int nErrors = 0; ///< Number of failed checks.
+
+  }; // class CheckDeterministicTimestamp
+
+
+  CheckDeterministicTimestamp::CheckDeterministicTimestamp
+    (fhicl::ParameterSet const& pset)
+    : art::EDAnalyzer(pset)
+  {
+    auto const config = pset.get<fhicl::ParameterSet>("timestamp");
+    if (config.get<std::string>("mode", "clock") != "deterministic") {
+      throw art::Exception(art::errors::Configuration)
+        << "CheckDeterministicTimestamp: the time stamp configuration is not"
+        " in 'deterministic' mode\n";
+    }
+    epoch = config.get<std::uint64_t>("epoch", 0ULL);
+    stride = config.get<std::uint64_t>("stride", 1000000ULL);
+    subRunStride = config.get<std::uint64_t>("subRunStride", 10000000000000ULL);
+    runStride = config.get<std::uint64_t>("runStride", 10000000000000000ULL);
+    std::uint64_t time;
+    if (pset.get_if_present("firstTimestamp", time)) firstTime = time;
+  } // CheckDeterministicTimestamp::CheckDeterministicTimestamp()
+
+
+  void CheckDeterministicTimestamp::analyze(art::Event const& event) {
+    ++nEvents;
+    std::uint64_t const expected = epoch + runStride * event.run()
+      + subRunStride * event.subRun() + stride * event.event();
+    std::uint64_t const time = event.time().value();
+    if (time != expected) {
+      mf::LogError("CheckDeterministicTimestamp") << "Event " << event.id()
+        << " has time stamp " << time << ", expected " << expected;
+      ++nErrors;
+    }
+    if (!lastTime && firstTime && (time != *firstTime)) {
+      mf::LogError("CheckDeterministicTimestamp") << "The first event "
+        << event.id() << " has time stamp " << time << ", expected "
+        << *firstTime;
+      ++nErrors;
+    }
+    if (lastTime && (time <= *lastTime)) {
+      mf::LogError("CheckDeterministicTimestamp") << "Event " << event.id()
+        << " has time stamp " << time << ", not after the previous one ("
+        << *lastTime << ")";
+      ++nErrors;
+    }
+    lastTime = time;
+  } // CheckDeterministicTimestamp::analyze()
+
+
+  void CheckDeterministicTimestamp::endJob() {
+    mf::LogInfo("CheckDeterministicTimestamp")
+      << nEvents << " event time stamps checked, " << nErrors << " errors";
+    if (nErrors > 0) {
+      throw art::Exception(art::errors::LogicError)
+        << "CheckDeterministicTimestamp: " << nErrors
+        << " time stamp checks failed (see the log)\n";
+    }
+  } // CheckDeterministicTimestamp::endJob()
+
+} // namespace testing
+
+DEFINE_ART_MODULE(testing::CheckDeterministicTimestamp)
@@ -0,0 +1,301 @@
+/**
+ * @file   BulkRandom_benchmark.cc
+ * @brief  Compares bulk generation of random numbers with one call per number
+ * @date   October 16th, 2026
+ * @see    BulkRandom_test.cc nurandom/RandomUtils/Engines/BulkRandom.h
+ *
+ * Usage:
+ *
+ *     BulkRandom_benchmark [options]
+ *
+ * Options:
+ * * `--engines` _Name[,Name...]_: engines to be used
+ *   (default: all of `Philox4x32_10`, `MixMaxRng` and `HepJamesRandom`)
+ * * `--numbers` _N[,N...]_: size of the buffer filled on each call
+ *   (default: `16,1000,100000`)
+ * * `--total` _N_: total amount of numbers generated for each configuration
+ *   (default: 10000000)
+ * * `--output` _Path_: file where the results are written
+ *   (default: `BulkRandom_benchmark.json`)
+ *
+ * For each engine and buffer size, the following operations are timed:
+ * * `RandFlat`: `CLHEP::RandFlat::shoot()`, once per number
+ * * `fillFlat:double`: `rndm::BulkRandom::fillFlat()` of `double` numbers
+ * * `fillFlat:float`: `rndm::BulkRandom::fillFlat()` of `float` numbers
+ * * `RandGauss`: `CLHEP::RandGauss::shoot()`, once per number
+ * * `fillGauss:double`: `rndm::BulkRandom::fillGauss()` of `double` numbers
+ * * `fillGauss:float`: `rndm::BulkRandom::fillGauss()` of `float` numbers
+ *
+ * The results are written in JSON format as a list of records, each one with
+ * `engine`, `bufferSize`, `operation`, `numbers`, `seconds` and `nsPerNumber`
+ * keys.
+ */
+
+// nurandom libraries
+#include "nurandom/RandomUtils/Engines/BulkRandom.h"
+#include "nurandom/RandomUtils/Engines/PhiloxEngine.h"
+#include "nurandom/RandomUtils/Providers/JSONstring.h"
+
+// CLHEP libraries
+#include "CLHEP/Random/JamesRandom.h"
+#include "CLHEP/Random/MixMaxRng.h"
+#include "CLHEP/Random/RandFlat.h"
+#include "CLHEP/Random/RandGauss.h"
+
+// C/C++ standard libraries
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+//--- stuff to facilitate the timing
+//---
+
+/// Result of the timing of a single operation
+struct TimingRecord_t {
+  std::string engine;
+  unsigned int bufferSize = 0;
+  std::string operation;
+  unsigned long long nNumbers = 0;
+  double seconds = 0.;
+}; // TimingRecord_t
+
+
+/// Times the execution of op(), and returns the elapsed time in seconds
+template <typename Op>
+double TimeIt(Op op) {
+  auto const start = std::chrono::steady_clock::now();
+  op();
+  auto const stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+} // TimeIt()
+
+
+/// Writes all the records in JSON format
+void PrintRecords
+  (std::ostream& out, std::vector<TimingRecord_t> const& records)
+{
+  out << "[";
+  bool first = true;
+  for (TimingRecord_t const& record: records) {
+    out << (first? "\n  { \"engine\": ": ",\n  { \"engine\": ");
+    first = false;
+    rndm::details::printJSONstring(out, record.engine);
+    out << ", \"bufferSize\": " << record.bufferSize
+      << ", \"operation\": ";
+    rndm::details::printJSONstring(out, record.operation);
+    out << ", \"numbers\": " << record.nNumbers
+      << ", \"seconds\": " << std::setprecision(9) << record.seconds
+      << ", \"nsPerNumber\": " << std::setprecision(6)
+      << ((record.nNumbers > 0)? record.seconds * 1e9 / record.nNumbers: 0.)
+      << " }";
+  } // for
+  out << (first? "]\n": "\n]\n");
+} // PrintRecords()
+
+
+/// Returns a new engine of the specified type
+std::unique_ptr<CLHEP::HepRandomEngine> MakeEngine(std::string const& name) {
+  long const seed = 2026L;
+  if (name == rndm::PhiloxEngine::engineName())
+    return std::make_unique<rndm::PhiloxEngine>(seed);
+  if (name == "MixMaxRng") return std::make_unique<CLHEP::MixMaxRng>(seed);
+  if (name == "HepJamesRandom")
+    return std::make_unique<CLHEP::HepJamesRandom>(seed);
+  throw std::runtime_error("Unsupported engine: '" + name + "'");
+} // MakeEngine()
+
+
+/// Times all the operations for one engine and buffer size
+std::vector<TimingRecord_t> BenchmarkConfiguration(
+  std::string const& engineName, unsigned int bufferSize,
+  unsigned long long total
+) {
+  std::vector<TimingRecord_t> records;
+  if (bufferSize == 0) return records;
+
+  unsigned long long const nCalls = (total + bufferSize - 1) / bufferSize;
+  unsigned long long const nNumbers = nCalls * bufferSize;
+  auto const addRecord = [&](std::string const& operation, double t)
+    {
+      records.push_back({ engineName, bufferSize, operation, nNumbers, t });
+    };
+
+  std::unique_ptr<CLHEP::HepRandomEngine> engine = MakeEngine(engineName);
+  rndm::BulkRandom bulk(*engine);
+  std::vector<double> doubles(bufferSize);
+  std::vector<float> floats(bufferSize);
+
+  // sum of the numbers, so that the compiler can't optimise the calls away
+  double sink = 0.0;
+
+  addRecord("RandFlat", TimeIt([&](){
+    for (unsigned long long iCall = 0; iCall < nCalls; ++iCall) {
+      for (double& x: doubles) x = CLHEP::RandFlat::shoot(engine.get());
+      sink += doubles.back();
+    }
+  }));
+
+  addRecord("fillFlat:double", TimeIt([&](){
+    for (unsigned long long iCall = 0; iCall < nCalls; ++iCall) {
+      bulk.fillFlat(doubles);
+      sink += doubles.back();
+    }
+  }));
+
+  addRecord("fillFlat:float", TimeIt([&](){
+    for (unsigned long long iCall = 0; iCall < nCalls; ++iCall) {
+      bulk.fillFlat(floats);
+      sink += floats.back();
+    }
+  }));
+
+  addRecord("RandGauss", TimeIt([&](){
+    for (unsigned long long iCall = 0; iCall < nCalls; ++iCall) {
+      for (double& x: doubles) x = CLHEP::RandGauss::shoot(engine.get(), 0.0, 1.0);
+      sink += doubles.back();
+    }
+  }));
+
+  addRecord("fillGauss:double", TimeIt([&](){
+    for (unsigned long long iCall = 0; iCall < nCalls; ++iCall) {
+      bulk.fillGauss(doubles);
+      sink += doubles.back();
+    }
+  }));
+
+  addRecord("fillGauss:float", TimeIt([&](){
+    for (unsigned long long iCall = 0; iCall < nCalls; ++iCall) {
+      bulk.fillGauss(floats);
+      sink += floats.back();
+    }
+  }));
+
+  if (sink == 0.0) std::cout << "(null checksum)" << std::endl;
+
+  return records;
+} // BenchmarkConfiguration()
+
+
+//------------------------------------------------------------------------------
+//--- command line parsing
+//---
+
+/// Splits a comma-separated list
+std::vector<std::string> SplitList(std::string const& list) {
+  std::vector<std::string> items;
+  std::istringstream sstr(list);
+  std::string item;
+  while (std::getline(sstr, item, ',')) if (!item.empty()) items.push_back(item);
+  return items;
+} // SplitList()
+
+
+/// Splits a comma-separated list of numbers
+std::vector<unsigned int> SplitNumbers(std::string const& list) {
+  std::vector<unsigned int> numbers;
+  for (std::string const& item: SplitList(list))
+    numbers.push_back(std::stoul(item));
+  return numbers;
+} // SplitNumbers()
+
+
+void PrintUsage(const char* programName) {
+  std::cerr << "Usage: " << programName << " [options]"
+    "\n  --engines Name[,Name...]   engines to be used"
+    "\n  --numbers N[,N...]         sizes of the buffers"
+    "\n  --total N                  numbers generated per configuration"
+    "\n  --output Path              JSON output file"
+    << std::endl;
+} // PrintUsage()
+
+
+//------------------------------------------------------------------------------
+int main(int argc, const char** argv) {
+
+  std::vector<std::string> engines
+    { rndm::PhiloxEngine::engineName(), "MixMaxRng", "HepJamesRandom" };
+  std::vector<unsigned int> bufferSizes{ 16, 1000, 100000 };
+  unsigned long long total = 10000000ULL;
+  std::string outputPath = "BulkRandom_benchmark.json";
+
+  //****************************************************************************
+  //*** parse the command line
+  //***
+  try {
+    for (int iParam = 1; iParam < argc; ++iParam) {
+      std::string const option = argv[iParam];
+      if ((option == "-h") || (option == "--help")) {
+        PrintUsage(argv[0]);
+        return 0;
+      }
+      if (++iParam >= argc) {
+        std::cerr << "Option '" << option << "' requires an argument."
+          << std::endl;
+        PrintUsage(argv[0]);
+        return 1;
+      }
+      std::string const value = argv[iParam];
+      if      (option == "--engines") engines     = SplitList(value);
+      else if (option == "--numbers") bufferSizes = SplitNumbers(value);
+      else if (option == "--total")   total       = std::stoull(value);
+      else if (option == "--output")  outputPath  = value;
+      else {
+        std::cerr << "Unknown option: '" << option << "'" << std::endl;
+        PrintUsage(argv[0]);
+        return 1;
+      }
+    } // for
+  }
+  catch (std::logic_error const& e) { // from std::stoul() and the like
+    std::cerr << "Invalid number on the command line: " << e.what()
+      << std::endl;
+    return 1;
+  }
+
+  //****************************************************************************
+  //*** run all the configurations
+  //***
+  std::vector<TimingRecord_t> records;
+  try {
+    for (std::string const& engine: engines) {
+      for (unsigned int bufferSize: bufferSizes) {
+        for (TimingRecord_t& result
+          : BenchmarkConfiguration(engine, bufferSize, total))
+        {
+          std::cout << engine << " [" << bufferSize << " numbers per call] "
+            << result.operation << ": "
+            << (result.seconds * 1e9 / result.nNumbers) << " ns/number"
+            << std::endl;
+          records.push_back(std::move(result));
+        } // for results
+      } // for buffer sizes
+    } // for engines
+  }
+  catch (std::runtime_error const& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  //****************************************************************************
+  //*** write the results
+  //***
+  std::ofstream outputFile(outputPath);
+  if (!outputFile) {
+    std::cerr << "Can't write benchmark results into '" << outputPath << "'"
+      << std::endl;
+    return 1;
+  }
+  PrintRecords(outputFile, records);
+  std::cout << records.size() << " timing records written into '"
+    << outputPath << "'" << std::endl;
+
+  return 0;
+} // main()
@@ -0,0 +1,185 @@
+/**
+ * @file   BulkRandom_test.cc
+ * @brief  Tests the bulk generation of random numbers
+ * @date   October 16th, 2026
+ * @see    nurandom/RandomUtils/Engines/BulkRandom.h
+ *
+ * The numbers from `rndm::BulkRandom` are compared with the ones generated one
+ * by one from an identical engine, both with a block engine
+ * (`rndm::PhiloxEngine`) and with a generic CLHEP engine, and with buffers of
+ * sizes crossing the chunk boundaries.
+ * The program returns the number of failed checks.
+ */
+
+// nurandom libraries
+#include "nurandom/RandomUtils/Engines/BulkRandom.h"
+#include "nurandom/RandomUtils/Engines/PhiloxEngine.h"
+
+// CLHEP libraries
+#include "CLHEP/Random/JamesRandom.h"
+
+// C/C++ standard libraries
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  unsigned int nErrors = 0;
+
+  void check(bool good, std::string const& what) {
+    if (good) return;
+    ++nErrors;
+    std::cerr << "FAILED: " << what << std::endl;
+  } // check()
+
+  /// Buffer sizes: empty, odd, and across chunk boundaries
+  constexpr std::size_t Sizes[] = {
+    0, 1, 2, 7, rndm::BulkRandom::ChunkSize - 1, rndm::BulkRandom::ChunkSize,
+    rndm::BulkRandom::ChunkSize + 1, 3 * rndm::BulkRandom::ChunkSize + 5
+    };
+
+  /// Returns the Box-Muller pair from two flat numbers, one number at a time
+  std::pair<double, double> referenceGauss
+    (double u1, double u2, double mean, double sigma)
+  {
+    double const r = sigma * std::sqrt(-2.0 * std::log(u1));
+    double const phi = 6.283185307179586476925 * u2;
+    return { mean + r * std::cos(phi), mean + r * std::sin(phi) };
+  } // referenceGauss()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+template <typename Engine>
+void TestFlat(std::string const& engineName) {
+  for (std::size_t n: Sizes) {
+    Engine bulkEngine(12345L), engine(12345L);
+    rndm::BulkRandom bulk(bulkEngine);
+
+    std::vector<double> values(n);
+    bulk.fillFlat(values);
+    bool same = true;
+    for (double x: values) same = same && (x == engine.flat());
+    check(same, engineName + ": fillFlat(double) matches flat()");
+    check(bulkEngine.flat() == engine.flat(),
+      engineName + ": engine state after fillFlat(double)");
+  } // for sizes
+} // TestFlat()
+
+
+void TestFlatFloat() {
+  // block engine: one word per number, same as `float(engine)`
+  for (std::size_t n: Sizes) {
+    rndm::PhiloxEngine bulkEngine(2026L), engine(2026L);
+    rndm::BulkRandom bulk(bulkEngine);
+    check(bulk.hasBlockGeneration(), "PhiloxEngine has block generation");
+
+    bulkEngine.flat(); // start in the middle of a block
+    engine.flat();
+    std::vector<float> values(n);
+    bulk.fillFlat(values);
+    bool same = true;
+    for (float x: values) same = same && (x == static_cast<float>(engine));
+    check(same, "Philox: fillFlat(float) matches float(engine)");
+    check(bulkEngine.flat() == engine.flat(),
+      "Philox: engine state after fillFlat(float)");
+  } // for sizes
+
+  // generic engine: one flat() per number
+  {
+    CLHEP::HepJamesRandom bulkEngine(12345L), engine(12345L);
+    rndm::BulkRandom bulk(bulkEngine);
+    check(!bulk.hasBlockGeneration(), "HepJamesRandom has no block generation");
+    std::vector<float> values(1000);
+    bulk.fillFlat(values);
+    bool same = true;
+    for (float x: values) {
+      double const u = engine.flat();
+      float const expected
+        = (float(static_cast<std::uint32_t>(u * 0x1.0p23)) + 0.5f) * 0x1.0p-23f;
+      same = same && (x == expected);
+    }
+    check(same, "generic: fillFlat(float) matches flat()");
+  }
+
+  // extreme values stay strictly inside ]0;1[
+  std::uint32_t const words[] = { 0U, 0xFFFFFFFFU };
+  float extremes[2];
+  rndm::details::wordsToFloats(2, words, extremes);
+  check((extremes[0] > 0.0f) && (extremes[1] < 1.0f), "words to float range");
+  double const flat[] = { 0x1.0p-60, 1.0 - 0x1.0p-53 };
+  rndm::details::flatToFloats(2, flat, extremes);
+  check((extremes[0] > 0.0f) && (extremes[1] < 1.0f), "flat to float range");
+} // TestFlatFloat()
+
+
+template <typename Engine>
+void TestGauss(std::string const& engineName) {
+  double const mean = 5.0, sigma = 2.0;
+  for (std::size_t n: Sizes) {
+    Engine bulkEngine(7L), engine(7L), floatEngine(7L);
+    rndm::BulkRandom bulk(bulkEngine), floatBulk(floatEngine);
+
+    std::vector<double> values(n);
+    bulk.fillGauss(values, mean, sigma);
+    std::vector<float> floatValues(n);
+    floatBulk.fillGauss(floatValues, float(mean), float(sigma));
+
+    bool same = true, sameFloat = true;
+    for (std::size_t i = 0; i < n; i += 2) {
+      double const u1 = engine.flat();
+      auto const pair = referenceGauss(u1, engine.flat(), mean, sigma);
+      same = same && (values[i] == pair.first);
+      sameFloat = sameFloat && (floatValues[i] == float(values[i]));
+      if (i + 1 == n) break;
+      same = same && (values[i + 1] == pair.second);
+      sameFloat = sameFloat && (floatValues[i + 1] == float(values[i + 1]));
+    } // for
+    check(same, engineName + ": fillGauss(double) matches Box-Muller");
+    check(sameFloat, engineName + ": fillGauss(float) matches fillGauss(double)");
+    double const next = engine.flat();
+    check(bulkEngine.flat() == next,
+      engineName + ": engine state after fillGauss(double)");
+    check(floatEngine.flat() == next,
+      engineName + ": engine state after fillGauss(float)");
+  } // for sizes
+} // TestGauss()
+
+
+void TestGaussMoments() {
+  double const mean = 5.0, sigma = 2.0;
+  rndm::PhiloxEngine engine(11L);
+  rndm::BulkRandom bulk(engine);
+  std::vector<double> values(100000);
+  bulk.fillGauss(values, mean, sigma);
+  double sum = 0.0, sum2 = 0.0;
+  for (double x: values) {
+    sum += x;
+    sum2 += x * x;
+  }
+  double const average = sum / values.size();
+  double const rms = std::sqrt(sum2 / values.size() - average * average);
+  check(std::abs(average - mean) < 0.05, "Gaussian mean");
+  check(std::abs(rms - sigma) < 0.05, "Gaussian sigma");
+} // TestGaussMoments()
+
+
+//------------------------------------------------------------------------------
+int main() {
+  TestFlat<rndm::PhiloxEngine>("Philox");
+  TestFlat<CLHEP::HepJamesRandom>("generic");
+  TestFlatFloat();
+  TestGauss<rndm::PhiloxEngine>("Philox");
+  TestGauss<CLHEP::HepJamesRandom>("generic");
+  TestGaussMoments();
+
+  if (nErrors > 0) std::cerr << nErrors << " checks failed." << std::endl;
+  else             std::cout << "All checks passed." << std::endl;
+  return nErrors;
+} // main()
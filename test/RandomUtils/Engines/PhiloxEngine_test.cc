@@ -0,0 +1,209 @@
+/**
+ * @file   PhiloxEngine_test.cc
+ * @brief  Tests the Philox4x32-10 CLHEP engine
+ * @date   October 16th, 2026
+ * @see    nurandom/RandomUtils/Engines/PhiloxEngine.h
+ *
+ * The generator is checked against the known-answer vectors of the Random123
+ * reference implementation; then the engine is checked for consistency of
+ * seeding, skipping, block generation and state saving and restoring.
+ * The program returns the number of failed checks.
+ */
+
+// nurandom libraries
+#include "nurandom/RandomUtils/Engines/PhiloxEngine.h"
+
+// C/C++ standard libraries
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  unsigned int nErrors = 0;
+
+  void check(bool good, std::string const& what) {
+    if (good) return;
+    ++nErrors;
+    std::cerr << "FAILED: " << what << std::endl;
+  } // check()
+
+
+  /// Known-answer vectors from Random123 (`kat_vectors`)
+  struct KnownAnswer_t {
+    rndm::details::Philox4x32Block_t counter;
+    rndm::details::Philox4x32Key_t key;
+    rndm::details::Philox4x32Block_t expected;
+  };
+
+  constexpr KnownAnswer_t KnownAnswers[] = {
+    { { 0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U },
+      { 0x00000000U, 0x00000000U },
+      { 0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U }
+    },
+    { { 0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU },
+      { 0xffffffffU, 0xffffffffU },
+      { 0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU }
+    },
+    { { 0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U },
+      { 0xa4093822U, 0x299f31d0U },
+      { 0xd16cfe09U, 0x94fdccebU, 0x5001e420U, 0x24126ea1U }
+    },
+  }; // KnownAnswers
+
+  // the bijection can be evaluated at compile time
+  static_assert(
+    rndm::details::philox4x32_10(KnownAnswers[2].counter, KnownAnswers[2].key)[0]
+    == KnownAnswers[2].expected[0]
+    );
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+void TestKnownAnswers() {
+  for (KnownAnswer_t const& answer: KnownAnswers) {
+    auto const result = rndm::details::philox4x32_10(answer.counter, answer.key);
+    check(result == answer.expected, "Philox4x32-10 known answer");
+  }
+} // TestKnownAnswers()
+
+
+void TestSequence() {
+  rndm::PhiloxEngine engine(12345L);
+  check(engine.getSeed() == 12345L, "getSeed() after setSeed()");
+  check(engine.name() == "Philox4x32_10", "engine name");
+
+  // the first number is from the first block, with the counter at 0
+  auto const block0 = rndm::details::philox4x32_10({ 0U, 0U, 0U, 0U }, engine.key());
+  rndm::PhiloxEngine reference(12345L);
+  unsigned int const firstWord = static_cast<unsigned int>(reference);
+  check(firstWord == block0[0], "first word is from the first block");
+
+  // numbers are strictly between 0 and 1, and seeding restarts the sequence
+  std::vector<double> first(1000);
+  for (double& x: first) {
+    x = engine.flat();
+    check((x > 0.0) && (x < 1.0), "flat() range");
+  }
+  engine.setSeed(12345L);
+  bool same = true;
+  for (double x: first) same = same && (engine.flat() == x);
+  check(same, "sequence is restarted by setSeed()");
+
+  // different keys, or different streams, give different sequences
+  rndm::PhiloxEngine other(12346L);
+  engine.setSeed(12345L);
+  check(other.flat() != engine.flat(), "different seeds, different numbers");
+
+  long const seeds[] = { 12345L, 0L, 7L, 0L };
+  rndm::PhiloxEngine streamed;
+  streamed.setSeeds(seeds, 4);
+  check(streamed.key()[0] == 12345U, "setSeeds() key");
+  check(streamed.stream()[0] == 0U, "setSeeds() stops at the first 0");
+  long const streamSeeds[] = { 12345L, 3L, 7L, 0L };
+  streamed.setSeeds(streamSeeds, 3);
+  check(streamed.stream()[0] == 7U, "setSeeds() stream");
+  check(streamed.getSeeds()[2] == 7L, "getSeeds() after setSeeds()");
+} // TestSequence()
+
+
+void TestSkip() {
+  rndm::PhiloxEngine sequential(42L), skipping(42L);
+  for (unsigned int i = 0; i < 12345; ++i) sequential.flat();
+  skipping.skip(12345);
+  check(sequential.flat() == skipping.flat(), "skip() from the start");
+
+  // odd offsets and skips within the same block
+  sequential.flat();
+  skipping.skip(1);
+  check(sequential.flat() == skipping.flat(), "skip() within a block");
+
+  // a skip far away is as quick as a short one
+  rndm::PhiloxEngine far(42L);
+  far.skip(std::uint64_t(1) << 60);
+  check(far.position() == (std::uint64_t(1) << 61), "skip() far ahead");
+} // TestSkip()
+
+
+void TestFlatArray() {
+  // flatArray() must give the same numbers as flat(), from any position
+  for (unsigned int offset: { 0U, 1U, 2U, 3U }) {
+    for (int size: { 0, 1, 2, 5, 64, 101 }) {
+      rndm::PhiloxEngine single(7L), array(7L);
+      for (unsigned int i = 0; i < offset; ++i) {
+        single.flat();
+        array.flat();
+      }
+      std::vector<double> values(size + 1);
+      array.flatArray(size, values.data());
+      bool same = true;
+      for (int i = 0; i < size; ++i) same = same && (values[i] == single.flat());
+      check(same, "flatArray() matches flat()");
+      check(array.flat() == single.flat(), "flat() after flatArray()");
+    } // for size
+  } // for offset
+} // TestFlatArray()
+
+
+void TestState() {
+  rndm::PhiloxEngine engine(0x123456789AL);
+  for (unsigned int i = 0; i < 17; ++i) engine.flat();
+
+  // vector state
+  std::vector<unsigned long> const state = engine.put();
+  check(state.size() == rndm::PhiloxEngine::VECTOR_STATE_SIZE, "state size");
+  rndm::PhiloxEngine restored;
+  check(restored.get(state), "get(vector) accepts the state");
+  check(restored.getSeed() == engine.getSeed(), "seed restored from vector");
+  check(restored.flat() == engine.flat(), "state restored from vector");
+
+  // stream state
+  std::stringstream sstr;
+  engine.put(sstr);
+  rndm::PhiloxEngine fromStream(sstr);
+  check(fromStream.flat() == engine.flat(), "state restored from stream");
+
+  // a state from another engine is rejected
+  std::vector<unsigned long> wrong = state;
+  wrong[0] ^= 1UL;
+  rndm::PhiloxEngine unchanged(1L);
+  double const expected = rndm::PhiloxEngine(1L).flat();
+  check(!unchanged.get(wrong), "get(vector) rejects foreign states");
+  check(unchanged.flat() == expected, "state unchanged after rejection");
+} // TestState()
+
+
+void TestFloat() {
+  // the extreme words must still give numbers strictly between 0 and 1
+  float const lowest = rndm::PhiloxEngine::toFloat(0x00000000U);
+  float const highest = rndm::PhiloxEngine::toFloat(0xFFFFFFFFU);
+  check((lowest > 0.0f) && (lowest < 1.0f), "toFloat() of the minimum word");
+  check((highest > 0.0f) && (highest < 1.0f), "toFloat() of the maximum word");
+
+  rndm::PhiloxEngine engine(5L), reference(5L);
+  for (unsigned int i = 0; i < 1000; ++i) {
+    float const x = static_cast<float>(engine);
+    check(x == rndm::PhiloxEngine::toFloat(static_cast<unsigned int>(reference)),
+      "operator float() is toFloat() of the next word");
+    check((x > 0.0f) && (x < 1.0f), "operator float() range");
+  }
+} // TestFloat()
+
+
+//------------------------------------------------------------------------------
+int main() {
+  TestKnownAnswers();
+  TestSequence();
+  TestSkip();
+  TestFlatArray();
+  TestState();
+  TestFloat();
+
+  if (nErrors > 0) std::cerr << nErrors << " checks failed." << std::endl;
+  else             std::cout << "All checks passed." << std::endl;
+  return nErrors;
+} // main()
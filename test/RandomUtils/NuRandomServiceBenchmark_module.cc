@@ -0,0 +1,224 @@
+/**
+ * @file   NuRandomServiceBenchmark_module.cc
+ * @brief  Measures the per-event overhead of NuRandomService in an art job
+ * @date   October 16th, 2026
+ * @see    nurandombenchmark_base.fcl
+ */
+
+
+// art extensions
+#define NURANDOM_RANDOMUTILS_NuRandomService_USECLHEP 1 // to have NuSeedService.h define CLHEPengineSeeder
+#include "nurandom/RandomUtils/NuRandomService.h"
+
+// C++ includes.
+#include <string>
+#include <vector>
+#include <chrono>
+#include <optional>
+#include <functional> // std::reference_wrapper
+
+// CLHEP libraries
+#include "CLHEP/Random/RandomEngine.h" // CLHEP::HepRandomEngine
+
+// Supporting library include files
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// Framework includes.
+#include "art/Framework/Core/EDProducer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "art/Framework/Services/Optional/RandomNumberGenerator.h"
+
+
+namespace testing {
+
+  /**
+   * @brief Producer drawing random numbers from many engines, for timing
+   *
+   * The module creates `nEngines` engines via `art::RandomNumberGenerator`
+   * and, if `useNuRandomService` is set, registers them all in
+   * `rndm::NuRandomService` via `registerAndSeedEngine()`, or all at once via
+   * `registerAndSeedEngines()` if `bulkRegistration` is set.
+   * On each event, `nNumbers` numbers are drawn from each engine.
+   *
+   * The module measures the time spent creating and registering the engines
+   * in its constructor, and two times per event:
+   * * the time spent in `produce()`, which is the time needed to draw the
+   *   random numbers;
+   * * the time elapsed between the start of consecutive `produce()` calls,
+   *   which includes the framework overhead of one whole event, and in
+   *   particular the reseeding of all the engines of the job by
+   *   NuRandomService at the beginning of each event and each module.
+   *
+   * At the end of the job, the averages are printed (category
+   * `NuRandomServiceBenchmark`). The per-event overhead of NuRandomService is
+   * the difference of the per-event time between a job with
+   * `useNuRandomService: true` and the same job with `useNuRandomService:
+   * false` and no NuRandomService configured. The reseeding happens in the
+   * callbacks of the service, which the module can't time by itself: the
+   * per-event time of the reference job is given to the module as
+   * `referenceEventTime`, and the module reports the difference.
+   *
+   * Configuration parameters:
+   * - *nEngines* (unsigned integer, default: 1): number of engines
+   * - *nNumbers* (unsigned integer, default: 1): random numbers drawn from each
+   *   engine on each event
+   * - *useNuRandomService* (boolean, default: true): whether to register the
+   *   engines with NuRandomService; if not, engines are seeded by
+   *   `art::RandomNumberGenerator` only
+   * - *bulkRegistration* (boolean, default: false): whether to register all
+   *   the engines with a single call to NuRandomService
+   * - *baseSeed* (unsigned integer, default: 1): seed of the first engine
+   *   when not using NuRandomService; the following engines get the
+   *   following seeds
+   * - *referenceEventTime* (real, optional): average time between events, in
+   *   microseconds, from the same job without NuRandomService; if specified,
+   *   the overhead of NuRandomService is reported
+   *
+   */
+  class NuRandomServiceBenchmark: public art::EDProducer {
+      public:
+    using seed_t = art::detail::EngineCreator::seed_t;
+
+    explicit NuRandomServiceBenchmark(fhicl::ParameterSet const& pset);
+
+    void produce(art::Event& event) override;
+
+    void endJob() override;
+
+      private:
+    using clock_t = std::chrono::steady_clock;
+    using duration_t = std::chrono::duration<double>; // seconds
+
+    std::string moduleLabel; ///< label of this module
+    unsigned int nNumbers;   ///< numbers drawn per engine per event
+    bool useNuRandomService; ///< whether engines are managed by the service
+    bool bulkRegistration;   ///< whether engines are registered all at once
+    /// time between events without NuRandomService [us]
+    std::optional<double> referenceEventTime;
+
+    /// the engines owned by this module
+    std::vector<std::reference_wrapper<CLHEP::HepRandomEngine>> engines;
+
+    duration_t constructionTime{ 0.0 }; ///< time to create the engines
+    unsigned int nEvents = 0U;     ///< number of processed events
+    unsigned int nIntervals = 0U;  ///< number of measured event intervals
+    duration_t produceTime{ 0.0 }; ///< total time spent in `produce()`
+    duration_t eventTime{ 0.0 };   ///< total time between `produce()` calls
+    clock_t::time_point lastProduceStart; ///< start of last `produce()`
+
+    double sum = 0.0; ///< sum of all the numbers drawn (so they are not dropped)
+
+  }; // class NuRandomServiceBenchmark
+
+
+
+  //****************************************************************************
+  //--- NuRandomServiceBenchmark implementation
+  //---
+  NuRandomServiceBenchmark::NuRandomServiceBenchmark
+    (fhicl::ParameterSet const& pset)
+    : art::EDProducer{pset}
+    , moduleLabel{pset.get<std::string>("module_label")}
+    , nNumbers{pset.get<unsigned int>("nNumbers", 1U)}
+    , useNuRandomService{pset.get<bool>("useNuRandomService", true)}
+    , bulkRegistration{pset.get<bool>("bulkRegistration", false)}
+  {
+    auto const nEngines = pset.get<unsigned int>("nEngines", 1U);
+    auto const baseSeed = pset.get<seed_t>("baseSeed", 1);
+    double refTime;
+    if (pset.get_if_present("referenceEventTime", refTime))
+      referenceEventTime = refTime;
+
+    auto const start = clock_t::now();
+    engines.reserve(nEngines);
+    std::vector<rndm::NuRandomService::EngineAndInstance_t> bulkEngines;
+    for (unsigned int iEngine = 0; iEngine < nEngines; ++iEngine) {
+      std::string const instanceName = "engine" + std::to_string(iEngine);
+      if (useNuRandomService && bulkRegistration) {
+        engines.push_back(createEngine(0, "HepJamesRandom", instanceName));
+        bulkEngines.emplace_back(engines.back(), instanceName);
+      }
+      else if (useNuRandomService) {
+        engines.push_back(
+          art::ServiceHandle<rndm::NuRandomService>()->registerAndSeedEngine(
+            createEngine(0, "HepJamesRandom", instanceName),
+            "HepJamesRandom", instanceName
+          ));
+      }
+      else {
+        engines.push_back
+          (createEngine(baseSeed + iEngine, "HepJamesRandom", instanceName));
+      }
+    } // for
+    if (!bulkEngines.empty()) {
+      art::ServiceHandle<rndm::NuRandomService>()
+        ->registerAndSeedEngines(bulkEngines, "HepJamesRandom");
+    }
+    constructionTime = clock_t::now() - start;
+
+    mf::LogInfo("NuRandomServiceBenchmark")
+      << moduleLabel << ": " << engines.size() << " engines, " << nNumbers
+      << " numbers per engine per event, "
+      << (useNuRandomService? "with": "without") << " NuRandomService"
+      << (bulkRegistration? " (bulk registration)": "");
+
+  } // NuRandomServiceBenchmark::NuRandomServiceBenchmark()
+
+
+  //----------------------------------------------------------------------------
+  void NuRandomServiceBenchmark::produce(art::Event&) {
+
+    auto const start = clock_t::now();
+    if (nEvents++ > 0) {
+      eventTime += start - lastProduceStart;
+      ++nIntervals;
+    }
+    lastProduceStart = start;
+
+    for (CLHEP::HepRandomEngine& engine: engines) {
+      for (unsigned int i = 0; i < nNumbers; ++i) sum += engine.flat();
+    } // for
+
+    produceTime += clock_t::now() - start;
+
+  } // NuRandomServiceBenchmark::produce()
+
+
+  //----------------------------------------------------------------------------
+  void NuRandomServiceBenchmark::endJob() {
+
+    mf::LogInfo log("NuRandomServiceBenchmark");
+    log << moduleLabel << " ("
+      << (useNuRandomService? "with": "without") << " NuRandomService, "
+      << engines.size() << " engines x " << nNumbers << " numbers):"
+      << "\n  engine creation:            "
+        << (constructionTime.count() * 1e6) << " us"
+      << "\n  events processed:           " << nEvents;
+    if (nEvents > 0) {
+      log << "\n  average time in produce():  "
+        << (produceTime.count() / nEvents * 1e6) << " us/event";
+    }
+    if (nIntervals > 0) {
+      double const averageEventTime = eventTime.count() / nIntervals * 1e6;
+      log << "\n  average time between events: "
+        << averageEventTime << " us/event"
+        << " (" << nIntervals << " intervals)";
+      if (referenceEventTime) {
+        log << "\n  NuRandomService overhead:   "
+          << (averageEventTime - *referenceEventTime) << " us/event"
+          << " (reference: " << *referenceEventTime << " us/event)";
+      }
+    }
+    else {
+      log << "\n  not enough events to measure the time between events";
+    }
+    log << "\n  (checksum: " << sum << ")";
+
+  } // NuRandomServiceBenchmark::endJob()
+
+
+} // end namespace testing
+
+DEFINE_ART_MODULE(testing::NuRandomServiceBenchmark)
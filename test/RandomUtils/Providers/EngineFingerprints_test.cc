@@ -0,0 +1,131 @@
+/**
+ * @file   EngineFingerprints_test.cc
+ * @brief  Tests the writing and the comparison of engine fingerprint files
+ * @date   October 16th, 2026
+ * @see    nurandom/RandomUtils/Providers/EngineFingerprints.h
+ *
+ * The program returns the number of failed checks.
+ */
+
+// nurandom libraries
+#include "nurandom/RandomUtils/Providers/EngineFingerprints.h"
+
+// C/C++ standard libraries
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  using rndm::NuRandomServiceHelper::EngineFingerprintWriter;
+  using rndm::NuRandomServiceHelper::EngineFingerprintReader;
+  using rndm::SeedMasterHelper::EngineId;
+
+  unsigned int nErrors = 0;
+
+  void check(bool good, std::string const& what) {
+    if (good) return;
+    ++nErrors;
+    std::cerr << "FAILED: " << what << std::endl;
+  } // check()
+
+
+  /**
+   * @brief Writes a fingerprint file of a job with two engines
+   * @param path the file to be written
+   * @param nEvents number of events in the job
+   * @param divergentEvent event where the second engine changes its state
+   *
+   * The state of each engine is a counter, advanced at each event.
+   * On `divergentEvent` (if not `0`), the second engine is advanced twice.
+   */
+  void writeJob
+    (std::string const& path, std::uint32_t nEvents, std::uint32_t divergentEvent)
+  {
+    std::vector<unsigned long> states{ 0, 1000 };
+    EngineId const generator("generator"), noise("detsim", "noise");
+
+    EngineFingerprintWriter writer(path);
+    writer.watch(generator, [&states](){ return std::vector{ states[0] }; });
+    writer.watch(noise, [&states](){ return std::vector{ states[1] }; });
+
+    rndm::NuRandomServiceHelper::EventSeedInputData data;
+    data.runNumber = 1;
+    data.subRunNumber = 0;
+    for (std::uint32_t event = 1; event <= nEvents; ++event) {
+      data.eventNumber = event;
+      ++states[0];
+      writer.record(generator, data);
+      states[1] += (event == divergentEvent)? 2: 1;
+      writer.record(noise, data);
+      writer.record(EngineId("unknown"), data); // not watched: not recorded
+    } // for
+    check(writer.nRecords() == 2 * nEvents, "records written");
+  } // writeJob()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+void TestIdentical() {
+  writeJob("fingerprintsA.dat", 100, 0);
+  writeJob("fingerprintsB.dat", 100, 0);
+
+  EngineFingerprintReader a("fingerprintsA.dat"), b("fingerprintsB.dat");
+  check(a.isComplete(), "file has a trailer");
+  check(a.nRecords() == 200, "records read");
+  check(a.engineName(1) == "detsim.noise", "engine name");
+  check(!findFirstDivergence(a, b), "identical files (linear)");
+  check(!bisectFirstDivergence(a, b), "identical files (bisection)");
+} // TestIdentical()
+
+
+void TestDivergent() {
+  writeJob("fingerprintsA.dat", 100, 0);
+  writeJob("fingerprintsC.dat", 100, 37);
+
+  EngineFingerprintReader a("fingerprintsA.dat"), c("fingerprintsC.dat");
+  auto const linear = findFirstDivergence(a, c);
+  auto const bisection = bisectFirstDivergence(a, c);
+  check(linear.has_value(), "divergence found (linear)");
+  check(bisection.has_value(), "divergence found (bisection)");
+  if (!linear || !bisection) return;
+
+  check(linear->index == 2 * 36 + 1, "index of the divergence");
+  check(bisection->index == linear->index, "same result from bisection");
+  check(linear->first && linear->second, "both records present");
+  if (linear->first) {
+    check(linear->first->event == 37, "event of the divergence");
+    check(linear->first->engine == 1, "engine of the divergence");
+  }
+} // TestDivergent()
+
+
+void TestShorter() {
+  writeJob("fingerprintsA.dat", 100, 0);
+  writeJob("fingerprintsD.dat", 60, 0);
+
+  EngineFingerprintReader a("fingerprintsA.dat"), d("fingerprintsD.dat");
+  auto const linear = findFirstDivergence(a, d);
+  auto const bisection = bisectFirstDivergence(d, a);
+  check(linear && (linear->index == 120), "shorter file (linear)");
+  check(linear && linear->first && !linear->second, "missing record");
+  check(bisection && (bisection->index == 120), "shorter file (bisection)");
+  check(bisection && !bisection->first && bisection->second,
+    "missing record (bisection)");
+} // TestShorter()
+
+
+//------------------------------------------------------------------------------
+int main() {
+  TestIdentical();
+  TestDivergent();
+  TestShorter();
+
+  if (nErrors > 0) std::cerr << nErrors << " checks failed." << std::endl;
+  else             std::cout << "All checks passed." << std::endl;
+  return nErrors;
+} // main()
@@ -0,0 +1,144 @@
+/**
+ * @file   SeedCollisionMonitor_test.cc
+ * @brief  Tests the monitor of repeated per-event seeds
+ * @date   October 16th, 2026
+ * @see    nurandom/RandomUtils/Providers/SeedCollisionMonitor.h
+ *
+ * The program returns the number of failed checks.
+ */
+
+// nurandom libraries
+#include "nurandom/RandomUtils/Providers/SeedCollisionMonitor.h"
+
+// C/C++ standard libraries
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  using Monitor_t = rndm::SeedMasterHelper::SeedCollisionMonitor<std::uint64_t>;
+  using EventData_t = Monitor_t::EventData_t;
+
+  unsigned int nErrors = 0;
+
+  void check(bool good, std::string const& what) {
+    if (good) return;
+    ++nErrors;
+    std::cerr << "FAILED: " << what << std::endl;
+  } // check()
+
+
+  EventData_t makeEvent(std::uint32_t event) {
+    EventData_t data;
+    data.runNumber = 1;
+    data.subRunNumber = 0;
+    data.eventNumber = event;
+    return data;
+  } // makeEvent()
+
+
+  /// A small configuration, so that generations and history roll over quickly
+  Monitor_t::Config_t smallConfig() {
+    Monitor_t::Config_t config;
+    config.filterBits = 1 << 16;
+    config.nHashes = 4;
+    config.generationSize = 1000;
+    config.historySize = 100;
+    return config;
+  } // smallConfig()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+void TestDistinctSeeds() {
+  Monitor_t monitor(smallConfig());
+  rndm::SeedMasterHelper::EngineId const engine("generator");
+  // with 1000 seeds per generation in 65536 bits, false positives are ~1e-5
+  for (std::uint32_t i = 0; i < 20000; ++i) {
+    check(!monitor.insert(0x1000000ULL + i * 7919ULL, engine, makeEvent(i)),
+      "distinct seeds give no collision");
+  }
+  check(monitor.nSeeds() == 20000, "number of seeds");
+  check(monitor.nConfirmed() == 0, "no confirmed collision");
+  check(monitor.nCandidates() == monitor.nUnconfirmed(),
+    "candidates are all unconfirmed");
+  check(monitor.nCandidates() < 10, "few false positives");
+} // TestDistinctSeeds()
+
+
+void TestRecentCollision() {
+  Monitor_t monitor(smallConfig());
+  rndm::SeedMasterHelper::EngineId const first("generator"), second("detsim");
+
+  check(!monitor.insert(12345, first, makeEvent(1)), "first occurrence");
+  for (std::uint64_t seed = 1; seed <= 50; ++seed)
+    monitor.insert(seed, first, makeEvent(2));
+
+  // the same assignment again is not a collision, nor a new seed
+  check(!monitor.insert(12345, first, makeEvent(1)), "same engine and event");
+  check(monitor.nSeeds() == 51, "same assignment not counted");
+  check(monitor.nCandidates() == 0, "same assignment not a candidate");
+
+  auto const collision = monitor.insert(12345, second, makeEvent(3));
+  check(collision.has_value(), "collision with another engine");
+  if (collision) {
+    check(collision->previous.engine == first, "previous engine");
+    check(collision->previous.event.event == 1, "previous event");
+    check(collision->current.engine == second, "current engine");
+    check(collision->current.event.event == 3, "current event");
+  }
+  check(monitor.nConfirmed() == 1, "one confirmed collision");
+
+  // the same engine in a different event is also a collision
+  check(monitor.insert(12345, second, makeEvent(4)).has_value(),
+    "collision with another event");
+  check(monitor.nConfirmed() == 2, "two confirmed collisions");
+
+  // earlier assignments of a colliding seed, inserted again, are not new
+  check(!monitor.insert(12345, first, makeEvent(1)),
+    "first assignment again after collisions");
+  check(!monitor.insert(12345, second, makeEvent(3)),
+    "second assignment again after collisions");
+  check(monitor.nConfirmed() == 2, "assignments again not confirmed");
+  check(monitor.nSeeds() == 53, "assignments again not counted");
+} // TestRecentCollision()
+
+
+void TestOldCollision() {
+  Monitor_t monitor(smallConfig());
+  rndm::SeedMasterHelper::EngineId const engine("generator");
+
+  monitor.insert(12345, engine, makeEvent(1));
+  // push the seed out of the history, but not out of the filters
+  for (std::uint64_t seed = 1; seed <= 500; ++seed)
+    monitor.insert(seed, engine, makeEvent(2));
+
+  check(!monitor.insert(12345, engine, makeEvent(3)), "old seed not confirmed");
+  check(monitor.nConfirmed() == 0, "no confirmed collision");
+  check(monitor.nUnconfirmed() >= 1, "old seed counted as unconfirmed");
+
+  // after two whole generations the seed is forgotten
+  std::size_t const nUnconfirmed = monitor.nUnconfirmed();
+  for (std::uint64_t seed = 1000001; seed <= 1002000; ++seed)
+    monitor.insert(seed, engine, makeEvent(4));
+  std::size_t const nCandidates = monitor.nCandidates();
+  monitor.insert(12345, engine, makeEvent(5));
+  check(monitor.nCandidates() == nCandidates, "old generations discarded");
+  check(monitor.nUnconfirmed() >= nUnconfirmed, "statistics are kept");
+} // TestOldCollision()
+
+
+//------------------------------------------------------------------------------
+int main() {
+  TestDistinctSeeds();
+  TestRecentCollision();
+  TestOldCollision();
+
+  if (nErrors > 0) std::cerr << nErrors << " checks failed." << std::endl;
+  else             std::cout << "All checks passed." << std::endl;
+  return nErrors;
+} // main()
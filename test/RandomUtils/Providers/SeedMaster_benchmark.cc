@@ -0,0 +1,497 @@
+/**
+ * @file   SeedMaster_benchmark.cc
+ * @brief  Times the main operations of SeedMaster, core of NuRandomService
+ * @date   October 16th, 2026
+ * @see    SeedMaster_test.cc SeedMaster.h
+ *
+ * This program does not depend on art: like `SeedMaster_test`, it drives
+ * `rndm::SeedMaster<unsigned long>` directly. The configuration of each
+ * policy is synthesized in the program, so that any number of engines can be
+ * served.
+ *
+ * Usage:
+ *
+ *     SeedMaster_benchmark [options]
+ *
+ * Options:
+ * * `--policies` _Name[,Name...]_: policies to be timed
+ *   (default: all of `autoIncrement`, `linearMapping`, `preDefinedOffset`,
+ *   `preDefinedSeed`, `random` and `perEvent`)
+ * * `--engines` _N[,N...]_: number of engines to register
+ *   (default: `10,100,1000,10000,100000`)
+ * * `--events` _N[,N...]_: number of events to simulate
+ *   (default: `1,100,10000,1000000`)
+ * * `--maxCalls` _N_: configurations where the number of engines times the
+ *   number of events exceeds this number skip the per-event part
+ *   (default: 100000000)
+ * * `--output` _Path_: file where the results are written
+ *   (default: `SeedMaster_benchmark.json`)
+ *
+ * For each policy, engine number and event number, the following operations
+ * are timed over all the engines (and all the events for the per-event ones):
+ * * `registerNewSeeder`: registration of a new engine
+ * * `getSeed:new`: first request of the configured seed of each engine; this
+ *   includes the call to the policy and the uniqueness check
+ *   (`SeedMaster::ensureUnique()`) on the policies yielding unique seeds
+ * * `getSeed:known`: request of an already assigned configured seed
+ * * `reseed`: reseeding of the engine with its configured seed
+ * * `engineHandle`: assignment of the handle of each engine
+ * * `getSeed:handle`: request of the configured seed via the engine handle
+ * * `reseed:handle`: reseeding of the engine via its handle
+ * * `registerNewSeeders`: registration of all the engines in a single call,
+ *   including the assignment of their seeds and the uniqueness check (on a
+ *   new SeedMaster); this is the bulk equivalent of `registerNewSeeder` plus
+ *   `getSeed:new`
+ * * `getEventSeed`: request of the event seed, on each event
+ * * `reseedEvent`: reseeding of the engine with the event seed, on each event
+ *
+ * The results are written in JSON format as a list of records, each one with
+ * `policy`, `engines`, `events`, `operation`, `calls`, `seconds` and
+ * `nsPerCall` keys. If a configuration fails (e.g. because of a seed clash in
+ * `random` policy) the record of that configuration carries an `error` key
+ * with the error message instead of the timing.
+ */
+
+// C/C++ standard libraries
+#include <cstdlib>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+// utility libraries
+#include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// art libraries
+#include "canvas/Utilities/Exception.h"
+
+// art extensions
+#include "nurandom/RandomUtils/Providers/SeedMaster.h"
+#include "nurandom/RandomUtils/Providers/JSONstring.h"
+
+
+//------------------------------------------------------------------------------
+//--- stuff to facilitate the interaction with SeedMaster
+//---
+using seed_t = unsigned long;
+using SeedMaster_t = rndm::SeedMaster<seed_t>;
+using EngineId = SeedMaster_t::EngineId;
+
+/// Number of engine instances assigned to each module label
+constexpr unsigned int InstancesPerModule = 10;
+
+/// Returns the module label for the engine with the specified index
+inline std::string ModuleLabel(unsigned int iEngine)
+  { return "bench" + std::to_string(iEngine / InstancesPerModule); }
+
+/// Returns the instance name for the engine with the specified index
+inline std::string InstanceName(unsigned int iEngine)
+  { return "e" + std::to_string(iEngine % InstancesPerModule); }
+
+
+/// Returns the identifiers of nEngines engines
+std::vector<EngineId> MakeEngineIDs(unsigned int nEngines) {
+  std::vector<EngineId> IDs;
+  IDs.reserve(nEngines);
+  for (unsigned int iEngine = 0; iEngine < nEngines; ++iEngine)
+    IDs.emplace_back(ModuleLabel(iEngine), InstanceName(iEngine));
+  return IDs;
+} // MakeEngineIDs()
+
+
+/// Returns the configuration of the specified policy serving nEngines engines
+fhicl::ParameterSet MakePolicyConfiguration
+  (std::string const& policy, unsigned int nEngines)
+{
+  fhicl::ParameterSet pset;
+  pset.put<std::string>("policy", policy);
+  pset.put<int>("verbosity", 0);
+
+  if (policy == "autoIncrement") {
+    pset.put<seed_t>("baseSeed", 1);
+    pset.put<seed_t>("maxUniqueEngines", nEngines);
+    pset.put<bool>("checkRange", true);
+  }
+  else if (policy == "linearMapping") {
+    pset.put<seed_t>("nJob", 1);
+    pset.put<seed_t>("maxUniqueEngines", nEngines);
+    pset.put<bool>("checkRange", true);
+  }
+  else if ((policy == "preDefinedOffset") || (policy == "preDefinedSeed")) {
+    bool const isOffset = (policy == "preDefinedOffset");
+    if (isOffset) {
+      pset.put<seed_t>("baseSeed", 1);
+      pset.put<seed_t>("maxUniqueEngines", nEngines);
+      pset.put<bool>("checkRange", true);
+    }
+    fhicl::ParameterSet modulePSet;
+    for (unsigned int iEngine = 0; iEngine < nEngines; ++iEngine) {
+      modulePSet.put<seed_t>
+        (InstanceName(iEngine), isOffset? iEngine: iEngine + 1);
+      if ((iEngine % InstancesPerModule == InstancesPerModule - 1)
+        || (iEngine == nEngines - 1))
+      {
+        pset.put(ModuleLabel(iEngine), modulePSet);
+        modulePSet = fhicl::ParameterSet();
+      }
+    } // for
+  }
+  else if (policy == "random") {
+    pset.put<seed_t>("masterSeed", 2829);
+  }
+  // perEvent: default configuration
+
+  return pset;
+} // MakePolicyConfiguration()
+
+
+/// Returns the event data for the specified event
+SeedMaster_t::EventData_t MakeEventData(unsigned int iEvent) {
+  SeedMaster_t::EventData_t data;
+  data.clear();
+  data.runNumber = 1;
+  data.subRunNumber = 1 + iEvent / 1000;
+  data.eventNumber = 1 + iEvent;
+  data.time = 1400000000ULL * 1000000000ULL + iEvent;
+  data.isTimeValid = true;
+  data.processName = "SeedMasterBenchmark";
+  return data;
+} // MakeEventData()
+
+
+//------------------------------------------------------------------------------
+//--- stuff to facilitate the use of message facility
+//---
+void StartMessageFacility() {
+  // debug messages from the policies would dominate the timing
+  std::string const MessageFacilityConfiguration = R"(
+  destinations : {
+    stdout: {
+      type:      cout
+      threshold: INFO
+      categories: {
+        default: {
+          limit : -1
+        }
+      } // categories
+    } // stdout
+  } // destinations
+  )";
+  mf::StartMessageFacility
+    (fhicl::ParameterSet::make(MessageFacilityConfiguration));
+  mf::SetApplicationName("SeedMaster_benchmark");
+} // StartMessageFacility()
+
+
+//------------------------------------------------------------------------------
+//--- stuff to facilitate the timing
+//---
+
+/// Result of the timing of a single operation
+struct TimingRecord_t {
+  std::string policy;
+  unsigned int nEngines = 0;
+  unsigned int nEvents = 0;
+  std::string operation;
+  unsigned long long nCalls = 0;
+  double seconds = 0.;
+  std::string error;
+}; // TimingRecord_t
+
+
+/// Times the execution of op(), and returns the elapsed time in seconds
+template <typename Op>
+double TimeIt(Op op) {
+  auto const start = std::chrono::steady_clock::now();
+  op();
+  auto const stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+} // TimeIt()
+
+
+/// Writes all the records in JSON format
+void PrintRecords
+  (std::ostream& out, std::vector<TimingRecord_t> const& records)
+{
+  out << "[";
+  bool first = true;
+  for (TimingRecord_t const& record: records) {
+    out << (first? "\n  { \"policy\": ": ",\n  { \"policy\": ");
+    first = false;
+    rndm::details::printJSONstring(out, record.policy);
+    out << ", \"engines\": " << record.nEngines
+      << ", \"events\": " << record.nEvents
+      << ", \"operation\": ";
+    rndm::details::printJSONstring(out, record.operation);
+    if (!record.error.empty()) {
+      out << ", \"error\": ";
+      rndm::details::printJSONstring(out, record.error);
+    }
+    else {
+      out << ", \"calls\": " << record.nCalls
+        << ", \"seconds\": " << std::setprecision(9) << record.seconds
+        << ", \"nsPerCall\": " << std::setprecision(6)
+        << ((record.nCalls > 0)? record.seconds * 1e9 / record.nCalls: 0.);
+    }
+    out << " }";
+  } // for
+  out << (first? "]\n": "\n]\n");
+} // PrintRecords()
+
+
+/// Times all the operations for one policy/engines/events configuration
+std::vector<TimingRecord_t> BenchmarkConfiguration(
+  std::string const& policy, unsigned int nEngines, unsigned int nEvents,
+  unsigned long long maxCalls
+) {
+  std::vector<TimingRecord_t> records;
+  TimingRecord_t const baseRecord{ policy, nEngines, nEvents, "", 0, 0., "" };
+  auto const addRecord
+    = [&](std::string const& operation, unsigned long long nCalls, double t)
+    {
+      records.push_back(baseRecord);
+      records.back().operation = operation;
+      records.back().nCalls = nCalls;
+      records.back().seconds = t;
+    };
+
+  std::vector<EngineId> const IDs = MakeEngineIDs(nEngines);
+
+  // the seeder does not seed any engine, but it keeps the seed alive
+  seed_t seedSink = 0;
+  SeedMaster_t::Seeder_t seeder
+    = [&seedSink](EngineId const&, seed_t seed){ seedSink += seed; };
+
+  std::string operation = "construction";
+  try {
+    SeedMaster_t seeds(MakePolicyConfiguration(policy, nEngines));
+
+    operation = "registerNewSeeder";
+    addRecord(operation, IDs.size(), TimeIt([&](){
+      for (EngineId const& id: IDs) seeds.registerNewSeeder(id, seeder);
+    }));
+
+    operation = "getSeed:new";
+    addRecord(operation, IDs.size(), TimeIt([&](){
+      for (EngineId const& id: IDs) seedSink += seeds.getSeed(id);
+    }));
+
+    operation = "getSeed:known";
+    addRecord(operation, IDs.size(), TimeIt([&](){
+      for (EngineId const& id: IDs) seedSink += seeds.getSeed(id);
+    }));
+
+    operation = "reseed";
+    addRecord(operation, IDs.size(), TimeIt([&](){
+      for (EngineId const& id: IDs) seedSink += seeds.reseed(id);
+    }));
+
+    std::vector<SeedMaster_t::EngineHandle> handles;
+    handles.reserve(IDs.size());
+    operation = "engineHandle";
+    addRecord(operation, IDs.size(), TimeIt([&](){
+      for (EngineId const& id: IDs) handles.push_back(seeds.engineHandle(id));
+    }));
+
+    operation = "getSeed:handle";
+    addRecord(operation, handles.size(), TimeIt([&](){
+      for (auto handle: handles) seedSink += seeds.getSeed(handle);
+    }));
+
+    operation = "reseed:handle";
+    addRecord(operation, handles.size(), TimeIt([&](){
+      for (auto handle: handles) seedSink += seeds.reseed(handle);
+    }));
+
+    operation = "registerNewSeeders";
+    {
+      SeedMaster_t bulkSeeds(MakePolicyConfiguration(policy, nEngines));
+      std::vector<SeedMaster_t::SeederRegistration_t> batch;
+      batch.reserve(IDs.size());
+      for (EngineId const& id: IDs) batch.emplace_back(id, seeder);
+      addRecord(operation, IDs.size(), TimeIt([&](){
+        for (seed_t seed: bulkSeeds.registerNewSeeders(batch)) seedSink += seed;
+      }));
+    }
+
+    unsigned long long const nEventCalls
+      = static_cast<unsigned long long>(nEngines) * nEvents;
+    if (nEventCalls > maxCalls) {
+      mf::LogInfo("SeedMaster_benchmark")
+        << "Skipping per-event operations for " << policy << " with "
+        << nEngines << " engines and " << nEvents << " events ("
+        << nEventCalls << " calls exceed the limit of " << maxCalls << ")";
+      return records;
+    }
+
+    std::vector<SeedMaster_t::EventData_t> eventData;
+    eventData.reserve(nEvents);
+    for (unsigned int iEvent = 0; iEvent < nEvents; ++iEvent)
+      eventData.push_back(MakeEventData(iEvent));
+
+    operation = "getEventSeed";
+    addRecord(operation, nEventCalls, TimeIt([&](){
+      for (SeedMaster_t::EventData_t const& data: eventData) {
+        seeds.onNewEvent();
+        for (EngineId const& id: IDs)
+          seedSink += seeds.getEventSeed(data, id);
+      } // for events
+    }));
+
+    operation = "reseedEvent";
+    addRecord(operation, nEventCalls, TimeIt([&](){
+      for (SeedMaster_t::EventData_t const& data: eventData) {
+        seeds.onNewEvent();
+        for (EngineId const& id: IDs)
+          seedSink += seeds.reseedEvent(id, data);
+      } // for events
+    }));
+
+  }
+  catch (std::exception const& e) {
+    records.push_back(baseRecord);
+    records.back().operation = operation;
+    records.back().error = e.what();
+    mf::LogWarning("SeedMaster_benchmark")
+      << "Policy " << policy << " with " << nEngines << " engines and "
+      << nEvents << " events failed during " << operation << ":\n"
+      << e.what();
+  }
+
+  // print the sink, so that the compiler can't optimise the calls away
+  MF_LOG_DEBUG("SeedMaster_benchmark") << "Seed checksum: " << seedSink;
+
+  return records;
+} // BenchmarkConfiguration()
+
+
+//------------------------------------------------------------------------------
+//--- command line parsing
+//---
+
+/// Splits a comma-separated list
+std::vector<std::string> SplitList(std::string const& list) {
+  std::vector<std::string> items;
+  std::istringstream sstr(list);
+  std::string item;
+  while (std::getline(sstr, item, ',')) if (!item.empty()) items.push_back(item);
+  return items;
+} // SplitList()
+
+
+/// Splits a comma-separated list of numbers
+std::vector<unsigned int> SplitNumbers(std::string const& list) {
+  std::vector<unsigned int> numbers;
+  for (std::string const& item: SplitList(list))
+    numbers.push_back(std::stoul(item));
+  return numbers;
+} // SplitNumbers()
+
+
+void PrintUsage(const char* programName) {
+  std::cerr << "Usage: " << programName << " [options]"
+    "\n  --policies Name[,Name...]  policies to be timed"
+    "\n  --engines N[,N...]         numbers of engines"
+    "\n  --events N[,N...]          numbers of events"
+    "\n  --maxCalls N               limit of per-event calls per configuration"
+    "\n  --output Path              JSON output file"
+    << std::endl;
+} // PrintUsage()
+
+
+//------------------------------------------------------------------------------
+int main(int argc, const char** argv) {
+
+  std::vector<std::string> policies{
+    "autoIncrement", "linearMapping", "preDefinedOffset", "preDefinedSeed",
+    "random", "perEvent"
+    };
+  std::vector<unsigned int> engineCounts{ 10, 100, 1000, 10000, 100000 };
+  std::vector<unsigned int> eventCounts{ 1, 100, 10000, 1000000 };
+  unsigned long long maxCalls = 100000000ULL;
+  std::string outputPath = "SeedMaster_benchmark.json";
+
+  //****************************************************************************
+  //*** parse the command line
+  //***
+  try {
+    for (int iParam = 1; iParam < argc; ++iParam) {
+      std::string const option = argv[iParam];
+      if ((option == "-h") || (option == "--help")) {
+        PrintUsage(argv[0]);
+        return 0;
+      }
+      if (++iParam >= argc) {
+        std::cerr << "Option '" << option << "' requires an argument."
+          << std::endl;
+        PrintUsage(argv[0]);
+        return 1;
+      }
+      std::string const value = argv[iParam];
+      if      (option == "--policies") policies     = SplitList(value);
+      else if (option == "--engines")  engineCounts = SplitNumbers(value);
+      else if (option == "--events")   eventCounts  = SplitNumbers(value);
+      else if (option == "--maxCalls") maxCalls     = std::stoull(value);
+      else if (option == "--output")   outputPath   = value;
+      else {
+        std::cerr << "Unknown option: '" << option << "'" << std::endl;
+        PrintUsage(argv[0]);
+        return 1;
+      }
+    } // for
+  }
+  catch (std::logic_error const& e) { // from std::stoul() and the like
+    std::cerr << "Invalid number on the command line: " << e.what()
+      << std::endl;
+    return 1;
+  }
+
+  StartMessageFacility();
+  
+  //****************************************************************************
+  //*** run all the configurations
+  //***
+  std::vector<TimingRecord_t> records;
+  unsigned int nErrors = 0;
+  for (std::string const& policy: policies) {
+    for (unsigned int nEngines: engineCounts) {
+      for (unsigned int nEvents: eventCounts) {
+        std::vector<TimingRecord_t> results
+          = BenchmarkConfiguration(policy, nEngines, nEvents, maxCalls);
+        for (TimingRecord_t& result: results) {
+          if (!result.error.empty()) ++nErrors;
+          else {
+            mf::LogInfo("SeedMaster_benchmark") << policy
+              << " [" << nEngines << " engines, " << nEvents << " events] "
+              << result.operation << ": " << (result.seconds * 1e9
+                / ((result.nCalls > 0)? result.nCalls: 1))
+              << " ns/call";
+          }
+          records.push_back(std::move(result));
+        } // for results
+      } // for events
+    } // for engines
+  } // for policies
+
+  //****************************************************************************
+  //*** write the results
+  //***
+  std::ofstream outputFile(outputPath);
+  if (!outputFile) {
+    mf::LogError("SeedMaster_benchmark")
+      << "Can't write benchmark results into '" << outputPath << "'";
+    return 1;
+  }
+  PrintRecords(outputFile, records);
+  mf::LogInfo("SeedMaster_benchmark")
+    << records.size() << " timing records written into '" << outputPath
+    << "' (" << nErrors << " failed configurations)";
+
+  return 0;
+} // main()
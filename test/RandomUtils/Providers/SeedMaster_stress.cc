@@ -0,0 +1,631 @@
+/**
+ * @file   SeedMaster_stress.cc
+ * @brief  Exercises SeedMaster from many threads, as NuRandomService does
+ * @date   October 16th, 2026
+ * @see    SeedMaster_test.cc SeedMaster_benchmark.cc SeedMaster.h
+ *
+ * This program does not depend on art: like `SeedMaster_test`, it drives
+ * `rndm::SeedMaster<unsigned long>` directly.
+ *
+ * `SeedMaster` is not thread-safe by itself: `NuRandomService` serializes all
+ * its calls with a single mutex, and the only call made outside of it is the
+ * computation of per-event seeds in advance (`computeEventSeeds()`).
+ * This program reproduces that pattern with one thread per schedule. Each
+ * thread registers one replica of each of the modules, queries and reseeds its
+ * engines, and then processes its share of the events, while also querying
+ * the engines of the other schedules. The seeds of each event are obtained
+ * either on demand (`reseedEvent()`) or computed in advance outside the lock
+ * and then adopted (`adoptEventSeeds()`).
+ *
+ * The engines are simulated: each one keeps the last seed it was given, and
+ * on each event it draws some numbers from a `std::mt19937_64` seeded with it.
+ * The program verifies that:
+ * * the configured seeds of the engines are the expected ones, and that
+ *   each engine is reseeded with its own seed;
+ * * the per-event seed of each engine and the checksum of the numbers it
+ *   draws depend only on the event and on the engine, and they are the same
+ *   with any number of threads (the results with the first thread count are
+ *   the reference for the others).
+ *
+ * With the `linearMapping` policy, the configured seeds depend on the order
+ * the threads happen to register their engines in, and there are no per-event
+ * seeds. The program then verifies instead that all the engines together get
+ * exactly the seeds of the job range, each one once, that the seeds of the
+ * engines of each thread increase in the order of their registration, and
+ * that each engine keeps its seed through the events.
+ *
+ * The program is meant to be run also in a build instrumented with
+ * ThreadSanitizer (e.g. configuring with
+ * `-DCMAKE_CXX_FLAGS="-fsanitize=thread -g"`): all the data shared among
+ * threads is accessed under the lock, and each thread joins before its
+ * results are read, so that any report points to an actual problem.
+ *
+ * Usage:
+ *
+ *     SeedMaster_stress [options]
+ *
+ * Options:
+ * * `--threads` _N[,N...]_: numbers of threads (and schedules) to run with
+ *   (default: `1,2,4,8`)
+ * * `--modules` _N_: number of modules, each with a replica per schedule
+ *   (default: `4`)
+ * * `--instances` _N_: number of engines in each module (default: `8`)
+ * * `--events` _N_: number of events, shared among the threads
+ *   (default: `500`)
+ * * `--policy` _name_: `perEvent` (default) or `linearMapping`
+ *
+ * The program returns the number of failed checks.
+ */
+
+// C/C++ standard libraries
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <mutex>
+#include <thread>
+#include <random>
+#include <sstream>
+#include <iostream>
+#include <condition_variable>
+
+// utility libraries
+#include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// art libraries
+#include "canvas/Utilities/Exception.h"
+
+// art extensions
+#include "nurandom/RandomUtils/Providers/SeedMaster.h"
+
+
+//------------------------------------------------------------------------------
+//--- stuff to facilitate the interaction with SeedMaster
+//---
+using seed_t = unsigned long;
+using SeedMaster_t = rndm::SeedMaster<seed_t>;
+using EngineId = SeedMaster_t::EngineId;
+using ScheduleNumber_t = rndm::SeedMasterHelper::ScheduleNumber_t;
+
+/// Numbers drawn by each engine on each event
+constexpr unsigned int DrawsPerEvent = 16;
+
+/// Settings of a stress run
+struct StressConfig_t {
+  unsigned int nModules = 4;
+  unsigned int nInstances = 8;
+  unsigned int nEvents = 500;
+  unsigned int maxThreads = 8; ///< Schedules in the policy configuration.
+  std::string policy = "perEvent"; ///< Seed policy.
+  
+  /// Returns whether the configured seeds depend on the registration order.
+  bool orderedSeeds() const { return policy == "linearMapping"; }
+}; // StressConfig_t
+
+
+/// Returns the label of the module with the specified index
+inline std::string ModuleLabel(unsigned int iModule)
+  { return "stress" + std::to_string(iModule); }
+
+/// Returns the instance name of the engine with the specified index
+inline std::string InstanceName(unsigned int iInstance)
+  { return "e" + std::to_string(iInstance); }
+
+
+/// Returns the configured seed expected for the specified engine
+seed_t ExpectedSeed(
+  StressConfig_t const& config,
+  unsigned int iModule, unsigned int iInstance, ScheduleNumber_t schedule
+) {
+  return 1 + (schedule * config.nModules + iModule) * config.nInstances
+    + iInstance;
+} // ExpectedSeed()
+
+
+/// Returns the number of engines of all the schedules
+inline std::size_t TotalEngines
+  (StressConfig_t const& config, unsigned int nThreads)
+  { return std::size_t(nThreads) * config.nModules * config.nInstances; }
+
+
+/**
+ * @brief Returns the configuration of the policy
+ *
+ * The `perEvent` policy takes the configured seeds from a `preDefinedSeed`
+ * policy, with one seed for each schedule, so that they do not depend on the
+ * order the engines are registered in.
+ * The `linearMapping` policy is for job `0`, with room for the engines of
+ * `maxThreads` schedules: its seeds start from `1`.
+ */
+fhicl::ParameterSet MakePolicyConfiguration(StressConfig_t const& config) {
+  if (config.policy == "linearMapping") {
+    fhicl::ParameterSet pset;
+    pset.put<std::string>("policy", "linearMapping");
+    pset.put<unsigned int>("nJob", 0U);
+    pset.put<unsigned int>
+      ("maxUniqueEngines", TotalEngines(config, config.maxThreads));
+    pset.put<bool>("checkRange", true);
+    pset.put<int>("verbosity", 0);
+    return pset;
+  } // if linearMapping
+  
+  fhicl::ParameterSet initSeedPolicy;
+  initSeedPolicy.put<std::string>("policy", "preDefinedSeed");
+  for (unsigned int iModule = 0; iModule < config.nModules; ++iModule) {
+    fhicl::ParameterSet modulePSet;
+    for (unsigned int iInstance = 0; iInstance < config.nInstances; ++iInstance)
+    {
+      std::vector<seed_t> seeds;
+      for (ScheduleNumber_t sched = 0; sched < config.maxThreads; ++sched)
+        seeds.push_back(ExpectedSeed(config, iModule, iInstance, sched));
+      modulePSet.put(InstanceName(iInstance), seeds);
+    } // for instances
+    initSeedPolicy.put(ModuleLabel(iModule), modulePSet);
+  } // for modules
+
+  fhicl::ParameterSet pset;
+  pset.put<std::string>("policy", "perEvent");
+  pset.put<int>("verbosity", 0);
+  pset.put("initSeedPolicy", initSeedPolicy);
+  return pset;
+} // MakePolicyConfiguration()
+
+
+/// Returns the event data for the specified event
+SeedMaster_t::EventData_t MakeEventData(unsigned int iEvent) {
+  SeedMaster_t::EventData_t data;
+  data.clear();
+  data.runNumber = 1;
+  data.subRunNumber = 1 + iEvent / 100;
+  data.eventNumber = 1 + iEvent;
+  data.time = 1400000000ULL * 1000000000ULL + iEvent;
+  data.isTimeValid = true;
+  data.processName = "SeedMasterStress";
+  return data;
+} // MakeEventData()
+
+
+/// Returns a checksum of the numbers drawn from a generator with `seed`
+std::uint64_t DrawChecksum(seed_t seed) {
+  std::mt19937_64 engine(seed);
+  std::uint64_t checksum = 0xCBF29CE484222325ULL; // FNV-1a
+  for (unsigned int i = 0; i < DrawsPerEvent; ++i) {
+    checksum ^= engine();
+    checksum *= 0x100000001B3ULL;
+  }
+  return checksum;
+} // DrawChecksum()
+
+
+//------------------------------------------------------------------------------
+//--- stuff to facilitate the use of message facility
+//---
+void StartMessageFacility() {
+  std::string const MessageFacilityConfiguration = R"(
+  destinations : {
+    stdout: {
+      type:      cout
+      threshold: INFO
+      categories: {
+        default: {
+          limit : -1
+        }
+      } // categories
+    } // stdout
+  } // destinations
+  )";
+  mf::StartMessageFacility
+    (fhicl::ParameterSet::make(MessageFacilityConfiguration));
+  mf::SetApplicationName("SeedMaster_stress");
+} // StartMessageFacility()
+
+
+//------------------------------------------------------------------------------
+//--- the stress run
+//---
+
+/// Identification of the use of an engine in an event, schedule-independent
+using EventEngineKey_t = std::tuple<unsigned int, std::string, std::string>;
+
+/// Seed and checksum of the numbers drawn by an engine in an event
+using EventEngineResult_t = std::pair<seed_t, std::uint64_t>;
+
+/// Results of a stress run
+struct StressResult_t {
+  /// Per-event seeds and checksums of all engines in all events
+  std::map<EventEngineKey_t, EventEngineResult_t> events;
+  std::vector<std::string> errors; ///< Description of the failed checks.
+}; // StressResult_t
+
+
+/// A `SeedMaster` with all calls serialized, as in `NuRandomService`
+class LockedSeedMaster {
+    public:
+  explicit LockedSeedMaster(fhicl::ParameterSet const& pset): seeds(pset) {}
+
+  /// Calls `op(seeds)` under the lock and returns its result.
+  template <typename Op>
+  auto with(Op op) { std::lock_guard const lock{ mutex }; return op(seeds); }
+
+  /// Access without lock; only allowed where `SeedMaster` explicitly permits.
+  SeedMaster_t const& unlocked() const { return seeds; }
+
+    private:
+  std::mutex mutex;
+  SeedMaster_t seeds;
+}; // LockedSeedMaster
+
+
+/// Makes all the threads start together, to maximize the contention
+class StartingLine {
+    public:
+  explicit StartingLine(unsigned int nThreads): nWaiting(nThreads) {}
+
+  void arriveAndWait()
+    {
+      std::unique_lock lock{ mutex };
+      if (--nWaiting == 0) cv.notify_all();
+      else cv.wait(lock, [this](){ return nWaiting == 0; });
+    }
+
+    private:
+  std::mutex mutex;
+  std::condition_variable cv;
+  unsigned int nWaiting;
+}; // StartingLine
+
+
+/**
+ * @brief Work of the thread serving one schedule
+ * @param seeds the shared seed master
+ * @param start synchronization of the start of all the threads
+ * @param config settings of the run
+ * @param schedule the schedule served by this thread
+ * @param nThreads total number of threads
+ * @param result where to write results and errors (owned by this thread)
+ */
+void ScheduleWork(
+  LockedSeedMaster& seeds, StartingLine& start, StressConfig_t const& config,
+  ScheduleNumber_t schedule, unsigned int nThreads, StressResult_t& result
+) {
+  auto const error = [&result, schedule](std::string msg)
+    { result.errors.push_back("[schedule " + std::to_string(schedule) + "] " + msg); };
+
+  // the simulated engines: the seeder is called under the lock, but only by
+  // this thread, so that this thread can also read the state without lock
+  std::map<EngineId, seed_t> engineState;
+  SeedMaster_t::Seeder_t const seeder
+    = [&engineState](EngineId const& id, seed_t seed){ engineState[id] = seed; };
+
+  std::vector<EngineId> IDs;
+  for (unsigned int iModule = 0; iModule < config.nModules; ++iModule) {
+    for (unsigned int iInstance = 0; iInstance < config.nInstances; ++iInstance)
+      IDs.emplace_back(ModuleLabel(iModule), InstanceName(iInstance), schedule);
+  }
+  for (EngineId const& id: IDs) engineState[id] = SeedMaster_t::InvalidSeed;
+
+  start.arriveAndWait();
+
+  //
+  // registration, query and reseed of the configured seeds
+  //
+  std::vector<SeedMaster_t::EngineHandle> handles;
+  std::map<EngineId, seed_t> jobSeeds;
+  seed_t previousSeed = SeedMaster_t::InvalidSeed;
+  for (EngineId const& id: IDs) {
+    seeds.with([&](SeedMaster_t& sm){ sm.registerNewSeeder(id, seeder); });
+    seed_t const seed = seeds.with([&](SeedMaster_t& sm){ return sm.getSeed(id); });
+    if (config.orderedSeeds()) {
+      // other threads may take seeds in between, but not earlier ones
+      if (seed <= previousSeed) {
+        error("engine " + std::string(id) + " has seed " + std::to_string(seed)
+          + ", not after " + std::to_string(previousSeed)
+          + " of the engine registered before it");
+      }
+      previousSeed = seed;
+    }
+    else {
+      std::size_t const iEngine = handles.size();
+      seed_t const expected = ExpectedSeed(config,
+        iEngine / config.nInstances, iEngine % config.nInstances, schedule);
+      if (seed != expected) {
+        error("engine " + std::string(id) + " has seed " + std::to_string(seed)
+          + ", expected " + std::to_string(expected));
+      }
+    }
+    jobSeeds[id] = seed;
+    handles.push_back
+      (seeds.with([&](SeedMaster_t& sm){ return sm.engineHandle(id); }));
+  } // for
+
+  for (std::size_t iEngine = 0; iEngine < IDs.size(); ++iEngine) {
+    seed_t const seed
+      = seeds.with([&](SeedMaster_t& sm){ return sm.reseed(handles[iEngine]); });
+    if (engineState.at(IDs[iEngine]) != seed) {
+      error("engine " + std::string(IDs[iEngine]) + " was reseeded with "
+        + std::to_string(engineState.at(IDs[iEngine])) + " instead of "
+        + std::to_string(seed));
+    }
+  } // for
+
+  //
+  // event loop: the events are shared among the threads as among schedules
+  //
+  unsigned int iQuery = 0;
+  for (unsigned int iEvent = schedule; iEvent < config.nEvents;
+    iEvent += nThreads
+  ) {
+    SeedMaster_t::EventData_t data = MakeEventData(iEvent);
+    data.schedule = schedule;
+
+    std::map<EngineId, seed_t> eventSeeds;
+    if (iEvent % 2 == 0) { // seeds on demand
+      seeds.with([&](SeedMaster_t& sm){
+        sm.onNewEvent(schedule);
+        for (EngineId const& id: IDs) {
+          data.moduleLabel = id.moduleLabel;
+          eventSeeds[id] = sm.reseedEvent(id, data);
+        }
+      });
+    }
+    else { // seeds computed in advance, outside of the lock
+      SeedMaster_t::EventSeeds_t computed
+        = seeds.unlocked().computeEventSeeds(data, IDs);
+      seeds.with([&](SeedMaster_t& sm){
+        sm.onNewEvent(schedule);
+        sm.adoptEventSeeds(std::move(computed), data);
+        for (EngineId const& id: IDs) {
+          data.moduleLabel = id.moduleLabel;
+          eventSeeds[id] = sm.reseedEvent(id, data);
+        }
+      });
+    }
+
+    for (EngineId const& id: IDs) {
+      seed_t const seed = eventSeeds.at(id);
+      // without a per-event seed, the engine keeps its job seed
+      seed_t const expected
+        = (seed == SeedMaster_t::InvalidSeed)? jobSeeds.at(id): seed;
+      if (engineState.at(id) != expected) {
+        error("engine " + std::string(id) + " on event "
+          + std::to_string(iEvent) + " has seed "
+          + std::to_string(engineState.at(id)) + " instead of "
+          + std::to_string(expected));
+      }
+      // job seeds depend on the registration order: they are checked apart
+      if (config.orderedSeeds()) continue;
+      result.events[{ iEvent, id.moduleLabel, id.instanceName }]
+        = { seed, DrawChecksum(engineState.at(id)) };
+    } // for
+
+    // query the engines of another schedule, which may or may not be there
+    ScheduleNumber_t const other = (schedule + 1 + iQuery) % nThreads;
+    EngineId const otherId(ModuleLabel(iQuery % config.nModules),
+      InstanceName(iQuery % config.nInstances), other);
+    ++iQuery;
+    seeds.with([&](SeedMaster_t& sm){
+      return sm.hasEngine(otherId)? sm.getCurrentSeed(otherId): 0;
+    });
+
+  } // for events
+
+} // ScheduleWork()
+
+
+/// Runs all the schedules with the specified number of threads
+StressResult_t RunStress(StressConfig_t const& config, unsigned int nThreads) {
+
+  LockedSeedMaster seeds(MakePolicyConfiguration(config));
+  StartingLine start(nThreads);
+
+  std::vector<StressResult_t> results(nThreads);
+  std::vector<std::thread> threads;
+  for (ScheduleNumber_t sched = 0; sched < nThreads; ++sched) {
+    threads.emplace_back([&, sched](){
+      try {
+        ScheduleWork(seeds, start, config, sched, nThreads, results[sched]);
+      }
+      catch (std::exception const& e) {
+        results[sched].errors.push_back("[schedule " + std::to_string(sched)
+          + "] exception: " + e.what());
+      }
+    });
+  } // for
+  for (std::thread& thread: threads) thread.join();
+
+  StressResult_t merged;
+  for (StressResult_t& result: results) {
+    merged.events.merge(result.events);
+    for (std::string& msg: result.errors)
+      merged.errors.push_back(std::move(msg));
+  }
+
+  std::size_t const nEngines = seeds.unlocked().nEngines();
+  std::size_t const expectedEngines = TotalEngines(config, nThreads);
+  if (nEngines != expectedEngines) {
+    merged.errors.push_back(std::to_string(nEngines) + " engines registered, "
+      + std::to_string(expectedEngines) + " expected");
+  }
+  
+  // whatever the order of registration, the engines share the first seeds
+  // of the job range, one each
+  if (config.orderedSeeds()) {
+    std::vector<unsigned int> seedUses(expectedEngines, 0);
+    for (ScheduleNumber_t sched = 0; sched < nThreads; ++sched) {
+      for (unsigned int iModule = 0; iModule < config.nModules; ++iModule) {
+        for (unsigned int iInstance = 0; iInstance < config.nInstances;
+          ++iInstance
+        ) {
+          EngineId const id
+            (ModuleLabel(iModule), InstanceName(iInstance), sched);
+          seed_t const seed = seeds.unlocked().getCurrentSeed(id);
+          if ((seed < 1) || (seed > expectedEngines)) {
+            merged.errors.push_back("engine " + std::string(id)
+              + " has seed " + std::to_string(seed) + ", out of [ 1, "
+              + std::to_string(expectedEngines) + " ]");
+          }
+          else if (++seedUses[seed - 1] > 1) {
+            merged.errors.push_back("engine " + std::string(id)
+              + " shares seed " + std::to_string(seed));
+          }
+        } // for instances
+      } // for modules
+    } // for schedules
+  } // if ordered seeds
+  
+  return merged;
+} // RunStress()
+
+
+/// Returns the differences of `result` from `reference`
+std::vector<std::string> CompareResults
+  (StressResult_t const& reference, StressResult_t const& result)
+{
+  std::vector<std::string> differences;
+  if (result.events.size() != reference.events.size()) {
+    differences.push_back(std::to_string(result.events.size())
+      + " engine uses in events, " + std::to_string(reference.events.size())
+      + " in the reference");
+  }
+  for (auto const& [ key, values ]: reference.events) {
+    auto const iResult = result.events.find(key);
+    auto const& [ iEvent, module, instance ] = key;
+    std::string const what = "engine " + module + "." + instance
+      + " on event " + std::to_string(iEvent);
+    if (iResult == result.events.end())
+      differences.push_back(what + " is missing");
+    else if (iResult->second.first != values.first)
+      differences.push_back(what + " has a different seed");
+    else if (iResult->second.second != values.second)
+      differences.push_back(what + " has a different checksum");
+    if (differences.size() >= 10) break; // enough to know
+  } // for
+  return differences;
+} // CompareResults()
+
+
+//------------------------------------------------------------------------------
+//--- command line parsing
+//---
+
+/// Splits a comma-separated list of numbers
+std::vector<unsigned int> SplitNumbers(std::string const& list) {
+  std::vector<unsigned int> numbers;
+  std::istringstream sstr(list);
+  std::string item;
+  while (std::getline(sstr, item, ','))
+    if (!item.empty()) numbers.push_back(std::stoul(item));
+  return numbers;
+} // SplitNumbers()
+
+
+void PrintUsage(const char* programName) {
+  std::cerr << "Usage: " << programName << " [options]"
+    "\n  --threads N[,N...]  numbers of threads (and schedules)"
+    "\n  --modules N         number of replicated modules"
+    "\n  --instances N       number of engines per module"
+    "\n  --events N          number of events"
+    "\n  --policy NAME       perEvent (default) or linearMapping"
+    << std::endl;
+} // PrintUsage()
+
+
+//------------------------------------------------------------------------------
+int main(int argc, const char** argv) {
+
+  std::vector<unsigned int> threadCounts{ 1, 2, 4, 8 };
+  StressConfig_t config;
+
+  //****************************************************************************
+  //*** parse the command line
+  //***
+  try {
+    for (int iParam = 1; iParam < argc; ++iParam) {
+      std::string const option = argv[iParam];
+      if ((option == "-h") || (option == "--help")) {
+        PrintUsage(argv[0]);
+        return 0;
+      }
+      if (++iParam >= argc) {
+        std::cerr << "Option '" << option << "' requires an argument."
+          << std::endl;
+        PrintUsage(argv[0]);
+        return 1;
+      }
+      std::string const value = argv[iParam];
+      if      (option == "--threads")   threadCounts      = SplitNumbers(value);
+      else if (option == "--modules")   config.nModules   = std::stoul(value);
+      else if (option == "--instances") config.nInstances = std::stoul(value);
+      else if (option == "--events")    config.nEvents    = std::stoul(value);
+      else if (option == "--policy")    config.policy     = value;
+      else {
+        std::cerr << "Unknown option: '" << option << "'" << std::endl;
+        PrintUsage(argv[0]);
+        return 1;
+      }
+    } // for
+  }
+  catch (std::logic_error const& e) { // from std::stoul() and the like
+    std::cerr << "Invalid number on the command line: " << e.what()
+      << std::endl;
+    return 1;
+  }
+  if (threadCounts.empty() || (config.nModules == 0)
+    || (config.nInstances == 0))
+  {
+    std::cerr << "At least one thread count, module and instance are required."
+      << std::endl;
+    return 1;
+  }
+  if ((config.policy != "perEvent") && (config.policy != "linearMapping")) {
+    std::cerr << "Unsupported policy: '" << config.policy << "'" << std::endl;
+    return 1;
+  }
+  config.maxThreads = 1;
+  for (unsigned int nThreads: threadCounts) {
+    if (nThreads == 0) {
+      std::cerr << "The number of threads must be positive." << std::endl;
+      return 1;
+    }
+    if (nThreads > config.maxThreads) config.maxThreads = nThreads;
+  } // for
+
+  StartMessageFacility();
+
+  //****************************************************************************
+  //*** run with all the thread counts, and compare with the first one
+  //***
+  unsigned int nErrors = 0;
+  StressResult_t reference;
+  for (unsigned int nThreads: threadCounts) {
+    StressResult_t result = RunStress(config, nThreads);
+    for (std::string const& msg: result.errors) {
+      mf::LogError("SeedMaster_stress")
+        << "[" << nThreads << " threads] " << msg;
+    }
+    nErrors += result.errors.size();
+
+    if (nThreads == threadCounts.front()) reference = std::move(result);
+    else {
+      std::vector<std::string> const differences
+        = CompareResults(reference, result);
+      for (std::string const& msg: differences) {
+        mf::LogError("SeedMaster_stress") << "[" << nThreads
+          << " threads] differs from " << threadCounts.front()
+          << " threads: " << msg;
+      }
+      nErrors += differences.size();
+    }
+    mf::LogInfo("SeedMaster_stress") << nThreads << " threads, "
+      << config.policy << " policy: "
+      << config.nModules << " modules x " << config.nInstances
+      << " engines per schedule, " << config.nEvents << " events";
+  } // for
+
+  if (nErrors > 0) {
+    mf::LogError("SeedMaster_stress") << nErrors << " checks failed.";
+  }
+  return nErrors;
+} // main()
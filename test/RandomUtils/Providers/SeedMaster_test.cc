@@ -33,6 +33,15 @@
 #include <vector>
 #include <algorithm> // std::find()
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <cstdint> // std::uint64_t
+#include <cstring> // std::strcpy()
+#include <chrono>
+
+// POSIX
+#include <unistd.h> // gethostname(), getpid()
 
 // CET libraries
 #include "cetlib/filepath_maker.h"
@@ -50,6 +59,8 @@
 
 // art extensions
 #include "nurandom/RandomUtils/Providers/SeedMaster.h"
+#include "nurandom/RandomUtils/Providers/CheckpointIO.h"
+#include "nurandom/RandomUtils/Providers/JobSlotLease.h"
 
 
 //------------------------------------------------------------------------------
@@ -59,16 +70,15 @@ using seed_t = unsigned long;
 using SeedMaster_t = rndm::SeedMaster<seed_t>;
 
 /// Returns the seed for the specified module/instance, or 0 on error
-seed_t ObtainSeed
-  (SeedMaster_t& seeds, std::string module_name, std::string instance_name = "")
-{
+seed_t ObtainSeed(
+  SeedMaster_t& seeds, std::string module_name, std::string instance_name = "",
+  SeedMaster_t::ScheduleNumber_t schedule = 0
+) {
   // Returns the seed for the specified engine instance, or 0 in case of
   // configuration error (in which case, an error counter is increased)
   try {
-    return seeds.getSeed(instance_name.empty()?
-      SeedMaster_t::EngineId(module_name):
-      SeedMaster_t::EngineId(module_name, instance_name)
-      );
+    return seeds.getSeed
+      (SeedMaster_t::EngineId(module_name, instance_name, schedule));
   }
   catch(art::Exception& e) {
     mf::LogError("SeedMaster") << "Caught an exception while asking seed for '"
@@ -189,6 +199,8 @@ int TestModule(SeedMaster_t& seeds, const fhicl::ParameterSet& pset) {
   std::vector<std::string> instance_names;
   pset.get_if_present("instanceNames", instance_names);
   unsigned int nExpectedErrors = pset.get<unsigned int>("expectedErrors", 0);
+  unsigned int nSeedWords = pset.get<unsigned int>("nSeedWords", 0);
+  unsigned int nReplicas = pset.get<unsigned int>("replicas", 1);
   
   unsigned int nErrors = 0;
   if (instance_names.empty()) {
@@ -241,12 +253,532 @@ int TestModule(SeedMaster_t& seeds, const fhicl::ParameterSet& pset) {
     ++iOldSeed;
   } // for consistency check
   
+  // multi-word seed test: first word is the seed, no word is 0
+  if (nSeedWords > 0) {
+    iOldSeed = our_seeds.begin();
+    for (std::string instance_name: instance_names) {
+      SeedMaster_t::SeedWords_t const words = seeds.getSeedWords(
+        instance_name.empty()?
+          SeedMaster_t::EngineId(module_name):
+          SeedMaster_t::EngineId(module_name, instance_name),
+        nSeedWords
+        );
+      mf::LogVerbatim log("SeedMaster_test");
+      log << "Seed words for '" << instance_name << "':";
+      for (seed_t word: words) log << " " << word;
+      bool const good = (words.size() == nSeedWords)
+        && (words.front() == *iOldSeed)
+        && (std::find(words.begin(), words.end(), 0) == words.end());
+      if (!good) {
+        MF_LOG_ERROR(module_id)
+          << "instance " << instance_name << " got invalid seed words!";
+        if (++nErrors <= nExpectedErrors) {
+          mf::LogProblem(module_id) << "  (error #" << nErrors
+            << ", " << nExpectedErrors << " expected)";
+        }
+      }
+      ++iOldSeed;
+    } // for
+  } // if multi-word seeds
+  
+  // replica test: each replica of the module has its own seeds
+  std::vector<seed_t> replica_seeds = our_seeds;
+  for (unsigned int schedule = 1; schedule < nReplicas; ++schedule) {
+    for (std::string instance_name: instance_names) {
+      seed_t seed = ObtainSeed(seeds, module_name, instance_name, schedule);
+      mf::LogVerbatim("SeedMaster_test")
+        << "Seed for '" << instance_name << "' in schedule " << schedule
+        << " is: " << seed;
+      bool const good = (seed != 0) && (std::find
+        (replica_seeds.begin(), replica_seeds.end(), seed) == replica_seeds.end()
+        );
+      if (!good) {
+        MF_LOG_ERROR(module_id)
+          << "instance " << instance_name << " in schedule " << schedule
+          << " got seed " << seed << ", zero or shared with another replica!";
+        if (++nErrors <= nExpectedErrors) {
+          mf::LogProblem(module_id) << "  (error #" << nErrors
+            << ", " << nExpectedErrors << " expected)";
+        }
+      }
+      replica_seeds.push_back(seed);
+    } // for instances
+  } // for replicas
+  
   // as many errors as expected, balance is even
   return (nErrors > nExpectedErrors)?
     nErrors - nExpectedErrors: nExpectedErrors - nErrors;
 } // TestModule()
 
 
+//------------------------------------------------------------------------------
+/**
+ * @brief Rewrites a seed checkpoint in the format of version 1
+ * @param in checkpoint in the current format
+ * @param out stream to write the version 1 checkpoint into
+ * @return whether all the engines were on schedule 0 (as version 1 requires)
+ *
+ * Version 1 differs from the current one only in lacking the schedule of the
+ * engines.
+ */
+bool WriteCheckpointVersion1(std::istream& in, std::ostream& out) {
+  using namespace rndm::details;
+  
+  char magic[sizeof(CheckpointMagic)];
+  in.read(magic, sizeof(magic));
+  out.write(magic, sizeof(magic));
+  readCheckpointValue<std::uint32_t>(in); // version
+  writeCheckpointValue(out, std::uint32_t(1));
+  writeCheckpointValue(out, readCheckpointValue<std::uint32_t>(in)); // size
+  writeCheckpointString(out, readCheckpointString(in)); // policy
+  writeCheckpointString(out, readCheckpointString(in)); // label
+  writeCheckpointString(out, readCheckpointString(in)); // policy state
+  
+  bool allOnFirstSchedule = true;
+  auto const nEngines = readCheckpointValue<std::uint64_t>(in);
+  writeCheckpointValue(out, nEngines);
+  for (std::uint64_t iEngine = 0; iEngine < nEngines; ++iEngine) {
+    writeCheckpointString(out, readCheckpointString(in)); // module label
+    writeCheckpointString(out, readCheckpointString(in)); // instance name
+    if (readCheckpointValue<std::uint32_t>(in) != 0) // schedule: dropped
+      allOnFirstSchedule = false;
+    writeCheckpointValue(out, readCheckpointValue<std::uint8_t>(in)); // flags
+    writeCheckpointValue(out, readCheckpointValue<seed_t>(in)); // configured
+    writeCheckpointValue(out, readCheckpointValue<seed_t>(in)); // current
+  } // for
+  return allOnFirstSchedule;
+} // WriteCheckpointVersion1()
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Tests that a seed checkpoint restores the same seeds
+ * @return the number of errors
+ *
+ * A new SeedMaster is restored from a checkpoint of `seeds`: both must then
+ * report the same seeds, and deliver the same seed to a new engine.
+ * The same checkpoint rewritten in the format of version 1 must restore the
+ * same seeds as well.
+ */
+unsigned int TestCheckpoint
+  (SeedMaster_t& seeds, fhicl::ParameterSet const& pset)
+{
+  unsigned int nErrors = 0;
+  
+  std::stringstream checkpoint;
+  seeds.saveCheckpoint(checkpoint, "SeedMaster_test");
+  
+  std::istringstream checkpointCopy{ checkpoint.str() };
+  std::stringstream checkpointVersion1;
+  bool const canWriteVersion1
+    = WriteCheckpointVersion1(checkpointCopy, checkpointVersion1);
+  
+  SeedMaster_t restored(pset);
+  std::string const label = restored.restoreCheckpoint(checkpoint);
+  if (label != "SeedMaster_test") {
+    mf::LogError("SeedMaster_test")
+      << "Checkpoint label restored as '" << label << "'";
+    ++nErrors;
+  }
+  
+  std::ostringstream original, copy;
+  seeds.printManifest(original);
+  restored.printManifest(copy);
+  if (original.str() != copy.str()) {
+    mf::LogError("SeedMaster_test")
+      << "Seeds restored from checkpoint:\n" << copy.str()
+      << "differ from the original ones:\n" << original.str();
+    ++nErrors;
+  }
+  
+  if (canWriteVersion1) {
+    SeedMaster_t restoredVersion1(pset);
+    restoredVersion1.restoreCheckpoint(checkpointVersion1);
+    std::ostringstream copyVersion1;
+    restoredVersion1.printManifest(copyVersion1);
+    if (original.str() != copyVersion1.str()) {
+      mf::LogError("SeedMaster_test")
+        << "Seeds restored from version 1 checkpoint:\n" << copyVersion1.str()
+        << "differ from the original ones:\n" << original.str();
+      ++nErrors;
+    }
+  } // if version 1
+  
+  SeedMaster_t::EngineId const newEngine("checkpointTest", "next");
+  seed_t const originalSeed = seeds.getSeed(newEngine);
+  seed_t const restoredSeed = restored.getSeed(newEngine);
+  if (originalSeed != restoredSeed) {
+    mf::LogError("SeedMaster_test")
+      << "Seed of a new engine after checkpoint: " << restoredSeed
+      << ", expected " << originalSeed;
+    ++nErrors;
+  }
+  else {
+    mf::LogInfo("SeedMaster_test")
+      << "Seeds restored from checkpoint; next seed: " << restoredSeed;
+  }
+  
+  return nErrors;
+} // TestCheckpoint()
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Tests that concurrent jobs lease different job slots
+ * @return the number of errors
+ *
+ * While `seeds` holds its job slot, a new SeedMaster with the same
+ * configuration must lease the next slot, and deliver seeds shifted by a full
+ * block of `maxUniqueEngines`. When it is destroyed its slot is released and
+ * must be leased again by the next one.
+ */
+unsigned int TestJobSlotLease
+  (SeedMaster_t& seeds, fhicl::ParameterSet const& pset)
+{
+  unsigned int nErrors = 0;
+  
+  // `seeds` holds the first slot and has already given out some seeds:
+  // the first seed of a block is read from new jobs, which lease the next slots
+  seed_t const blockSize = pset.get<seed_t>("maxUniqueEngines");
+  SeedMaster_t::EngineId const engine("jobSlotLeaseTest");
+  seed_t const mainSeed = seeds.getSeed(engine);
+  
+  SeedMaster_t first(pset);
+  seed_t const firstSeed = first.getSeed(engine);
+  if ((firstSeed <= mainSeed) || ((firstSeed - mainSeed) > blockSize)) {
+    mf::LogError("SeedMaster_test")
+      << "Concurrent job got seed " << firstSeed << ", expected within "
+      << blockSize << " after " << mainSeed << " from the next job slot";
+    ++nErrors;
+  }
+  
+  seed_t otherSeed = 0;
+  {
+    SeedMaster_t other(pset);
+    otherSeed = other.getSeed(engine);
+    if (otherSeed != firstSeed + blockSize) {
+      mf::LogError("SeedMaster_test")
+        << "Concurrent job got seed " << otherSeed << ", expected "
+        << (firstSeed + blockSize) << " from the next job slot";
+      ++nErrors;
+    }
+  } // other job ends here, releasing its slot
+  
+  SeedMaster_t next(pset);
+  seed_t const nextSeed = next.getSeed(engine);
+  if (nextSeed != otherSeed) {
+    mf::LogError("SeedMaster_test")
+      << "Job after a released slot got seed " << nextSeed << ", expected "
+      << otherSeed << " from the released slot";
+    ++nErrors;
+  }
+  else {
+    mf::LogInfo("SeedMaster_test")
+      << "Concurrent jobs leased disjoint seed blocks starting at "
+      << firstSeed << " and " << otherSeed;
+  }
+  
+  // a job on this host keeps its slot past the lease expiration
+  std::string const expiredLeaseFile
+    = pset.get<std::string>("jobSlotLease.file") + ".expired";
+  {
+    char host[256] = { '\0' };
+    if (::gethostname(host, sizeof(host) - 1) != 0)
+      std::strcpy(host, "localhost");
+    std::ofstream leases(expiredLeaseFile);
+    leases << "0 " << host << " " << ::getpid() << " 1\n"; // expired in 1970
+  }
+  rndm::details::JobSlotLease const lease
+    (expiredLeaseFile, 2U, std::chrono::seconds{ 60 });
+  if (lease.slot() != 1) {
+    mf::LogError("SeedMaster_test")
+      << "Job leased slot " << lease.slot() << " from '" << expiredLeaseFile
+      << "', expected 1: slot 0 is held by a running job on this host";
+    ++nErrors;
+  }
+  
+  return nErrors;
+} // TestJobSlotLease()
+
+
+//------------------------------------------------------------------------------
+/// Returns the IDs of the engines of all the test modules
+std::vector<SeedMaster_t::EngineId> ModuleEngines
+  (std::vector<fhicl::ParameterSet> const& module_psets)
+{
+  std::vector<SeedMaster_t::EngineId> engines;
+  for (fhicl::ParameterSet const& module_pset: module_psets) {
+    std::string const module_name
+      = module_pset.get<std::string>("module_name", "unknown");
+    std::vector<std::string> instance_names;
+    module_pset.get_if_present("instanceNames", instance_names);
+    if (instance_names.empty()) instance_names.push_back("");
+    for (std::string const& instance_name: instance_names)
+      engines.emplace_back(module_name, instance_name);
+  } // for
+  return engines;
+} // ModuleEngines()
+
+
+/// Returns whether the test modules are expected to fail getting their seeds
+bool ExpectModuleErrors(std::vector<fhicl::ParameterSet> const& module_psets) {
+  for (fhicl::ParameterSet const& module_pset: module_psets)
+    if (module_pset.get<unsigned int>("expectedErrors", 0) > 0) return true;
+  return false;
+} // ExpectModuleErrors()
+
+
+/// Returns whether `op()` throws an `art::Exception`
+template <typename Op>
+bool Throws(Op op) {
+  try { op(); }
+  catch (art::Exception const&) { return true; }
+  return false;
+} // Throws()
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Tests the access to the seeds of the engines by engine handle
+ * @return the number of errors
+ *
+ * The `engines` are registered in a new SeedMaster, and their seed must be the
+ * same when asked by ID and by handle, and so the seed handed to the seeder by
+ * `reseed()`. Invalid handles and handles of unregistered engines must be
+ * rejected. Handles must still be usable after a checkpoint is restored.
+ */
+unsigned int TestEngineHandles(
+  fhicl::ParameterSet const& pset,
+  std::vector<SeedMaster_t::EngineId> const& engines
+) {
+  using EngineId = SeedMaster_t::EngineId;
+  using EngineHandle = SeedMaster_t::EngineHandle;
+  
+  unsigned int nErrors = 0;
+  
+  std::map<EngineId, seed_t> appliedSeeds;
+  auto seeder = [&appliedSeeds](EngineId const& id, seed_t seed)
+    { appliedSeeds[id] = seed; };
+  
+  SeedMaster_t seeds(pset);
+  std::vector<EngineHandle> handles;
+  for (EngineId const& id: engines) {
+    seeds.registerNewSeeder(id, seeder);
+    handles.push_back(seeds.engineHandle(id));
+  }
+  
+  for (std::size_t iEngine = 0; iEngine < engines.size(); ++iEngine) {
+    EngineId const& id = engines[iEngine];
+    EngineHandle const handle = handles[iEngine];
+    seed_t const seed = seeds.getSeed(id);
+    if (seeds.getSeed(handle) != seed) {
+      mf::LogError("SeedMaster_test") << "Engine '" << id << "' has seed "
+        << seed << ", but " << seeds.getSeed(handle) << " from handle "
+        << handle;
+      ++nErrors;
+    }
+    if ((seeds.reseed(handle) != seed) || (appliedSeeds[id] != seed)) {
+      mf::LogError("SeedMaster_test") << "Engine '" << id
+        << "' reseeded by handle " << handle << " with " << appliedSeeds[id]
+        << ", expected " << seed;
+      ++nErrors;
+    }
+  } // for
+  
+  if (!Throws([&seeds](){ seeds.engineHandle(EngineId("noSuchModule")); })) {
+    mf::LogError("SeedMaster_test")
+      << "Got a handle for an engine which is not registered";
+    ++nErrors;
+  }
+  EngineHandle const outOfRange
+    { static_cast<EngineHandle::index_t>(engines.size()) };
+  for (EngineHandle const handle: { EngineHandle{}, outOfRange }) {
+    if (!Throws([&seeds, handle](){ seeds.getSeed(handle); })) {
+      mf::LogError("SeedMaster_test")
+        << "Got a seed from invalid handle " << handle;
+      ++nErrors;
+    }
+  } // for
+  
+  // a job registering the engines in reverse order may assign other seeds,
+  // and they must be visible through the handles after restoring its state
+  SeedMaster_t other(pset);
+  for (auto iEngine = engines.rbegin(); iEngine != engines.rend(); ++iEngine)
+    other.registerNewSeeder(*iEngine, seeder);
+  std::stringstream checkpoint;
+  other.saveCheckpoint(checkpoint);
+  seeds.restoreCheckpoint(checkpoint);
+  for (std::size_t iEngine = 0; iEngine < engines.size(); ++iEngine) {
+    EngineId const& id = engines[iEngine];
+    EngineHandle const handle = handles[iEngine];
+    seed_t const seed = other.getSeed(id);
+    if ((seeds.getSeed(handle) != seed) || (seeds.getSeed(id) != seed)) {
+      mf::LogError("SeedMaster_test") << "Engine '" << id
+        << "' after restoring a checkpoint has seed " << seeds.getSeed(id)
+        << ", " << seeds.getSeed(handle) << " from handle " << handle
+        << ", expected " << seed;
+      ++nErrors;
+    }
+  } // for
+  
+  if (nErrors == 0) {
+    mf::LogInfo("SeedMaster_test")
+      << "Seeds of " << engines.size() << " engines consistent by handle";
+  }
+  return nErrors;
+} // TestEngineHandles()
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Tests the registration of engines in a single batch
+ * @return the number of errors
+ *
+ * A batch with a repeated engine and a batch with an engine already registered
+ * must both be rejected, leaving no engine of the batch registered.
+ * With policies whose seeds do not depend on chance, the `engines` registered
+ * in a batch must get the same seeds as if registered one by one.
+ */
+unsigned int TestBulkRegistration(
+  fhicl::ParameterSet const& pset,
+  std::vector<SeedMaster_t::EngineId> const& engines
+) {
+  using EngineId = SeedMaster_t::EngineId;
+  
+  unsigned int nErrors = 0;
+  
+  auto seeder = [](EngineId const&, seed_t){};
+  std::vector<SeedMaster_t::SeederRegistration_t> registrations;
+  for (EngineId const& id: engines) registrations.emplace_back(id, seeder);
+  
+  // a batch with the same engine twice
+  SeedMaster_t duplicate(pset);
+  auto duplicateRegistrations = registrations;
+  duplicateRegistrations.push_back(registrations.front());
+  if (!Throws([&](){ duplicate.registerNewSeeders(duplicateRegistrations); }))
+  {
+    mf::LogError("SeedMaster_test")
+      << "A batch registering engine '" << engines.front()
+      << "' twice was accepted";
+    ++nErrors;
+  }
+  if (duplicate.nEngines() != 0) {
+    mf::LogError("SeedMaster_test") << duplicate.nEngines()
+      << " engines registered by a batch which was rejected";
+    ++nErrors;
+  }
+  
+  // a batch with an engine which was already registered
+  SeedMaster_t registered(pset);
+  registered.registerNewSeeder(engines.back(), seeder);
+  if (!Throws([&](){ registered.registerNewSeeders(registrations); })) {
+    mf::LogError("SeedMaster_test")
+      << "A batch registering engine '" << engines.back()
+      << "' again was accepted";
+    ++nErrors;
+  }
+  for (EngineId const& id: engines) {
+    if ((id == engines.back()) || !registered.hasEngine(id)) continue;
+    mf::LogError("SeedMaster_test") << "Engine '" << id
+      << "' registered by a batch which was rejected";
+    ++nErrors;
+  } // for
+  
+  // the same seeds as a registration one by one
+  std::vector<std::string> const deterministicPolicies{
+    "autoIncrement", "linearMapping", "gridMapping",
+    "preDefinedSeed", "preDefinedOffset"
+    };
+  std::string const policy = pset.get<std::string>("policy");
+  if (std::find(
+    deterministicPolicies.begin(), deterministicPolicies.end(), policy
+    ) != deterministicPolicies.end()
+  ) {
+    SeedMaster_t bulk(pset), single(pset);
+    std::vector<seed_t> const bulkSeeds
+      = bulk.registerNewSeeders(registrations);
+    for (std::size_t iEngine = 0; iEngine < engines.size(); ++iEngine) {
+      EngineId const& id = engines[iEngine];
+      single.registerNewSeeder(id, seeder);
+      seed_t const seed = single.getSeed(id);
+      if ((bulkSeeds[iEngine] != seed) || (bulk.getSeed(id) != seed)) {
+        mf::LogError("SeedMaster_test") << "Engine '" << id
+          << "' registered in a batch got seed " << bulkSeeds[iEngine]
+          << ", " << seed << " when registered alone";
+        ++nErrors;
+      }
+    } // for
+  } // if deterministic policy
+  
+  if (nErrors == 0) {
+    mf::LogInfo("SeedMaster_test")
+      << "Registration of " << engines.size() << " engines in a batch passed";
+  }
+  return nErrors;
+} // TestBulkRegistration()
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Tests that the `splitRandom` policy reproduces its seeds
+ * @return the number of errors
+ *
+ * Two `SeedMaster` with the same master seed and job number must give the
+ * `engines` the same seeds, while a job with a different number must get a
+ * different sequence.
+ * Only configurations with the `splitRandom` policy and an explicit master seed
+ * are tested.
+ */
+unsigned int TestSplitRandomReproducibility(
+  fhicl::ParameterSet const& pset,
+  std::vector<SeedMaster_t::EngineId> const& engines
+) {
+  using EngineId = SeedMaster_t::EngineId;
+  
+  if (pset.get<std::string>("policy") != "splitRandom") return 0;
+  if (!pset.has_key("masterSeed")) return 0;
+  
+  unsigned int nErrors = 0;
+  
+  auto seeder = [](EngineId const&, seed_t){};
+  auto jobSeeds = [&engines, &seeder](fhicl::ParameterSet const& config)
+    {
+      SeedMaster_t seeds(config);
+      std::vector<seed_t> jobSeeds;
+      for (EngineId const& id: engines) {
+        seeds.registerNewSeeder(id, seeder);
+        jobSeeds.push_back(seeds.getSeed(id));
+      }
+      return jobSeeds;
+    };
+  
+  std::vector<seed_t> const firstSeeds = jobSeeds(pset);
+  std::vector<seed_t> const secondSeeds = jobSeeds(pset);
+  for (std::size_t iEngine = 0; iEngine < engines.size(); ++iEngine) {
+    if (firstSeeds[iEngine] == secondSeeds[iEngine]) continue;
+    mf::LogError("SeedMaster_test") << "Engine '" << engines[iEngine]
+      << "' got seed " << firstSeeds[iEngine] << " and then "
+      << secondSeeds[iEngine] << " from the same configuration";
+    ++nErrors;
+  } // for
+  
+  fhicl::ParameterSet otherJob = pset;
+  std::uint64_t const nJob = pset.get<std::uint64_t>("nJob", 0);
+  otherJob.put_or_replace("nJob", nJob + 1);
+  if (jobSeeds(otherJob) == firstSeeds) {
+    mf::LogError("SeedMaster_test") << "Jobs " << nJob << " and " << (nJob + 1)
+      << " got the same seeds";
+    ++nErrors;
+  }
+  
+  if (nErrors == 0) {
+    mf::LogInfo("SeedMaster_test") << "Seeds of " << engines.size()
+      << " engines reproduced with the same master seed and job number";
+  }
+  return nErrors;
+} // TestSplitRandomReproducibility()
+
+
 
 //------------------------------------------------------------------------------
 //--- stuff to run the facilitated stuff
@@ -341,6 +873,8 @@ int main(int argc, const char** argv) {
   } // end anonymous block
   
   bool endOfJobSummary = pset.get<bool>("endOfJobSummary", false);
+  std::string endOfJobManifest
+    = pset.get<std::string>("endOfJobManifest", "");
   
   //****************************************************************************
   //*** perform the tests...
@@ -385,6 +919,70 @@ int main(int argc, const char** argv) {
   
   if (endOfJobSummary) pSeeds->print();
   
+  if (!endOfJobManifest.empty()) {
+    std::ofstream manifest(endOfJobManifest);
+    if (!manifest) {
+      mf::LogError("SeedMaster_test")
+        << "Can't write seed manifest into '" << endOfJobManifest << "'";
+      ++nErrors;
+    }
+    else pSeeds->printManifest(manifest);
+  } // if manifest
+  
+  if (pset.has_key("checkpoint")) {
+    try {
+      nErrors += TestCheckpoint(*pSeeds, pset);
+    }
+    catch(const art::Exception& e) {
+      mf::LogError("SeedMaster_test")
+        << "Exception caught while testing the checkpoint:\n" << e.what();
+      ++nErrors;
+    }
+  } // if checkpoint
+  
+  if (pset.has_key("jobSlotLease")) {
+    try {
+      nErrors += TestJobSlotLease(*pSeeds, pset);
+    }
+    catch(const cet::exception& e) {
+      mf::LogError("SeedMaster_test")
+        << "Exception caught while testing the job slot lease:\n" << e.what();
+      ++nErrors;
+    }
+  } // if job slot lease
+  
+  // tests on new SeedMaster objects, which need all seeds to be available
+  if (!ExpectModuleErrors(module_psets) && !pset.has_key("jobSlotLease")) {
+    std::vector<SeedMaster_t::EngineId> const engines
+      = ModuleEngines(module_psets);
+    try {
+      nErrors += TestEngineHandles(pset, engines);
+    }
+    catch(const art::Exception& e) {
+      mf::LogError("SeedMaster_test")
+        << "Exception caught while testing the engine handles:\n" << e.what();
+      ++nErrors;
+    }
+    try {
+      nErrors += TestBulkRegistration(pset, engines);
+    }
+    catch(const art::Exception& e) {
+      mf::LogError("SeedMaster_test")
+        << "Exception caught while testing the batch registration:\n"
+        << e.what();
+      ++nErrors;
+    }
+    try {
+      nErrors += TestSplitRandomReproducibility(pset, engines);
+    }
+    catch(const art::Exception& e) {
+      mf::LogError("SeedMaster_test")
+        << "Exception caught while testing the seed reproducibility:\n"
+        << e.what();
+      ++nErrors;
+    }
+  } // if no expected errors
+  
   if (nErrors > 0) {
     mf::LogError("SeedMaster_test")
       << "Test terminated with " << nErrors << " errors.";
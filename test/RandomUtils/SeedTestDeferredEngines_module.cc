@@ -0,0 +1,137 @@
+/**
+ * @file   SeedTestDeferredEngines_module.cc
+ * @brief  Tests the definition of declared engines in beginRun()/beginSubRun().
+ * @date   October 16th, 2026
+ */
+
+
+// art extensions
+#define NURANDOM_RANDOMUTILS_NuRandomService_USECLHEP 1
+#include "nurandom/RandomUtils/NuRandomService.h"
+
+// Supporting library include files
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// Framework includes.
+#include "canvas/Utilities/Exception.h"
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Run.h"
+#include "art/Framework/Principal/SubRun.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+
+// CLHEP libraries
+#include "CLHEP/Random/JamesRandom.h" // CLHEP::HepJamesRandom
+
+// C/C++ standard libraries
+#include <map>
+#include <memory> // std::unique_ptr<>
+#include <string>
+#include <vector>
+
+
+namespace testing {
+
+  /**
+   * @brief Test module for NuRandomService
+   *
+   * The module declares engines in its constructor, and creates and defines
+   * some of them only at the beginning of the run or of the subrun.
+   * The test verifies that each defined engine is seeded with the seed
+   * assigned on declaration.
+   *
+   * Note that the test does not actually get any random number.
+   *
+   * Configuration parameters
+   * -------------------------
+   *
+   * * *instanceNames* (list of strings): engines declared on construction
+   * * *runInstances* (list of strings, default: empty): engines defined at the
+   *   beginning of the first run
+   * * *subRunInstances* (list of strings, default: empty): engines defined at
+   *   the beginning of the first subrun
+   *
+   */
+  class SeedTestDeferredEngines: public art::EDAnalyzer {
+
+      public:
+
+    using seed_t = rndm::NuRandomService::seed_t;
+
+    explicit SeedTestDeferredEngines(fhicl::ParameterSet const& pset);
+
+    virtual void analyze(const art::Event&) override {}
+
+    virtual void beginRun(art::Run const&) override;
+
+    virtual void beginSubRun(art::SubRun const&) override;
+
+      private:
+
+    std::vector<std::string> runInstances; ///< engines defined on run
+    std::vector<std::string> subRunInstances; ///< engines defined on subrun
+
+    /// Seeds assigned on declaration.
+    std::map<std::string, seed_t> declaredSeeds;
+
+    /// Engines created after construction.
+    std::map<std::string, std::unique_ptr<CLHEP::HepRandomEngine>> engines;
+
+    /// Creates and defines the engines not defined yet.
+    void defineEngines(std::vector<std::string> const& instanceNames);
+
+  }; // class SeedTestDeferredEngines
+
+
+  SeedTestDeferredEngines::SeedTestDeferredEngines
+    (fhicl::ParameterSet const& pset)
+    : art::EDAnalyzer(pset)
+    , runInstances(pset.get<std::vector<std::string>>("runInstances", {}))
+    , subRunInstances
+      (pset.get<std::vector<std::string>>("subRunInstances", {}))
+  {
+    art::ServiceHandle<rndm::NuRandomService> Seeds;
+    for (std::string const& instanceName
+      : pset.get<std::vector<std::string>>("instanceNames"))
+    {
+      declaredSeeds[instanceName] = Seeds->declareEngine(instanceName);
+    }
+  } // SeedTestDeferredEngines::SeedTestDeferredEngines()
+
+
+  void SeedTestDeferredEngines::beginRun(art::Run const&)
+    { defineEngines(runInstances); }
+
+
+  void SeedTestDeferredEngines::beginSubRun(art::SubRun const&)
+    { defineEngines(subRunInstances); }
+
+
+  void SeedTestDeferredEngines::defineEngines
+    (std::vector<std::string> const& instanceNames)
+  {
+    art::ServiceHandle<rndm::NuRandomService> Seeds;
+    for (std::string const& instanceName: instanceNames) {
+      if (engines.count(instanceName)) continue; // defined in a previous call
+
+      auto& engine = engines[instanceName]
+        = std::make_unique<CLHEP::HepJamesRandom>();
+      seed_t const seed = Seeds->defineEngine(*engine, instanceName);
+      seed_t const expected = declaredSeeds.at(instanceName);
+
+      mf::LogInfo("SeedTestDeferredEngines")
+        << "Engine '" << instanceName << "' defined with seed " << seed
+        << " (" << expected << " on declaration)";
+
+      if ((seed != expected) || (engine->getSeed() != (long) expected)) {
+        throw art::Exception(art::errors::LogicError)
+          << "Engine '" << instanceName << "' got seed " << seed
+          << " (engine reports " << engine->getSeed() << ") instead of "
+          << expected << " assigned on declaration\n";
+      }
+    } // for
+  } // SeedTestDeferredEngines::defineEngines()
+
+} // namespace testing
+
+DEFINE_ART_MODULE(testing::SeedTestDeferredEngines)
@@ -0,0 +1,175 @@
+/**
+ * @file   SeedTestJumpAhead_module.cc
+ * @brief  Tests the engines moved ahead on each event by NuRandomService.
+ * @date   October 16th, 2026
+ * @see    jump_ahead_test.sh
+ */
+
+
+// art extensions
+#include "nurandom/RandomUtils/NuRandomService.h"
+#include "nurandom/RandomUtils/Engines/PhiloxEngine.h"
+#include "nurandom/RandomUtils/Providers/EngineFingerprints.h" // FNV1aAdd()
+
+// Supporting library include files
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// Framework includes.
+#include "canvas/Utilities/Exception.h"
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+
+// C/C++ standard libraries
+#include <cstdint>
+#include <fstream>
+#include <iomanip> // std::setw(), std::setfill()
+#include <memory> // std::unique_ptr<>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace testing {
+
+  /**
+   * @brief Test module for NuRandomService in per-event jump-ahead mode
+   *
+   * The module registers `rndm::PhiloxEngine` engines with
+   * `NuRandomService::registerAndSeedJumpingEngine()`. On each event, it
+   * verifies that each engine is still on its job seed, and that its position
+   * in the sequence is the one expected for the event from the jump-ahead
+   * configuration. Then it draws some numbers, and records their checksum.
+   * At the end of the job, the records are written into a text file:
+   * `jump_ahead_test.sh` verifies that a job skipping some events records the
+   * same numbers for the events it processes.
+   *
+   * Configuration parameters
+   * -------------------------
+   *
+   * * *instanceNames* (list of strings, default: `[ "" ]`): engines of the
+   *   module
+   * * *draws* (integer, default: `10`): numbers drawn by each engine on each
+   *   event
+   * * *jumpAhead* (table, mandatory): the same `jumpAhead` configuration as
+   *   `NuRandomService`, with all of `stride`, `maxRuns`, `maxSubRunsPerRun`
+   *   and `maxEventsPerSubRun`
+   * * *outputFile* (string, mandatory): where to write the records
+   *
+   */
+  class SeedTestJumpAhead: public art::EDAnalyzer {
+
+      public:
+
+    using seed_t = rndm::NuRandomService::seed_t;
+
+    explicit SeedTestJumpAhead(fhicl::ParameterSet const& pset);
+
+    virtual void analyze(const art::Event& event) override;
+
+    virtual void endJob() override;
+
+      private:
+
+    std::vector<std::string> instanceNames; ///< Names of the engines.
+    unsigned int nDraws; ///< Numbers drawn per engine and event.
+    std::uint64_t stride; ///< Steps reserved to each event.
+    std::uint64_t maxSubRunsPerRun; ///< Subrun numbers are below this.
+    std::uint64_t maxEventsPerSubRun; ///< Event numbers are below this.
+    std::string outputPath; ///< Where to write the records.
+
+    /// Engines of this module.
+    std::vector<std::unique_ptr<rndm::PhiloxEngine>> engines;
+
+    std::vector<long> jobSeeds; ///< Seeds of the engines after registration.
+
+    std::vector<std::string> records; ///< Records of all the events.
+
+    unsigned int nErrors = 0; ///< Number of failed checks.
+
+  }; // class SeedTestJumpAhead
+
+
+  SeedTestJumpAhead::SeedTestJumpAhead(fhicl::ParameterSet const& pset)
+    : art::EDAnalyzer(pset)
+    , instanceNames
+      (pset.get<std::vector<std::string>>("instanceNames", { "" }))
+    , nDraws(pset.get<unsigned int>("draws", 10U))
+    , stride(pset.get<std::uint64_t>("jumpAhead.stride"))
+    , maxSubRunsPerRun(pset.get<std::uint64_t>("jumpAhead.maxSubRunsPerRun"))
+    , maxEventsPerSubRun
+      (pset.get<std::uint64_t>("jumpAhead.maxEventsPerSubRun"))
+    , outputPath(pset.get<std::string>("outputFile"))
+  {
+    art::ServiceHandle<rndm::NuRandomService> Seeds;
+    for (std::string const& instanceName: instanceNames) {
+      engines.push_back(std::make_unique<rndm::PhiloxEngine>());
+      Seeds->registerAndSeedJumpingEngine
+        (*(engines.back()), rndm::PhiloxEngine::engineName(), instanceName);
+      jobSeeds.push_back(engines.back()->getSeed());
+    }
+  } // SeedTestJumpAhead::SeedTestJumpAhead()
+
+
+  void SeedTestJumpAhead::analyze(const art::Event& event) {
+    // each step of `PhiloxEngine::skip()` is a `flat()` number, two words
+    std::uint64_t const expectedPosition = 2 * stride
+      * ((event.run() * maxSubRunsPerRun + event.subRun())
+        * maxEventsPerSubRun + event.event());
+
+    for (std::size_t iEngine = 0; iEngine < engines.size(); ++iEngine) {
+      rndm::PhiloxEngine& engine = *(engines[iEngine]);
+      std::string const& instanceName = instanceNames[iEngine];
+      if (engine.getSeed() != jobSeeds[iEngine]) {
+        mf::LogError("SeedTestJumpAhead") << "Engine '" << instanceName
+          << "' has seed " << engine.getSeed() << " instead of its job seed "
+          << jobSeeds[iEngine];
+        ++nErrors;
+      }
+      if (engine.position() != expectedPosition) {
+        mf::LogError("SeedTestJumpAhead") << "Engine '" << instanceName
+          << "' is at position " << engine.position() << " instead of "
+          << expectedPosition << " for event " << event.id();
+        ++nErrors;
+      }
+
+      std::uint64_t checksum = rndm::details::FNV1aOffset;
+      for (unsigned int i = 0; i < nDraws; ++i) {
+        // flat() has 52 significant bits: all of them go in
+        std::uint64_t const bits
+          = static_cast<std::uint64_t>(engine.flat() * 4503599627370496.0);
+        checksum = rndm::details::FNV1aAdd(checksum, bits);
+      }
+
+      std::ostringstream record;
+      record << event.run() << " " << event.subRun() << " " << event.event()
+        << " '" << instanceName << "' " << jobSeeds[iEngine] << " "
+        << std::hex << std::setfill('0') << std::setw(16) << checksum;
+      records.push_back(record.str());
+    } // for
+  } // SeedTestJumpAhead::analyze()
+
+
+  void SeedTestJumpAhead::endJob() {
+    std::ofstream out(outputPath);
+    if (!out) {
+      throw art::Exception(art::errors::FileOpenError)
+        << "SeedTestJumpAhead: can't write '" << outputPath << "'\n";
+    }
+    for (std::string const& record: records) out << record << "\n";
+
+    mf::LogInfo("SeedTestJumpAhead")
+      << records.size() << " engine records written into '" << outputPath
+      << "'";
+
+    if (nErrors > 0) {
+      throw art::Exception(art::errors::LogicError)
+        << "SeedTestJumpAhead: " << nErrors
+        << " engine checks failed (see the log)\n";
+    }
+  } // SeedTestJumpAhead::endJob()
+
+} // namespace testing
+
+DEFINE_ART_MODULE(testing::SeedTestJumpAhead)
@@ -0,0 +1,181 @@
+/**
+ * @file   SeedTestReplicated_module.cc
+ * @brief  Records the random numbers drawn by a replicated module.
+ * @date   October 16th, 2026
+ * @see    thread_invariance_test.sh
+ */
+
+
+// art extensions
+#define NURANDOM_RANDOMUTILS_NuRandomService_USECLHEP 1
+#include "nurandom/RandomUtils/NuRandomService.h"
+#include "nurandom/RandomUtils/Providers/EngineFingerprints.h" // FNV1aAdd()
+
+// Supporting library include files
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// Framework includes.
+#include "canvas/Utilities/Exception.h"
+#include "art/Framework/Core/ReplicatedProducer.h"
+#include "art/Framework/Core/ProcessingFrame.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+
+// CLHEP libraries
+#include "CLHEP/Random/JamesRandom.h" // CLHEP::HepJamesRandom
+
+// C/C++ standard libraries
+#include <cstdint>
+#include <fstream>
+#include <iomanip> // std::setw(), std::setfill()
+#include <map>
+#include <memory> // std::unique_ptr<>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+namespace testing {
+
+  /**
+   * @brief Test module for NuRandomService with multiple schedules
+   *
+   * The module is replicated, one instance per schedule, and each replica
+   * registers its own engines with `NuRandomService`. On each event, each
+   * engine draws some numbers, and the module records the seed of the engine
+   * and a checksum of those numbers.
+   * At the end of the job, all the records of the module from all its
+   * replicas are written, sorted by event and engine, into a text file.
+   *
+   * With the `perEvent` policy, the content of the file does not depend on
+   * how many threads and schedules the job runs with, nor on which schedule
+   * each event is processed: `thread_invariance_test.sh` verifies that.
+   *
+   * Configuration parameters
+   * -------------------------
+   *
+   * * *instanceNames* (list of strings, default: `[ "" ]`): engines of the
+   *   module
+   * * *draws* (integer, default: `10`): numbers drawn by each engine on each
+   *   event
+   * * *outputFile* (string, mandatory): where to write the records
+   *
+   */
+  class SeedTestReplicated: public art::ReplicatedProducer {
+
+      public:
+
+    using seed_t = rndm::NuRandomService::seed_t;
+
+    SeedTestReplicated
+      (fhicl::ParameterSet const& pset, art::ProcessingFrame const&);
+
+    virtual void produce(art::Event& event, art::ProcessingFrame const&)
+      override;
+
+    virtual void endJob(art::ProcessingFrame const&) override;
+
+      private:
+
+    /// Identification of an engine in an event.
+    using RecordKey_t = std::tuple<
+      art::RunNumber_t, art::SubRunNumber_t, art::EventNumber_t, std::string
+      >;
+
+    /// Seed and checksum of the numbers of an engine in an event.
+    using Record_t = std::pair<seed_t, std::uint64_t>;
+
+    /// Records of a module from all its replicas.
+    using Records_t = std::map<RecordKey_t, Record_t>;
+
+    std::vector<std::string> instanceNames; ///< Names of the engines.
+    unsigned int nDraws; ///< Numbers drawn per engine and event.
+    std::string outputPath; ///< Where to write the records.
+
+    /// Engines of this replica.
+    std::vector<std::unique_ptr<CLHEP::HepRandomEngine>> engines;
+
+    /// Records of all the replicas of all the modules, by module label.
+    /// All the replicas of a module share theirs: access it under `recordLock`.
+    static std::map<std::string, Records_t> records;
+
+    static std::mutex recordLock; ///< Protects `records`.
+
+  }; // class SeedTestReplicated
+
+  std::map<std::string, SeedTestReplicated::Records_t>
+    SeedTestReplicated::records;
+  std::mutex SeedTestReplicated::recordLock;
+
+
+  SeedTestReplicated::SeedTestReplicated
+    (fhicl::ParameterSet const& pset, art::ProcessingFrame const&)
+    : art::ReplicatedProducer(pset)
+    , instanceNames
+      (pset.get<std::vector<std::string>>("instanceNames", { "" }))
+    , nDraws(pset.get<unsigned int>("draws", 10U))
+    , outputPath(pset.get<std::string>("outputFile"))
+  {
+    art::ServiceHandle<rndm::NuRandomService> Seeds;
+    for (std::string const& instanceName: instanceNames) {
+      engines.push_back(std::make_unique<CLHEP::HepJamesRandom>());
+      Seeds->registerEngine(*(engines.back()), instanceName);
+    }
+  } // SeedTestReplicated::SeedTestReplicated()
+
+
+  void SeedTestReplicated::produce
+    (art::Event& event, art::ProcessingFrame const&)
+  {
+    Records_t eventRecords;
+    for (std::size_t iEngine = 0; iEngine < engines.size(); ++iEngine) {
+      CLHEP::HepRandomEngine& engine = *(engines[iEngine]);
+      std::uint64_t checksum = rndm::details::FNV1aOffset;
+      for (unsigned int i = 0; i < nDraws; ++i) {
+        // flat() has 53 significant bits at most: all of them go in
+        std::uint64_t const bits
+          = static_cast<std::uint64_t>(engine.flat() * 9007199254740992.0);
+        checksum = rndm::details::FNV1aAdd(checksum, bits);
+      }
+      eventRecords.emplace(
+        RecordKey_t
+          { event.run(), event.subRun(), event.event(), instanceNames[iEngine] },
+        Record_t{ static_cast<seed_t>(engine.getSeed()), checksum }
+        );
+    } // for
+
+    std::lock_guard const lock{ recordLock };
+    records[moduleDescription().moduleLabel()].merge(eventRecords);
+  } // SeedTestReplicated::produce()
+
+
+  void SeedTestReplicated::endJob(art::ProcessingFrame const&) {
+    // each replica writes the same records, all of them:
+    // the last one to get here leaves the file complete
+    std::lock_guard const lock{ recordLock };
+    Records_t const& moduleRecords
+      = records[moduleDescription().moduleLabel()];
+
+    std::ofstream out(outputPath);
+    if (!out) {
+      throw art::Exception(art::errors::FileOpenError)
+        << "SeedTestReplicated: can't write '" << outputPath << "'\n";
+    }
+    for (auto const& [ key, record ]: moduleRecords) {
+      auto const& [ run, subRun, event, instanceName ] = key;
+      out << run << " " << subRun << " " << event << " '" << instanceName
+        << "' " << record.first << " " << std::hex << std::setfill('0')
+        << std::setw(16) << record.second << std::dec << std::setfill(' ')
+        << "\n";
+    } // for
+
+    mf::LogInfo("SeedTestReplicated")
+      << moduleRecords.size() << " engine records written into '"
+      << outputPath << "'";
+  } // SeedTestReplicated::endJob()
+
+} // namespace testing
+
+DEFINE_ART_MODULE(testing::SeedTestReplicated)
@@ -0,0 +1,74 @@
+#!/usr/bin/env bash
+#
+# Runs two art jobs writing engine state hashes, and compares the two files
+# with `CompareEngineFingerprints`.
+#
+# Usage:  engine_fingerprints_test.sh [--expect-different] ConfigA OutputA ConfigB OutputB
+#
+# Each job is run with its configuration file, which must write the engine
+# state hashes into its output file (`engineFingerprints` parameter of
+# `NuRandomService`). The output files are kept as `OutputA.first` and
+# `OutputB.second`, so that the two jobs may write the same file.
+# The two files are compared both record by record and by bisection: the
+# comparisons must report them equivalent (exit code 0), or, with
+# `--expect-different`, different (exit code 1).
+# The script exits with a non-zero code if any job fails or if any comparison
+# gives an unexpected result.
+#
+
+declare -r SCRIPTNAME="$(basename "$0")"
+
+declare -i ExpectedCode=0
+if [[ "$1" == '--expect-different' ]]; then
+  ExpectedCode=1
+  shift
+fi
+
+if [[ $# -lt 4 ]]; then
+  echo "Usage:  ${SCRIPTNAME} [--expect-different] ConfigA OutputA ConfigB OutputB" >&2
+  exit 2
+fi
+
+declare -i nErrors=0
+
+# runs the job with the specified configuration and tag; returns non-zero on error
+function RunJob() {
+  local ConfigFile="$1"
+  local OutputFile="$2"
+  local Tag="$3"
+  rm -f "$OutputFile"
+  echo "Running '${ConfigFile}'"
+  art --rethrow-all --config "$ConfigFile" > "${OutputFile}.${Tag}.log" 2>&1
+  local -i res=$?
+  if [[ $res != 0 ]]; then
+    echo "ERROR: the job '${ConfigFile}' failed (code ${res}); see '${OutputFile}.${Tag}.log'." >&2
+    return 1
+  fi
+  if [[ ! -s "$OutputFile" ]]; then
+    echo "ERROR: the job '${ConfigFile}' did not write '${OutputFile}'." >&2
+    return 1
+  fi
+  mv "$OutputFile" "${OutputFile}.${Tag}"
+} # RunJob()
+
+
+RunJob "$1" "$2" 'first' || let ++nErrors
+RunJob "$3" "$4" 'second' || let ++nErrors
+
+if [[ $nErrors == 0 ]]; then
+  for Mode in '' '--bisect' ; do
+    CompareEngineFingerprints "${2}.first" "${4}.second" $Mode
+    declare -i res=$?
+    if [[ $res != $ExpectedCode ]]; then
+      echo "ERROR: the comparison ${Mode:+(${Mode}) }exited with code ${res}, ${ExpectedCode} expected." >&2
+      let ++nErrors
+    fi
+  done
+fi
+
+if [[ $nErrors -gt 0 ]]; then
+  echo "${nErrors} errors." >&2
+  exit 1
+fi
+echo "The comparisons gave the expected result."
+exit 0
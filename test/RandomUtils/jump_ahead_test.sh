@@ -0,0 +1,76 @@
+#!/usr/bin/env bash
+#
+# Runs the same art job on all its events, and then starting from a later
+# event, and verifies that the records of the events processed by both runs
+# are identical.
+#
+# Usage:  jump_ahead_test.sh ConfigFile OutputFile NEvents FirstEvent
+#
+# The first run processes `NEvents` events, the second one the events from
+# number `FirstEvent` on, up to the same last event. The output files are kept
+# as `OutputFile.all` and `OutputFile.from<FirstEvent>`. The end-of-job seed
+# summary of the first run must report no mismatched seed.
+# The script exits with a non-zero code if any job fails, if any record of the
+# second run is not in the first one, or if the summary reports an error.
+#
+
+declare -r SCRIPTNAME="$(basename "$0")"
+
+if [[ $# -lt 4 ]]; then
+  echo "Usage:  ${SCRIPTNAME} ConfigFile OutputFile NEvents FirstEvent" >&2
+  exit 2
+fi
+
+declare -r ConfigFile="$1"
+declare -r OutputFile="$2"
+declare -ri NEvents="$3"
+declare -ri FirstEvent="$4"
+
+declare -i nErrors=0
+
+# runs the job with the specified tag and art options; returns non-zero on error
+function RunJob() {
+  local Tag="$1"
+  shift
+  rm -f "$OutputFile"
+  echo "Running '${ConfigFile}' ${*}"
+  art --rethrow-all --config "$ConfigFile" "$@" > "${OutputFile}.${Tag}.log" 2>&1
+  local -i res=$?
+  if [[ $res != 0 ]]; then
+    echo "ERROR: the job '${Tag}' failed (code ${res}); see '${OutputFile}.${Tag}.log'." >&2
+    return 1
+  fi
+  if [[ ! -s "$OutputFile" ]]; then
+    echo "ERROR: the job '${Tag}' did not write '${OutputFile}'." >&2
+    return 1
+  fi
+  mv "$OutputFile" "${OutputFile}.${Tag}"
+} # RunJob()
+
+
+RunJob 'all' --nevts "$NEvents" || let ++nErrors
+RunJob "from${FirstEvent}" --estart "$FirstEvent" \
+  --nevts "$(( NEvents - FirstEvent + 1 ))" || let ++nErrors
+
+if [[ $nErrors == 0 ]]; then
+  declare Missing
+  Missing="$(comm -13 <(sort "${OutputFile}.all") <(sort "${OutputFile}.from${FirstEvent}"))"
+  if [[ -n "$Missing" ]]; then
+    echo "ERROR: records starting from event ${FirstEvent} differ from the ones of the full run:" >&2
+    head -n 20 <<< "$Missing" >&2
+    let ++nErrors
+  fi
+
+  if grep -q -F '[[ERROR!!!]]' "${OutputFile}.all.log" ; then
+    echo "ERROR: the seed summary reports mismatched seeds:" >&2
+    grep -F '[[ERROR!!!]]' "${OutputFile}.all.log" | head -n 20 >&2
+    let ++nErrors
+  fi
+fi
+
+if [[ $nErrors -gt 0 ]]; then
+  echo "${nErrors} errors." >&2
+  exit 1
+fi
+echo "Records from event ${FirstEvent} match the full run."
+exit 0
@@ -0,0 +1,84 @@
+#!/usr/bin/env bash
+#
+# Runs the same art job with different numbers of threads and schedules, and
+# verifies that the output files of all the runs are identical.
+#
+# Usage:  thread_invariance_test.sh [--select Pattern] ConfigFile OutputFile NThreads [NThreads ...]
+#
+# Each run uses as many schedules as threads. The output file of each run is
+# kept as `OutputFile.<N>threads`, and compared with the one of the first run.
+# With `--select`, only the lines matching the (`grep`) pattern are compared,
+# ignoring their trailing commas, which in JSON lists depend on the lines which
+# follow (e.g. `'"schedule": 0,'` selects the engines on the first schedule
+# from a seed manifest).
+# The script exits with a non-zero code if any job fails or if any output
+# differs.
+#
+
+declare -r SCRIPTNAME="$(basename "$0")"
+
+declare Select=''
+if [[ "$1" == '--select' ]]; then
+  Select="$2"
+  shift 2
+fi
+
+if [[ $# -lt 3 ]]; then
+  echo "Usage:  ${SCRIPTNAME} [--select Pattern] ConfigFile OutputFile NThreads [NThreads ...]" >&2
+  exit 2
+fi
+
+declare -r ConfigFile="$1"
+declare -r OutputFile="$2"
+shift 2
+
+declare Reference=''
+declare -i nErrors=0
+for nThreads in "$@" ; do
+
+  rm -f "$OutputFile"
+  echo "Running '${ConfigFile}' with ${nThreads} threads and schedules"
+  art --rethrow-all --config "$ConfigFile" \
+    --nthreads "$nThreads" --nschedules "$nThreads" \
+    > "${OutputFile}.${nThreads}threads.log" 2>&1
+  declare -i res=$?
+  if [[ $res != 0 ]]; then
+    echo "ERROR: the job with ${nThreads} threads failed (code ${res}); see '${OutputFile}.${nThreads}threads.log'." >&2
+    let ++nErrors
+    continue
+  fi
+  if [[ ! -r "$OutputFile" ]]; then
+    echo "ERROR: the job with ${nThreads} threads did not write '${OutputFile}'." >&2
+    let ++nErrors
+    continue
+  fi
+
+  declare Output="${OutputFile}.${nThreads}threads"
+  if [[ -n "$Select" ]]; then
+    grep -e "$Select" "$OutputFile" | sed -e 's/,[[:space:]]*$//' > "$Output"
+    rm -f "$OutputFile"
+    if [[ ! -s "$Output" ]]; then
+      echo "ERROR: no line of the output with ${nThreads} threads matches '${Select}'." >&2
+      let ++nErrors
+      continue
+    fi
+  else
+    mv "$OutputFile" "$Output"
+  fi
+
+  if [[ -z "$Reference" ]]; then
+    Reference="$Output"
+  elif ! cmp -s "$Reference" "$Output" ; then
+    echo "ERROR: output with ${nThreads} threads differs from '${Reference}':" >&2
+    diff "$Reference" "$Output" | head -n 20 >&2
+    let ++nErrors
+  fi
+
+done
+
+if [[ $nErrors -gt 0 ]]; then
+  echo "${nErrors} errors." >&2
+  exit 1
+fi
+echo "All the outputs are identical."
+exit 0